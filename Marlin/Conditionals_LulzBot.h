@@ -2254,9 +2254,11 @@
 #endif
 
 #if defined(LULZBOT_SDSUPPORT_DEBUG)
+    #define LULZBOT_SDCARD_CHECK_INIT \
+        static bool spi_error = false;
+
     #define LULZBOT_SDCARD_CHECK_BYTE(n) \
-        static bool spi_error = false; \
-        if(n != -1 && !isprint(n) && n != '\n' && n != '\r') spi_error = true;
+        if(!isprint(n) && n != '\n' && n != '\r') spi_error = true;
 
     #define LULZBOT_SDCARD_COMMAND_DONE(cmd) \
         if(spi_error) { \
@@ -2264,6 +2266,7 @@
             spi_error = false; \
         }
 #else
+    #define LULZBOT_SDCARD_CHECK_INIT
     #define LULZBOT_SDCARD_CHECK_BYTE(n)
     #define LULZBOT_SDCARD_COMMAND_DONE(cmd)
 #endif
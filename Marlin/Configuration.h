@@ -368,6 +368,9 @@
  *   147 : Pt100 with 4k7 pullup
  *   110 : Pt100 with 1k pullup (non standard)
  *
+ *         Each thermistor table in use is expanded at build time into a lookup
+ *         table for faster conversion, which costs 2K of flash per table.
+ *
  *         Use these for Testing or Development purposes. NEVER for production machine.
  *   998 : Dummy Table that ALWAYS reads 25°C or the temperature defined below.
  *   999 : Dummy Table that ALWAYS reads 100°C or the temperature defined below.
@@ -1372,6 +1375,17 @@
 //#define DISABLE_M503    // Saves ~2700 bytes of PROGMEM. Disable for release!
 #define EEPROM_CHITCHAT   // Give feedback on EEPROM commands. Disable to save PROGMEM.
 
+/**
+ * Wear-leveled settings in flash (Due and Linux only)
+ *
+ * Instead of erasing and rewriting flash pages on every save, keep the
+ * emulated EEPROM as a log in two flash sectors. A save appends only the
+ * blocks that changed. The full sector is compacted into the other one
+ * only when it runs out of space. This makes M500 and PRINTCOUNTER saves
+ * quick on boards with flash-emulated EEPROM, such as the Archim.
+ */
+//#define FLASH_EEPROM_LOG
+
 //
 // Host Keepalive
 //
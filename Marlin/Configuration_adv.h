@@ -124,6 +124,97 @@
   #endif
 #endif
 
+/**
+ * Extrusion Feedforward
+ *
+ * Add heater power for the cooling caused by extrusion and by the part-
+ * cooling fan before the hotend cools, instead of waiting for the PID or
+ * bang-bang loop to react. The extra power, in PWM units (0-PID_MAX or
+ * 0-BANG_MAX) is:
+ *
+ *   FLOW * volumetric rate of the move being printed (mm³/s)
+ *   + FAN * part-cooling fan speed / 255
+ *
+ * Set for each hotend with M309 E<hotend> V<flow> F<fan>. Saved with M500.
+ * Negative values are raised to 0, so feedforward never takes power away.
+ */
+//#define EXTRUSION_FEEDFORWARD
+#if ENABLED(EXTRUSION_FEEDFORWARD)
+  #define DEFAULT_FEEDFORWARD_FLOW 0.0  // PWM per mm³/s
+  #define DEFAULT_FEEDFORWARD_FAN  0.0  // PWM at full fan speed
+#endif
+
+/**
+ * Step Response PID Autotune
+ *
+ * Add 'M303 F' to tune from a single heat-up instead of several relay
+ * cycles. The heater is driven at full power from room temperature to the
+ * target, a first-order-plus-dead-time model is fitted to the rise, and the
+ * PID values are computed from the model. Start with the heater cold.
+ *
+ * With EXTRUSION_FEEDFORWARD the M309 flow coefficient is also computed,
+ * from the hotend heater power and the heat capacity of the filament. The
+ * filament is heated from room temperature, read from the chamber sensor
+ * or else the coolest sensor.
+ */
+//#define PID_AUTOTUNE_FOPDT
+#if ENABLED(PID_AUTOTUNE_FOPDT)
+  #define FOPDT_HEATER_POWER  40      // (W) Hotend heater power at full PWM
+  #define FOPDT_FILAMENT_HEAT 0.0022  // (J/mm³/K) Volumetric heat capacity of the filament
+#endif
+
+/**
+ * Heater Power Budget
+ *
+ * Keep the heaters from drawing more than a set power at any instant, for
+ * a power supply smaller than all the heaters together. The hotends have
+ * priority and are switched on at the start of each PWM cycle. The bed is
+ * switched on at the end of the cycle and overlaps the hotends only as far
+ * as the budget allows. The hotends heat at full power first, then the bed
+ * gets all of the power they leave.
+ */
+//#define HEATER_POWER_BUDGET
+#if ENABLED(HEATER_POWER_BUDGET)
+  #define HEATER_BUDGET_WATTS 240     // (W) Power available to the heaters
+  #define HOTEND_HEATER_WATTS { 40 }  // (W) Full power of each hotend heater
+  #define BED_HEATER_WATTS    200     // (W) Full power of the bed heater
+#endif
+
+/**
+ * Hardware PWM Heaters
+ *
+ * Drive these heaters with timer PWM through analogWrite instead of the
+ * software PWM in the temperature ISR. Each pin needs hardware PWM on a
+ * timer that nothing else uses, and the heater's MOSFET has to cope with
+ * that timer's frequency, which is often too high for a heated bed.
+ */
+//#define HEATER_0_HARDWARE_PWM
+//#define HEATER_1_HARDWARE_PWM
+//#define HEATER_2_HARDWARE_PWM
+//#define HEATER_3_HARDWARE_PWM
+//#define HEATER_4_HARDWARE_PWM
+//#define HEATER_5_HARDWARE_PWM
+//#define HEATER_BED_HARDWARE_PWM
+
+/**
+ * Spread out the software PWM edges, so the heaters and soft PWM fans
+ * don't all switch on at the same instant. Each one starts its on-time
+ * at its own point in the PWM cycle, lowering the peak current and the
+ * interference it causes. With HEATER_POWER_BUDGET only the fans move.
+ */
+//#define SOFT_PWM_PHASE_SPREAD
+
+/**
+ * Temperature Barriers
+ *
+ * Add a 'D' parameter to M109 and M190 to set the target and defer the
+ * wait. Homing, probing and other moves run while the heaters come up to
+ * temperature. The first move that extrudes or retracts, from G-code,
+ * filament change, firmware retraction or the LCD, waits for them instead.
+ * M108 or turning the heaters off abandons the wait.
+ */
+//#define TEMPERATURE_BARRIERS
+
 /**
  * Automatic Temperature:
  * The hotend target temperature is calculated by all the buffered lines of gcode.
@@ -195,6 +286,19 @@
 #define TEMP_SENSOR_AD8495_OFFSET 0.0
 #define TEMP_SENSOR_AD8495_GAIN   1.0
 
+/**
+ * Continuous ADC scanning
+ *
+ * Instead of starting one conversion per temperature interrupt, let the
+ * ADC scan all sensor pins continuously, with DMA filling a buffer of the
+ * last 16 readings of each. The buffers are only summed when a reading is
+ * due, which frees the temperature interrupt and adds no conversion delay.
+ *
+ * Supported on DUE, LPC1768, STM32F4/F7 (STM32 HAL) and LINUX (simulated).
+ * On STM32 only ADC1 pins are scanned. Others are read one at a time as before.
+ */
+//#define CONTINUOUS_ADC
+
 /**
  * Controller Fan
  * To cool down the stepper drivers and MOSFETs.
@@ -214,6 +318,14 @@
 // before setting a PWM value. (Does not work with software PWM for fan on Sanguinololu)
 #define FAN_KICKSTART_TIME LULZBOT_FAN_KICKSTART_TIME
 
+/**
+ * Raise the fan speeds this many milliseconds before the moves that call
+ * for them, so part-cooling fans are up to speed for bridges and overhangs.
+ * Fan speeds still drop when the slower moves start. Queued moves are
+ * looked at every 100ms, so keep this well above that.
+ */
+//#define FAN_LEAD_TIME 500 // (ms)
+
 /**
  * PWM Fan Scaling
  *
@@ -745,6 +857,21 @@
   #if ENABLED(POWER_LOSS_RECOVERY)
     //#define POWER_LOSS_PIN   44     // Pin to detect power loss
     //#define POWER_LOSS_STATE HIGH   // State of pin indicating power loss
+
+    /**
+     * Journal the recovery state instead of rewriting it. Saves still come
+     * at each layer change, or as set by SAVE_INFO_INTERVAL_MS and
+     * SAVE_EACH_CMD_MODE. A full checkpoint is written when the heater, fan
+     * or leveling state has changed. Otherwise a save appends a small record
+     * (the file position, the position and the feedrate) into space reserved
+     * behind the checkpoint, costing a single block write. A new checkpoint
+     * is written when the journal fills. Recovery replays the checkpoint up
+     * to the last intact record.
+     */
+    //#define POWER_LOSS_JOURNAL
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      #define POWER_LOSS_JOURNAL_SIZE 64  // Records between checkpoints (32 bytes each)
+    #endif
   #endif
 
   /**
@@ -785,6 +912,18 @@
                                       // Note: Only affects SCROLL_LONG_FILENAMES with SDSORT_CACHE_NAMES but not SDSORT_DYNAMIC_RAM.
   #endif
 
+  /**
+   * Keep an index of the items listed in the current folder, so the SD
+   * menus, file lists and sorting go straight to an item instead of reading
+   * the folder from the top for each one. The index is rebuilt by the next
+   * count after the folder changes. Costs 5 bytes per item on AVR and 6 on
+   * 32-bit boards.
+   */
+  //#define SDCARD_DIR_INDEX
+  #if ENABLED(SDCARD_DIR_INDEX)
+    #define SDCARD_DIR_INDEX_SIZE 64  // Items to index. Later items are found from the last one.
+  #endif
+
   // This allows hosts to request long names for files and folders with M33
   //#define LONG_FILENAME_HOST_SUPPORT
 
@@ -805,6 +944,37 @@
    */
   //#define SD_REPRINT_LAST_SELECTED_FILE
 
+  /**
+   * Read the file being printed with multiple block reads (CMD18), keeping
+   * the transfer open over contiguous blocks. The next block is read ahead
+   * into a second buffer while the current one is parsed. Costs 1K of SRAM.
+   * USB flash drives read ahead with USB_BULK_BLOCKS instead. Not available
+   * with SDIO.
+   */
+  //#define SD_STREAMING_READS
+
+  /**
+   * Write files uploaded with M28 (or a binary transfer) with multiple
+   * block writes (CMD25), keeping the transfer open over contiguous blocks.
+   * A binary transfer announces the file size, so the card is told how many
+   * blocks to pre-erase (ACMD23) and the clusters are allocated up front.
+   * Costs 512 bytes of SRAM. USB flash drives gather the blocks into bulk
+   * transfers of USB_BULK_BLOCKS. Not available with SDIO.
+   */
+  //#define SD_STREAMING_WRITES
+
+  /**
+   * Remember the runs of contiguous clusters in the file being printed,
+   * so seeks (M26, power-loss recovery) and cluster changes can find the
+   * cluster without reading the FAT once the chain has been followed.
+   * Each run costs 8 bytes of SRAM. A file in more pieces than that falls
+   * back to following the FAT beyond the last run that fits.
+   */
+  //#define SD_EXTENT_MAP
+  #if ENABLED(SD_EXTENT_MAP)
+    #define SD_EXTENT_MAP_SIZE 8    // Runs of contiguous clusters to remember
+  #endif
+
   /**
    * Auto-report SdCard status with M27 S<seconds>
    */
@@ -821,11 +991,21 @@
    *    SCLK, MOSI, MISO --> SCLK, MOSI, MISO
    *    INT              --> SD_DETECT_PIN
    *    SS               --> SDSS
+   *
+   * Sequential reads fetch USB_BULK_BLOCKS blocks in a single bulk transfer
+   * and serve the following reads from that buffer. Streamed writes (see
+   * SD_STREAMING_WRITES) are gathered and sent the same way. The buffer
+   * costs 512 bytes of SRAM per block, so raise it only on boards with SRAM
+   * to spare. Set to 1 to transfer single blocks.
+   *
+   * The Linux simulator has no USB host. Its drive is the FAT disk image
+   * "usbdrive.img" in the working directory.
    */
   #define USB_FLASH_DRIVE_SUPPORT LULZBOT_USB_FLASH_DRIVE_SUPPORT
   #if ENABLED(USB_FLASH_DRIVE_SUPPORT)
     #define USB_CS_PIN         SDSS
     #define USB_INTR_PIN       SD_DETECT_PIN
+    #define USB_BULK_BLOCKS    2
   #endif
 
   /**
@@ -1143,12 +1323,33 @@
   //#define SERIAL_STATS_DROPPED_RX
 #endif
 
+// Queue serial output as compact records (strings, PROGMEM pointers and raw
+// numbers) that are formatted only as the TX buffer frees up, so that long
+// reports (M503, M420 V, G29 mesh dumps, M122) don't stall the main loop.
+// Output still blocks when the record buffer itself is full, until the port
+// has sent enough to make room: about 1ms per 11 bytes at 115200 baud. Text
+// takes a byte per character and numbers 6-10 bytes, so a report longer than
+// the buffer stalls the main loop for the rest. Size the buffer for the
+// longest report sent while printing (around 2K covers M503).
+// Requires TX_BUFFER_SIZE > 0. Supported on AVR (not USBCON), DUE and LINUX.
+//#define DEFERRED_SERIAL_OUTPUT
+#if ENABLED(DEFERRED_SERIAL_OUTPUT)
+  #define DEFERRED_SERIAL_BUFFER_SIZE 256 // (bytes) Power of 2, 16 to 4096
+#endif
+
 // Enable an emergency-command parser to intercept certain commands as they
 // enter the serial receive buffer, so they cannot be blocked.
 // Currently handles M108, M112, M410
 // Does not work on boards using AT90USB (USBCON) processors!
 #define EMERGENCY_PARSER LULZBOT_EMERGENCY_PARSER
 
+// Enable a priority lane for non-motion, non-blocking commands so they are
+// run as soon as they are received instead of waiting behind a full queue.
+// Handles the commands flagged CMD_PRIORITY in the G-code dispatch table:
+// M27, M31, M105, M115, M155, M156, M220, M221, M290
+// Other commands received while the queue is full are held until it has room.
+//#define PRIORITY_COMMANDS
+
 // Bad Serial-connections can miss a received command by sending an 'ok'
 // Therefore some clients abort after 30 seconds in a timeout.
 // Some other clients start sending commands while receiving a 'wait'.
@@ -1937,6 +2138,42 @@
  * Auto-report temperatures with M155 S<seconds>
  */
 #define AUTO_REPORT_TEMPERATURES
+#if ENABLED(AUTO_REPORT_TEMPERATURES)
+  /**
+   * Send auto-reports only as new readings come in, and only when a
+   * temperature moved more than a threshold or a target changed. The
+   * M155 interval becomes the longest time between reports.
+   * M155 D<degrees> sets the threshold, M155 C1 selects a compact format.
+   */
+  //#define AUTO_REPORT_TEMPERATURE_CHANGES
+  #if ENABLED(AUTO_REPORT_TEMPERATURE_CHANGES)
+    #define AUTO_REPORT_TEMPERATURE_DELTA 0.5 // (°C) Default change threshold
+  #endif
+#endif
+
+/**
+ * Send compact binary frames of temperatures, heater power, fan speeds,
+ * position, planner state and print progress for host dashboards.
+ * Frames are sent on the serial port between text lines. The format is
+ * described in feature/telemetry.h.
+ * M156 T<ms> P<ms> S<ms> sets the thermal, position and status intervals.
+ */
+//#define BINARY_TELEMETRY
+#if ENABLED(BINARY_TELEMETRY)
+  #define TELEMETRY_MIN_INTERVAL 50 // (ms) Shortest report interval per channel
+#endif
+
+/**
+ * Keep a history of recent heater temperatures, targets and power in a
+ * ring buffer, to look into slow recovery or oscillation after the fact.
+ * Samples are delta-encoded, taking 3-5 bytes for a steady hotend and bed.
+ * M157 reports the history, M157 S<ms> sets the interval, M157 C clears.
+ */
+//#define THERMAL_HISTORY
+#if ENABLED(THERMAL_HISTORY)
+  #define THERMAL_HISTORY_SIZE      512 // (bytes) Buffer size, 256 or more
+  #define THERMAL_HISTORY_INTERVAL 1000 // (ms) Default sample interval, 200 or more
+#endif
 
 /**
  * Include capabilities in M115 output
@@ -91,6 +91,7 @@ typedef int8_t pin_t;
   #endif
 
   #define MYSERIAL0 customizedSerial1
+  #define HAS_SERIAL_RX_RING 1 // Command lines can be read from the RX ring in place
 
   #ifdef SERIAL_PORT_2
     #if !WITHIN(SERIAL_PORT_2, -1, 3)
@@ -386,29 +386,52 @@
     // if it interrupts the writing of the value of that variable in the middle.
     atomic_set_rx_tail(t);
 
-    if (Cfg::XONOFF) {
-      // If the XOFF char was sent, or about to be sent...
-      if ((xon_xoff_state & XON_XOFF_CHAR_MASK) == XOFF_CHAR) {
-        // Get count of bytes in the RX buffer
-        const ring_buffer_pos_t rx_count = (ring_buffer_pos_t)(h - t) & (ring_buffer_pos_t)(Cfg::RX_SIZE - 1);
-        if (rx_count < (Cfg::RX_SIZE) / 10) {
-          if (Cfg::TX_SIZE > 0) {
-            // Signal we want an XON character to be sent.
-            xon_xoff_state = XON_CHAR;
-            // Enable TX ISR. Non atomic, but it will eventually enable them
-            B_UDRIE = 1;
-          }
-          else {
-            // If not using TX interrupts, we must send the XON char now
-            xon_xoff_state = XON_CHAR | XON_XOFF_CHAR_SENT;
-            while (!B_UDRE) sw_barrier();
-            R_UDR = XON_CHAR;
-          }
+    if (Cfg::XONOFF) check_xon(h, t);
+
+    return v;
+  }
+
+  // Get the count of unread bytes that are contiguous in the RX ring,
+  // starting 'offset' bytes past the tail, without consuming them.
+  template<typename Cfg>
+  typename MarlinSerial<Cfg>::ring_buffer_pos_t MarlinSerial<Cfg>::rx_run(const ring_buffer_pos_t offset, const uint8_t* &ptr) {
+    const ring_buffer_pos_t h = atomic_read_rx_head(),
+                            s = (ring_buffer_pos_t)(rx_buffer.tail + offset) & (ring_buffer_pos_t)(Cfg::RX_SIZE - 1);
+    ptr = rx_buffer.buffer + s;
+    return h >= s ? h - s : Cfg::RX_SIZE - s; // Stop at the head or at the end of the ring
+  }
+
+  // Consume bytes from the RX ring that were processed in place
+  template<typename Cfg>
+  void MarlinSerial<Cfg>::rx_discard(const ring_buffer_pos_t count) {
+    const ring_buffer_pos_t h = atomic_read_rx_head(),
+                            t = (ring_buffer_pos_t)(rx_buffer.tail + count) & (ring_buffer_pos_t)(Cfg::RX_SIZE - 1);
+    atomic_set_rx_tail(t);
+    if (Cfg::XONOFF) check_xon(h, t);
+  }
+
+  // After reading, signal the host to resume if the RX buffer has drained
+  template<typename Cfg>
+  FORCE_INLINE void MarlinSerial<Cfg>::check_xon(const ring_buffer_pos_t h, const ring_buffer_pos_t t) {
+    // If the XOFF char was sent, or about to be sent...
+    if ((xon_xoff_state & XON_XOFF_CHAR_MASK) == XOFF_CHAR) {
+      // Get count of bytes in the RX buffer
+      const ring_buffer_pos_t rx_count = (ring_buffer_pos_t)(h - t) & (ring_buffer_pos_t)(Cfg::RX_SIZE - 1);
+      if (rx_count < (Cfg::RX_SIZE) / 10) {
+        if (Cfg::TX_SIZE > 0) {
+          // Signal we want an XON character to be sent.
+          xon_xoff_state = XON_CHAR;
+          // Enable TX ISR. Non atomic, but it will eventually enable them
+          B_UDRIE = 1;
+        }
+        else {
+          // If not using TX interrupts, we must send the XON char now
+          xon_xoff_state = XON_CHAR | XON_XOFF_CHAR_SENT;
+          while (!B_UDRE) sw_barrier();
+          R_UDR = XON_CHAR;
         }
       }
     }
-
-    return v;
   }
 
   template<typename Cfg>
@@ -202,6 +202,8 @@
     static FORCE_INLINE void atomic_set_rx_tail(ring_buffer_pos_t value);
     static FORCE_INLINE ring_buffer_pos_t atomic_read_rx_tail();
 
+    static FORCE_INLINE void check_xon(const ring_buffer_pos_t h, const ring_buffer_pos_t t);
+
     public:
 
     FORCE_INLINE static void store_rxd_char();
@@ -217,6 +219,12 @@
       static ring_buffer_pos_t available(void);
       static void write(const uint8_t c);
       static void flushTX(void);
+      FORCE_INLINE static uint8_t availableForWrite() { return Cfg::TX_SIZE ? (tx_buffer.tail - tx_buffer.head - 1) & (Cfg::TX_SIZE - 1) : 0; }
+
+      // Direct access to the RX ring, used to assemble command lines in place
+      static ring_buffer_pos_t rx_run(const ring_buffer_pos_t offset, const uint8_t* &ptr);
+      static void rx_discard(const ring_buffer_pos_t count);
+      FORCE_INLINE static bool rx_full() { return available() >= Cfg::RX_SIZE - 1; }
 
       FORCE_INLINE static uint8_t dropped() { return Cfg::DROPPED_RX ? rx_dropped_bytes : 0; }
       FORCE_INLINE static uint8_t buffer_overruns() { return Cfg::RX_OVERRUNS ? rx_buffer_overruns : 0; }
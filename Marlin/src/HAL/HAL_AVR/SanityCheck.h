@@ -96,6 +96,23 @@
   #endif
 #endif // SPINDLE_LASER_ENABLE
 
+/**
+ * Heaters on hardware PWM need a PWM pin with a free Counter/Timer
+ */
+#define _HW_PWM_HEATER_PIN(N) (ENABLED(HEATER_##N##_HARDWARE_PWM) && !(WITHIN(HEATER_##N##_PIN, 2, 13) || WITHIN(HEATER_##N##_PIN, 44, 46)))
+#define _HW_PWM_HEATER_ISR(N) (ENABLED(HEATER_##N##_HARDWARE_PWM) && (HEATER_##N##_PIN == 4 || WITHIN(HEATER_##N##_PIN, 11, 13)))
+#define _HW_PWM_HEATER_SERVO(N) (ENABLED(HEATER_##N##_HARDWARE_PWM) && NUM_SERVOS > 0 && (WITHIN(HEATER_##N##_PIN, 2, 3) || HEATER_##N##_PIN == 5))
+#if _HW_PWM_HEATER_PIN(0) || _HW_PWM_HEATER_PIN(1) || _HW_PWM_HEATER_PIN(2) || _HW_PWM_HEATER_PIN(3) || _HW_PWM_HEATER_PIN(4) || _HW_PWM_HEATER_PIN(5) || _HW_PWM_HEATER_PIN(BED)
+  #error "HEATER_*_HARDWARE_PWM requires the heater to be on a PWM pin."
+#elif _HW_PWM_HEATER_ISR(0) || _HW_PWM_HEATER_ISR(1) || _HW_PWM_HEATER_ISR(2) || _HW_PWM_HEATER_ISR(3) || _HW_PWM_HEATER_ISR(4) || _HW_PWM_HEATER_ISR(5) || _HW_PWM_HEATER_ISR(BED)
+  #error "Counter/Timer for a HEATER_*_HARDWARE_PWM pin is used by a system interrupt."
+#elif _HW_PWM_HEATER_SERVO(0) || _HW_PWM_HEATER_SERVO(1) || _HW_PWM_HEATER_SERVO(2) || _HW_PWM_HEATER_SERVO(3) || _HW_PWM_HEATER_SERVO(4) || _HW_PWM_HEATER_SERVO(5) || _HW_PWM_HEATER_SERVO(BED)
+  #error "Counter/Timer for a HEATER_*_HARDWARE_PWM pin is used by the servo system."
+#endif
+#undef _HW_PWM_HEATER_PIN
+#undef _HW_PWM_HEATER_ISR
+#undef _HW_PWM_HEATER_SERVO
+
 /**
  * The Trinamic library includes SoftwareSerial.h, leading to a compile error.
  */
@@ -109,9 +109,11 @@ static const FLASH_SECTOR_T* getFlashStorage(int page) {
   return (const FLASH_SECTOR_T*)&flashStorage[page*PageSize];
 }
 
+#if DISABLED(FLASH_EEPROM_LOG)
 static uint8_t buffer[256] = {0},   // The RAM buffer to accumulate writes
                curPage = 0,         // Current FLASH page inside the group
                curGroup = 0xFF;     // Current FLASH group
+#endif
 
 //#define EE_EMU_DEBUG
 #ifdef EE_EMU_DEBUG
@@ -407,6 +409,57 @@ static bool ee_PageErase(uint16_t page) {
 
   return true;
 }
+
+#if ENABLED(FLASH_EEPROM_LOG)
+
+#include "../shared/persistent_store_log.h"
+
+/**
+ * Flash device for the log-structured settings store.
+ * Each group of pages is one sector. Records are programmed in
+ * 128-bit units, the smallest size partial programming allows.
+ */
+const uint32_t FlashLogDevice::sector_size = PagesPerGroup * PageSize;
+const uint8_t FlashLogDevice::program_size = 16;
+
+const uint8_t* FlashLogDevice::sector(const uint8_t s) {
+  return (const uint8_t*)getFlashStorage(s * PagesPerGroup);
+}
+
+bool FlashLogDevice::erase(const uint8_t s) {
+  for (uint16_t page = s * PagesPerGroup; page < (s + 1) * PagesPerGroup; page++) {
+    // Only erase the pages that hold data
+    const uint32_t *pflash = (const uint32_t*)getFlashStorage(page);
+    uint16_t i = 0;
+    while (i < (PageSize >> 2) && pflash[i] == 0xFFFFFFFF) i++;
+    if (i < (PageSize >> 2) && !ee_PageErase(page)) return true;
+  }
+  return false;
+}
+
+bool FlashLogDevice::program(const uint8_t s, const uint32_t offset, const void *data, const uint16_t size) {
+  const uint8_t *src = (const uint8_t*)data;
+  uint32_t addr = s * sector_size + offset;
+  uint16_t remain = size;
+  while (remain) {
+    const uint16_t page = addr / PageSize, start = addr % PageSize,
+                   count = MIN(remain, uint16_t(PageSize - start));
+
+    // ee_PageWrite only programs the bits that differ from the flash contents
+    uint32_t pageContents[PageSize >> 2];
+    memcpy(pageContents, getFlashStorage(page), PageSize);
+    memcpy((uint8_t*)pageContents + start, src, count);
+    if (!ee_PageWrite(page, pageContents)) return true;
+
+    addr += count;
+    src += count;
+    remain -= count;
+  }
+  return false;
+}
+
+#else // !FLASH_EEPROM_LOG
+
 static uint8_t ee_Read(uint32_t address, bool excludeRAMBuffer = false) {
 
   uint32_t baddr;
@@ -997,5 +1050,7 @@ void eeprom_flush(void) {
   ee_Flush();
 }
 
+#endif // !FLASH_EEPROM_LOG
+
 #endif // ENABLED(EEPROM_SETTINGS) && DISABLED(I2C_EEPROM) && DISABLED(SPI_EEPROM)
 #endif // ARDUINO_ARCH_AVR
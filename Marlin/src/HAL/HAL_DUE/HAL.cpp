@@ -135,4 +135,79 @@ uint16_t HAL_adc_get_result(void) {
   return HAL_adc_result;
 }
 
+#if ENABLED(CONTINUOUS_ADC)
+
+  /**
+   * The ADC runs free over the enabled channels while the PDC copies each
+   * result into a ring of HAL_ADC_SCAN_SAMPLES scans. Each time the ring
+   * wraps the ADC interrupt re-arms the PDC "next" buffer, so transfers
+   * never stop. Results carry their channel number (TAG), which matches
+   * them to pins regardless of the hardware conversion order.
+   */
+
+  #define ADC_SCAN_MAX_PINS 16
+
+  static uint8_t adc_scan_channel[ADC_SCAN_MAX_PINS];
+  static uint16_t adc_scan_buffer[HAL_ADC_SCAN_SAMPLES * ADC_SCAN_MAX_PINS],
+                  adc_scan_size;
+
+  void HAL_adc_scan_start(const pin_t pins[], const uint8_t count) {
+    const uint8_t n = MIN(count, ADC_SCAN_MAX_PINS);
+    uint32_t channels = 0;
+    for (uint8_t i = 0; i < n; i++) {
+      const uint32_t p = uint32_t(pins[i]) < A0 ? pins[i] + A0 : pins[i];
+      adc_scan_channel[i] = g_APinDescription[p].ulADCChannelNumber;
+      SBI(channels, adc_scan_channel[i]);
+    }
+
+    // Every scan stores one result per enabled channel
+    adc_scan_size = HAL_ADC_SCAN_SAMPLES * __builtin_popcount(channels);
+    memset(adc_scan_buffer, 0xFF, sizeof(adc_scan_buffer)); // Tagged as channel 15 until written
+
+    NVIC_DisableIRQ(ADC_IRQn);
+    ADC->ADC_PTCR = ADC_PTCR_RXTDIS;
+    ADC->ADC_CHDR = 0xFFFF;
+    ADC->ADC_CHER = channels;
+    ADC->ADC_EMR |= ADC_EMR_TAG;
+
+    // Slowest ADC clock (MCK / 512). Temperatures change slowly,
+    // and this keeps the ADC interrupt to about a hundred per second.
+    ADC->ADC_MR = (ADC->ADC_MR & ~ADC_MR_PRESCAL_Msk) | ADC_MR_PRESCAL(255) | ADC_MR_FREERUN_ON;
+
+    ADC->ADC_RPR = ADC->ADC_RNPR = (uint32_t)adc_scan_buffer;
+    ADC->ADC_RCR = ADC->ADC_RNCR = adc_scan_size;
+    ADC->ADC_PTCR = ADC_PTCR_RXTEN;
+
+    ADC->ADC_IDR = 0xFFFFFFFF;
+    ADC->ADC_IER = ADC_IER_ENDRX | ADC_IER_RXBUFF;
+    NVIC_SetPriority(ADC_IRQn, NVIC_EncodePriority(0, 12, 0)); // Low priority, only needed once per lap
+    NVIC_EnableIRQ(ADC_IRQn);
+
+    ADC->ADC_CR = ADC_CR_START;
+  }
+
+  void ADC_Handler() {
+    (void)ADC->ADC_ISR;
+    if (!ADC->ADC_RCR) {                // Both buffers used up: restart
+      ADC->ADC_RPR = (uint32_t)adc_scan_buffer;
+      ADC->ADC_RCR = adc_scan_size;
+    }
+    if (!ADC->ADC_RNCR) {               // Queue the next lap of the ring
+      ADC->ADC_RNPR = (uint32_t)adc_scan_buffer;
+      ADC->ADC_RNCR = adc_scan_size;
+    }
+  }
+
+  uint32_t HAL_adc_scan_sum(const uint8_t index) {
+    const uint16_t tag = uint16_t(adc_scan_channel[index]) << 12;
+    uint32_t sum = 0;
+    for (uint16_t i = 0; i < adc_scan_size; i++) {
+      const uint16_t v = adc_scan_buffer[i];
+      if ((v & 0xF000) == tag) sum += (v & 0x0FFF) >> 2; // 12 to 10 bits, as Marlin expects
+    }
+    return sum;
+  }
+
+#endif // CONTINUOUS_ADC
+
 #endif // ARDUINO_ARCH_SAM
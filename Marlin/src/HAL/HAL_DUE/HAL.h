@@ -152,6 +152,12 @@ uint16_t HAL_getAdcFreerun(uint8_t chan, bool wait_for_conversion = false);
 void HAL_enable_AdcFreerun(void);
 //void HAL_disable_AdcFreerun(uint8_t chan);
 
+// Continuous ADC scanning (CONTINUOUS_ADC)
+#define HAL_ADC_SCAN_SAMPLES 16   // Scans kept for each pin, summed by HAL_adc_scan_sum()
+
+void HAL_adc_scan_start(const pin_t pins[], const uint8_t count);
+uint32_t HAL_adc_scan_sum(const uint8_t index);
+
 //
 // Pin Map
 //
@@ -121,6 +121,7 @@ public:
   static ring_buffer_pos_t available(void);
   static void write(const uint8_t c);
   static void flushTX(void);
+  FORCE_INLINE static uint8_t availableForWrite() { return Cfg::TX_SIZE ? (tx_buffer.tail - tx_buffer.head - 1) & (Cfg::TX_SIZE - 1) : 0; }
 
   FORCE_INLINE static uint8_t dropped() { return Cfg::DROPPED_RX ? rx_dropped_bytes : 0; }
   FORCE_INLINE static uint8_t buffer_overruns() { return Cfg::RX_OVERRUNS ? rx_buffer_overruns : 0; }
@@ -24,7 +24,7 @@
 
 #include "../../inc/MarlinConfigPre.h"
 
-#if ENABLED(EEPROM_SETTINGS)
+#if ENABLED(EEPROM_SETTINGS) && DISABLED(FLASH_EEPROM_LOG)
 
 #include "../../inc/MarlinConfig.h"
 #include "../shared/persistent_store_api.h"
@@ -78,5 +78,5 @@ bool PersistentStore::read_data(int &pos, uint8_t* value, size_t size, uint16_t
 
 size_t PersistentStore::capacity() { return E2END + 1; }
 
-#endif // EEPROM_SETTINGS
+#endif // EEPROM_SETTINGS && !FLASH_EEPROM_LOG
 #endif // ARDUINO_ARCH_SAM
@@ -75,6 +75,50 @@ uint16_t HAL_adc_get_result(void) {
   return data;    // return 10bit value as Marlin expects
 }
 
+#if ENABLED(CONTINUOUS_ADC)
+
+  #define ADC_SCAN_MAX_PINS 16
+
+  static pin_t adc_scan_pins[ADC_SCAN_MAX_PINS];
+  static volatile uint8_t adc_scan_count = 0;
+  static uint16_t adc_scan_buffer[HAL_ADC_SCAN_SAMPLES][ADC_SCAN_MAX_PINS];
+  static uint8_t adc_scan_row = 0;
+  static uint64_t adc_scan_last = 0;
+
+  static void adc_scan_row_read(uint16_t * const row) {
+    for (uint8_t i = 0; i < adc_scan_count; i++) {
+      const pin_t pin = analogInputToDigitalPin(adc_scan_pins[i]);
+      row[i] = VALID_PIN(pin) ? (Gpio::get(pin) >> 2) & 0x3FF : 0;
+    }
+  }
+
+  void HAL_adc_scan_start(const pin_t pins[], const uint8_t count) {
+    adc_scan_count = 0;
+    const uint8_t n = MIN(count, ADC_SCAN_MAX_PINS);
+    for (uint8_t i = 0; i < n; i++) adc_scan_pins[i] = pins[i];
+    adc_scan_count = n;
+    // Fill the whole buffer, so the first sums are complete
+    for (uint8_t r = 0; r < HAL_ADC_SCAN_SAMPLES; r++) adc_scan_row_read(adc_scan_buffer[r]);
+  }
+
+  // Called by the simulation thread. Stands in for the DMA, one scan per millisecond.
+  void HAL_adc_scan_update(void) {
+    if (!adc_scan_count) return;
+    const uint64_t now = Clock::micros();
+    if (now - adc_scan_last < 1000) return;
+    adc_scan_last = now;
+    adc_scan_row_read(adc_scan_buffer[adc_scan_row]);
+    if (++adc_scan_row >= HAL_ADC_SCAN_SAMPLES) adc_scan_row = 0;
+  }
+
+  uint32_t HAL_adc_scan_sum(const uint8_t index) {
+    uint32_t sum = 0;
+    for (uint8_t r = 0; r < HAL_ADC_SCAN_SAMPLES; r++) sum += adc_scan_buffer[r][index];
+    return sum;
+  }
+
+#endif // CONTINUOUS_ADC
+
 void HAL_pwm_init(void) {
 
 }
@@ -66,6 +66,7 @@ uint8_t _getc();
 
 extern HalSerial usb_serial;
 #define MYSERIAL0 usb_serial
+#define HAS_SERIAL_RX_RING 1 // Command lines can be read from the RX ring in place
 #define NUM_SERIAL 1
 
 #define ST7920_DELAY_1 DELAY_NS(600)
@@ -77,7 +78,7 @@ extern HalSerial usb_serial;
 //
 #define CRITICAL_SECTION_START
 #define CRITICAL_SECTION_END
-#define ISRS_ENABLED()
+#define ISRS_ENABLED() true
 #define ENABLE_ISRS()
 #define DISABLE_ISRS()
 
@@ -103,6 +104,13 @@ void HAL_adc_enable_channel(int pin);
 void HAL_adc_start_conversion(const uint8_t adc_pin);
 uint16_t HAL_adc_get_result(void);
 
+// Continuous ADC scanning (CONTINUOUS_ADC), emulated by the simulation thread
+#define HAL_ADC_SCAN_SAMPLES 16   // Scans kept for each pin, summed by HAL_adc_scan_sum()
+
+void HAL_adc_scan_start(const pin_t pins[], const uint8_t count);
+uint32_t HAL_adc_scan_sum(const uint8_t index);
+void HAL_adc_scan_update(void);
+
 /* ---------------- Delay in cycles */
 FORCE_INLINE static void DELAY_CYCLES(uint64_t x) {
   Clock::delayCycles(x);
@@ -0,0 +1,94 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Simulated USB flash drive for USB_FLASH_DRIVE_SUPPORT.
+ *
+ * The drive is the FAT disk image "usbdrive.img", which is "inserted" once
+ * it exists. Setting USBDRIVE_TRACE in the environment reports every bulk
+ * transfer, to check how reads and writes are gathered.
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(USB_FLASH_DRIVE_SUPPORT)
+
+#include "../../sd/usb_flashdrive/flashdrive_device.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+static FILE *image_file;
+static uint32_t image_blocks;
+static bool trace;
+char usbdrive_filename[] = "usbdrive.img";
+
+static void trace_transfer(PGM_P const op, const uint32_t block, const uint8_t count) {
+  if (!trace) return;
+  SERIAL_ECHO_START();
+  serialprintPGM(op);
+  SERIAL_ECHOPAIR(" block ", block);
+  SERIAL_ECHOLNPAIR(" x", int(count));
+}
+
+bool FlashDriveDevice::start() {
+  trace = getenv("USBDRIVE_TRACE") != NULL;
+  return true;
+}
+
+void FlashDriveDevice::task() {
+  // Look for the image once a second until it turns up
+  static millis_t next_check_ms;
+  if (image_file || PENDING(millis(), next_check_ms)) return;
+  next_check_ms = millis() + 1000;
+  image_file = fopen(usbdrive_filename, "r+b");
+  if (image_file) {
+    fseek(image_file, 0, SEEK_END);
+    image_blocks = ftell(image_file) / 512;
+  }
+}
+
+bool FlashDriveDevice::isInserted() { return image_file != NULL; }
+
+bool FlashDriveDevice::mount() { return !image_blocks; }
+
+uint32_t FlashDriveDevice::capacity() { return image_blocks; }
+
+bool FlashDriveDevice::read(const uint32_t block, const uint8_t count, uint8_t *dst) {
+  trace_transfer(PSTR("USB read"), block, count);
+  if (!image_file || block + count > image_blocks) return true;
+  fseek(image_file, block * 512L, SEEK_SET);
+  return fread(dst, 512, count, image_file) != count;
+}
+
+bool FlashDriveDevice::write(const uint32_t block, const uint8_t count, const uint8_t *src) {
+  trace_transfer(PSTR("USB write"), block, count);
+  if (!image_file || block + count > image_blocks) return true;
+  fseek(image_file, block * 512L, SEEK_SET);
+  const bool err = fwrite(src, 512, count, image_file) != count;
+  fflush(image_file);
+  return err;
+}
+
+#endif // USB_FLASH_DRIVE_SUPPORT
+#endif // __PLAT_LINUX__
@@ -24,33 +24,59 @@
 
 #include "Clock.h"
 #include <stdio.h>
+#include <stdlib.h>
 #include "../../../inc/MarlinConfig.h"
+#include "../../../module/thermistor/thermistors.h"
 
 #include "Heater.h"
 
-Heater::Heater(pin_t heater, pin_t adc) {
+Heater::Heater(pin_t heater, pin_t adc, const short (*table)[2], uint8_t table_len, double gain, double tau, double dead_time)
+  : heater_pin(heater), adc_pin(adc), table(table), table_len(table_len), gain(gain), tau(tau) {
   heater_state = 0;
-  room_temp_raw = 150;
-  last = Clock::micros();
-  heater_pin = heater;
-  adc_pin = adc;
-  heat = 0.0;
+  last = next_delay_step = Clock::micros();
+  delay_slots = MAX(1, MIN(delay_slots_max, dead_time * 1000000 / delay_step_us));
+  delay_index = 0;
+  memset(delay_line, 0, sizeof(delay_line));
+  temperature = ambient;
 }
 
 Heater::~Heater() {
 }
 
+// Invert the thermistor table, interpolating between its entries
+double Heater::temp_to_adc(double temp) {
+  if (!table_len) return 0;
+  for (uint8_t i = 0; i < table_len - 1; i++) {
+    const double t0 = table[i][1], t1 = table[i + 1][1];
+    if (t0 != t1 && WITHIN(temp, MIN(t0, t1), MAX(t0, t1)))
+      return table[i][0] + (temp - t0) * (table[i + 1][0] - table[i][0]) / (t1 - t0);
+  }
+  return (temp > table[0][1]) == (table[0][1] > table[table_len - 1][1]) ? table[0][0] : table[table_len - 1][0];
+}
+
 void Heater::update() {
-  // crude pwm read and cruder heat simulation
   auto now = Clock::micros();
   double delta = (now - last);
   if (delta > 1000 ) {
-    heater_state = pwmcap.update(0xFFFF * Gpio::pin_map[heater_pin].value);
+    // A digital HIGH is full power, and an analogWrite value is out of 255
+    const uint16_t value = Gpio::pin_map[heater_pin].value;
+    heater_state = pwmcap.update(value > 1 ? value * 0x101 : value * 0xFFFF);
     last = now;
-    heat += (heater_state - heat) * (delta / 1000000000.0);
 
-    if (heat < room_temp_raw) heat = room_temp_raw;
-    Gpio::pin_map[analogInputToDigitalPin(adc_pin)].value = 0xFFFF - (uint16_t)heat;
+    // The dead time is a queue of the power applied in each 10ms step
+    for (; now >= next_delay_step; next_delay_step += delay_step_us) {
+      delay_line[delay_index] = heater_state;
+      if (++delay_index >= delay_slots) delay_index = 0;
+    }
+    const double power = delay_line[delay_index] / 65535.0;
+
+    temperature += (gain * power - (temperature - ambient)) * (delta / 1000000.0) / tau;
+
+    // The table is in oversampled counts, and the ADC reads the top 10 of 12 bits.
+    // Up to one count of noise dithers the reading, as on a real ADC, so
+    // oversampling resolves the temperature finer than one count.
+    const double counts = temp_to_adc(temperature) / double(OVERSAMPLENR) + rand() / (RAND_MAX + 1.0);
+    Gpio::pin_map[analogInputToDigitalPin(adc_pin)].value = uint16_t(counts) * 4;
   }
 }
 
@@ -31,17 +31,36 @@ struct LowpassFilter {
   }
 };
 
+/**
+ * A heater and its thermistor, modelled as first order plus dead time:
+ *
+ *   dT/dt = (gain * power - (T - ambient)) / tau
+ *
+ * where power (0-1) is the heater PWM from dead_time seconds ago. The
+ * temperature is turned back into an ADC reading through the firmware's
+ * own thermistor table, so Marlin reads the modelled temperature.
+ */
 class Heater: public Peripheral {
 public:
-  Heater(pin_t heater, pin_t adc);
+  Heater(pin_t heater, pin_t adc, const short (*table)[2], uint8_t table_len, double gain, double tau, double dead_time);
   virtual ~Heater();
   void interrupt(GpioEvent ev);
   void update();
 
+  static constexpr double ambient = 20.0;
+  static constexpr uint32_t delay_step_us = 10000;
+  static constexpr uint16_t delay_slots_max = 2000;  // 20 seconds of dead time
+
   pin_t heater_pin, adc_pin;
-  uint16_t room_temp_raw;
+  const short (*table)[2];
+  uint8_t table_len;
+  double gain, tau;
   uint16_t heater_state;
   LowpassFilter pwmcap;
-  double heat;
-  uint64_t last;
+  uint16_t delay_line[delay_slots_max], delay_slots, delay_index;
+  double temperature;
+  uint64_t last, next_delay_step;
+
+private:
+  double temp_to_adc(double temp);
 };
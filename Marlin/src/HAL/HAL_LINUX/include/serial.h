@@ -62,6 +62,17 @@ public:
     return true;
   }
 
+  // Get the count of unread items that are contiguous in the buffer,
+  // starting 'offset' items past the read index, without consuming them
+  uint32_t run(const uint32_t offset, const T* &ptr) volatile {
+    const uint32_t start = index_read + offset, count = index_write - start;
+    ptr = (const T*)&buffer[mask(start)];
+    return MIN(count, buffer_size - mask(start));
+  }
+
+  // Consume items that were processed in place
+  void discard(const uint32_t count) volatile { index_read += count; }
+
 private:
   uint32_t mask(uint32_t val) volatile {
     return buffer_mask & val;
@@ -107,6 +118,11 @@ public:
 
   void flush() { receive_buffer.clear(); }
 
+  // Direct access to the RX ring, used to assemble command lines in place
+  uint16_t rx_run(const uint16_t offset, const uint8_t* &ptr) { return (uint16_t)receive_buffer.run(offset, ptr); }
+  void rx_discard(const uint16_t count) { receive_buffer.discard(count); }
+  bool rx_full() { return receive_buffer.full(); }
+
   uint8_t availableForWrite(void){
     return transmit_buffer.free() > 255 ? 255 : (uint8_t)transmit_buffer.free();
   }
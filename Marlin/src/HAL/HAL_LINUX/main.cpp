@@ -34,6 +34,7 @@ extern void loop();
 #include "../shared/Delay.h"
 #include "hardware/IOLoggerCSV.h"
 #include "hardware/Heater.h"
+#include "../../module/thermistor/thermistors.h"
 #include "hardware/LinearAxis.h"
 
 // simple stdout / stdin implementation for fake serial port
@@ -49,7 +50,7 @@ void write_serial_thread() {
 void read_serial_thread() {
   char buffer[255] = {};
   for (;;) {
-    std::size_t len = MIN(usb_serial.receive_buffer.free(), 254U);
+    std::size_t len = MIN(usb_serial.receive_buffer.free() + 1, 255U); // fgets reads up to len - 1
     if (fgets(buffer, len, stdin))
       for (std::size_t i = 0; i < strlen(buffer); i++)
         usb_serial.receive_buffer.write(buffer[i]);
@@ -58,8 +59,17 @@ void read_serial_thread() {
 }
 
 void simulation_loop() {
-  Heater hotend(HEATER_0_PIN, TEMP_0_PIN);
-  Heater bed(HEATER_BED_PIN, TEMP_BED_PIN);
+  // Hotend: 300°C over ambient at full power, tau 90s, dead time 4s.
+  // Bed: 120°C over ambient at full power, tau 240s, dead time 8s.
+  Heater hotend(HEATER_0_PIN, TEMP_0_PIN, HEATER_0_TEMPTABLE, HEATER_0_TEMPTABLE_LEN, 300, 90, 4);
+  Heater bed(HEATER_BED_PIN, TEMP_BED_PIN,
+    #ifdef BEDTEMPTABLE
+      BEDTEMPTABLE, BEDTEMPTABLE_LEN,
+    #else
+      NULL, 0,
+    #endif
+    120, 240, 8
+  );
   LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN);
   LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN);
   LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN);
@@ -87,9 +97,13 @@ void simulation_loop() {
     z_axis.update();
     extruder0.update();
 
+    #if ENABLED(CONTINUOUS_ADC)
+      HAL_adc_scan_update();
+    #endif
+
     #ifdef GPIO_LOGGING
       if (x_axis.position != x || y_axis.position != y || z_axis.position != z) {
-        uint64_t update = MAX3(x_axis.last_update, y_axis.last_update, z_axis.last_update);
+        uint64_t update = MAX(x_axis.last_update, y_axis.last_update, z_axis.last_update);
         position_log << update << ", " << x_axis.position << ", " << y_axis.position << ", " << z_axis.position << std::endl;
         position_log.flush();
         x = x_axis.position;
@@ -0,0 +1,107 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Simulated flash device for FLASH_EEPROM_LOG.
+ *
+ * Two 8K sectors kept in "flash.dat", followed by an erase counter for
+ * each sector. Like real flash, programming can only clear bits. Setting
+ * a bit without an erase is refused and reported, so the log store can be
+ * tested for double writes. The erase counters show the wear.
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(EEPROM_SETTINGS) && ENABLED(FLASH_EEPROM_LOG)
+
+#include "../shared/persistent_store_log.h"
+#include <stdio.h>
+
+#define FLASH_SECTOR_SIZE 0x2000
+#define FLASH_PROGRAM_SIZE 4
+
+const uint32_t FlashLogDevice::sector_size = FLASH_SECTOR_SIZE;
+const uint8_t FlashLogDevice::program_size = FLASH_PROGRAM_SIZE;
+
+static uint8_t flash[2][FLASH_SECTOR_SIZE];
+static uint32_t erase_count[2];
+static bool flash_loaded;
+char flash_filename[] = "flash.dat";
+
+static void flash_load() {
+  if (flash_loaded) return;
+  memset(flash, 0xFF, sizeof(flash));
+  FILE * flash_file = fopen(flash_filename, "rb");
+  if (flash_file != NULL) {
+    fread(flash, sizeof(uint8_t), sizeof(flash), flash_file);
+    fread(erase_count, sizeof(uint32_t), COUNT(erase_count), flash_file);
+    fclose(flash_file);
+  }
+  flash_loaded = true;
+}
+
+static bool flash_save() {
+  FILE * flash_file = fopen(flash_filename, "wb");
+  if (flash_file == NULL) return true;
+  fwrite(flash, sizeof(uint8_t), sizeof(flash), flash_file);
+  fwrite(erase_count, sizeof(uint32_t), COUNT(erase_count), flash_file);
+  fclose(flash_file);
+  return false;
+}
+
+const uint8_t* FlashLogDevice::sector(const uint8_t s) {
+  flash_load();
+  return flash[s];
+}
+
+bool FlashLogDevice::erase(const uint8_t s) {
+  flash_load();
+  memset(flash[s], 0xFF, FLASH_SECTOR_SIZE);
+  erase_count[s]++;
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR("Flash sector ", int(s));
+  SERIAL_ECHOLNPAIR(" erased, cycles: ", erase_count[s]);
+  return flash_save();
+}
+
+bool FlashLogDevice::program(const uint8_t s, const uint32_t offset, const void *data, const uint16_t size) {
+  flash_load();
+  if (offset % FLASH_PROGRAM_SIZE || size % FLASH_PROGRAM_SIZE || offset + size > FLASH_SECTOR_SIZE) return true;
+
+  uint8_t * const dst = &flash[s][offset];
+  const uint8_t * const src = (const uint8_t*)data;
+  for (uint16_t i = 0; i < size; i++) {
+    if (src[i] & ~dst[i]) {
+      SERIAL_ECHO_START();
+      SERIAL_ECHOPAIR("Flash sector ", int(s));
+      SERIAL_ECHOLNPAIR(" programmed without erase at ", offset + i);
+      return true;
+    }
+  }
+  for (uint16_t i = 0; i < size; i++) dst[i] &= src[i];
+  return flash_save();
+}
+
+#endif // EEPROM_SETTINGS && FLASH_EEPROM_LOG
+#endif // __PLAT_LINUX__
@@ -24,13 +24,14 @@
 
 #include "../../inc/MarlinConfig.h"
 
-#if ENABLED(EEPROM_SETTINGS)
+#if ENABLED(EEPROM_SETTINGS) && DISABLED(FLASH_EEPROM_LOG)
 
 #include "../shared/persistent_store_api.h"
 #include <stdio.h>
 
 uint8_t buffer[E2END];
 char filename[] = "eeprom.dat";
+static bool buffer_dirty; // Only write the file back if the data changed
 
 bool PersistentStore::access_start() {
   const char eeprom_erase_value = 0xFF;
@@ -53,10 +54,12 @@ bool PersistentStore::access_start() {
 }
 
 bool PersistentStore::access_finish() {
+  if (!buffer_dirty) return true;
   FILE * eeprom_file = fopen(filename, "wb");
   if (eeprom_file == NULL) return false;
   fwrite(buffer, sizeof(uint8_t), sizeof(buffer), eeprom_file);
   fclose(eeprom_file);
+  buffer_dirty = false;
   return true;
 }
 
@@ -64,7 +67,10 @@ bool PersistentStore::write_data(int &pos, const uint8_t *value, const size_t si
   std::size_t bytes_written = 0;
 
   for (std::size_t i = 0; i < size; i++) {
-    buffer[pos+i] = value[i];
+    if (buffer[pos+i] != value[i]) {
+      buffer[pos+i] = value[i];
+      buffer_dirty = true;
+    }
     bytes_written ++;
   }
 
@@ -97,5 +103,5 @@ bool PersistentStore::read_data(int &pos, uint8_t* value, const size_t size, uin
 
 size_t PersistentStore::capacity() { return 4096; } // 4KiB of Emulated EEPROM
 
-#endif // EEPROM_SETTINGS
+#endif // EEPROM_SETTINGS && !FLASH_EEPROM_LOG
 #endif // __PLAT_LINUX__
@@ -63,4 +63,90 @@ void flashFirmware(int16_t value) {
   NVIC_SystemReset();
 }
 
+#if ENABLED(CONTINUOUS_ADC)
+
+  /**
+   * The ADC converts the enabled channels in burst mode. When the highest
+   * channel completes a scan it requests a DMA burst that copies all eight
+   * result registers into the next row of a ring of HAL_ADC_SCAN_SAMPLES
+   * rows. The linked list of rows loops back on itself, so the transfer
+   * never ends and needs no interrupts.
+   */
+
+  #define ADC_SCAN_CHANNELS   8
+  #define ADC_SCAN_DMA_CH     LPC_GPDMACH7    // Lowest priority channel
+  #define ADC_SCAN_DMA_ADC    4               // DMA connection number of the ADC
+
+  typedef struct {
+    uint32_t src, dst, next, control;
+  } dma_lli_t;
+
+  static uint8_t adc_scan_channel[ADC_SCAN_CHANNELS];
+  static uint32_t adc_scan_buffer[HAL_ADC_SCAN_SAMPLES][ADC_SCAN_CHANNELS];
+  static dma_lli_t adc_scan_lli[HAL_ADC_SCAN_SAMPLES];
+
+  void HAL_adc_scan_start(const pin_t pins[], const uint8_t count) {
+    const uint8_t n = MIN(count, ADC_SCAN_CHANNELS);
+    uint8_t channels = 0;
+    for (uint8_t i = 0; i < n; i++) {
+      HAL_ANALOG_SELECT(pins[i]);
+      adc_scan_channel[i] = DIGITAL_PIN_TO_ANALOG_PIN(pins[i]);
+      SBI(channels, adc_scan_channel[i]);
+    }
+    if (!channels) return;
+
+    uint8_t last = 7;
+    while (!TEST(channels, last)) last--;
+
+    SBI(LPC_SC->PCONP, 12);                   // Power ON the ADC
+    SBI(LPC_SC->PCONP, 29);                   // Power ON the GPDMA
+    LPC_GPDMA->DMACConfig = 1;                // Enable the GPDMA, little-endian
+
+    // 8 words from ADDR0-7 into one row, then on to the next row
+    const uint32_t control = ADC_SCAN_CHANNELS  // Transfer size
+                           | (2UL << 12)        // Source burst: 8
+                           | (2UL << 15)        // Destination burst: 8
+                           | (2UL << 18)        // Source width: 32 bits
+                           | (2UL << 21)        // Destination width: 32 bits
+                           | _BV(26)            // Increment the source
+                           | _BV(27);           // Increment the destination
+    for (uint8_t r = 0; r < HAL_ADC_SCAN_SAMPLES; r++) {
+      adc_scan_lli[r].src = (uint32_t)&LPC_ADC->ADDR0;
+      adc_scan_lli[r].dst = (uint32_t)adc_scan_buffer[r];
+      adc_scan_lli[r].next = (uint32_t)&adc_scan_lli[(r + 1) % (HAL_ADC_SCAN_SAMPLES)];
+      adc_scan_lli[r].control = control;
+    }
+
+    ADC_SCAN_DMA_CH->DMACCConfig = 0;
+    LPC_GPDMA->DMACIntTCClear = _BV(7);
+    LPC_GPDMA->DMACIntErrClr = _BV(7);
+    ADC_SCAN_DMA_CH->DMACCSrcAddr = adc_scan_lli[0].src;
+    ADC_SCAN_DMA_CH->DMACCDestAddr = adc_scan_lli[0].dst;
+    ADC_SCAN_DMA_CH->DMACCLLI = adc_scan_lli[0].next;
+    ADC_SCAN_DMA_CH->DMACCControl = control;
+    ADC_SCAN_DMA_CH->DMACCConfig = _BV(0)                      // Enable
+                                 | (ADC_SCAN_DMA_ADC << 1)     // Source: ADC
+                                 | (2UL << 11);                // Peripheral to memory
+
+    // Only the last channel of a scan requests the DMA
+    LPC_ADC->ADINTEN = _BV(last);
+
+    // Slowest ADC clock (PCLK / 256). Temperatures change slowly,
+    // and the buffer still refreshes many times per reading.
+    LPC_ADC->ADCR = channels
+                  | (255UL << 8)              // CLKDIV
+                  | _BV(16)                   // BURST
+                  | _BV(21);                  // PDN: operational
+  }
+
+  uint32_t HAL_adc_scan_sum(const uint8_t index) {
+    const uint8_t ch = adc_scan_channel[index];
+    uint32_t sum = 0;
+    for (uint8_t r = 0; r < HAL_ADC_SCAN_SAMPLES; r++)
+      sum += (adc_scan_buffer[r][ch] >> 6) & 0x3FF; // 12 to 10 bits, as Marlin expects
+    return sum;
+  }
+
+#endif // CONTINUOUS_ADC
+
 #endif // TARGET_LPC1768
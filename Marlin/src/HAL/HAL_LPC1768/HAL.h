@@ -147,6 +147,12 @@ using FilteredADC = LPC176x::ADC<ADC_LOWPASS_K_VALUE, ADC_MEDIAN_FILTER_SIZE>;
 #define HAL_READ_ADC()         FilteredADC::get_result()
 #define HAL_ADC_READY()        FilteredADC::finished_conversion()
 
+// Continuous ADC scanning (CONTINUOUS_ADC)
+#define HAL_ADC_SCAN_SAMPLES 16   // Scans kept for each pin, summed by HAL_adc_scan_sum()
+
+void HAL_adc_scan_start(const pin_t pins[], const uint8_t count);
+uint32_t HAL_adc_scan_sum(const uint8_t index);
+
 // Parse a G-code word into a pin index
 int16_t PARSED_PIN_INDEX(const char code, const int16_t dval);
 // P0.6 thru P0.9 are for the onboard SD card
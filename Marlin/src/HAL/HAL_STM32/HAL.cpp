@@ -144,4 +144,90 @@ uint16_t HAL_adc_get_result(void) {
   return HAL_adc_result;
 }
 
+#if ENABLED(CONTINUOUS_ADC)
+
+  /**
+   * ADC1 scans its pins in continuous mode and DMA2 Stream 0 copies the
+   * results into a circular buffer of HAL_ADC_SCAN_SAMPLES scans. The DMA
+   * interrupt is left disabled, as the circular transfer needs no attention.
+   * A pin with no ADC1 input (e.g., one only on ADC3) is read with
+   * analogRead() when its sum is requested, as without CONTINUOUS_ADC.
+   */
+
+  #define ADC_SCAN_MAX_PINS 16
+
+  static ADC_HandleTypeDef adc_scan_handle;
+  static DMA_HandleTypeDef adc_scan_dma;
+  static uint8_t adc_scan_count;                        // Pins in the ADC1 scan
+  static int8_t adc_scan_rank[ADC_SCAN_MAX_PINS];       // Place of each pin in the scan, -1 if polled
+  static pin_t adc_poll_pin[ADC_SCAN_MAX_PINS];
+  static uint16_t adc_scan_buffer[HAL_ADC_SCAN_SAMPLES * ADC_SCAN_MAX_PINS];
+
+  void HAL_adc_scan_start(const pin_t pins[], const uint8_t count) {
+    const uint8_t pin_count = MIN(count, ADC_SCAN_MAX_PINS);
+
+    adc_scan_count = 0;
+    for (uint8_t i = 0; i < pin_count; i++) {
+      adc_poll_pin[i] = pins[i];
+      adc_scan_rank[i] = pinmap_peripheral(analogInputToPinName(pins[i]), PinMap_ADC) == ADC1 ? adc_scan_count++ : -1;
+    }
+    if (!adc_scan_count) return;
+
+    __HAL_RCC_ADC1_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    adc_scan_dma.Instance = DMA2_Stream0;
+    adc_scan_dma.Init.Channel = DMA_CHANNEL_0;
+    adc_scan_dma.Init.Direction = DMA_PERIPH_TO_MEMORY;
+    adc_scan_dma.Init.PeriphInc = DMA_PINC_DISABLE;
+    adc_scan_dma.Init.MemInc = DMA_MINC_ENABLE;
+    adc_scan_dma.Init.PeriphDataAlignment = DMA_PDATAALIGN_HALFWORD;
+    adc_scan_dma.Init.MemDataAlignment = DMA_MDATAALIGN_HALFWORD;
+    adc_scan_dma.Init.Mode = DMA_CIRCULAR;
+    adc_scan_dma.Init.Priority = DMA_PRIORITY_LOW;
+    adc_scan_dma.Init.FIFOMode = DMA_FIFOMODE_DISABLE;
+    HAL_DMA_Init(&adc_scan_dma);
+    __HAL_LINKDMA(&adc_scan_handle, DMA_Handle, adc_scan_dma);
+
+    adc_scan_handle.Instance = ADC1;
+    adc_scan_handle.Init.ClockPrescaler = ADC_CLOCK_SYNC_PCLK_DIV8;
+    adc_scan_handle.Init.Resolution = ADC_RESOLUTION_12B;
+    adc_scan_handle.Init.DataAlign = ADC_DATAALIGN_RIGHT;
+    adc_scan_handle.Init.ScanConvMode = ENABLE;
+    adc_scan_handle.Init.ContinuousConvMode = ENABLE;
+    adc_scan_handle.Init.DiscontinuousConvMode = DISABLE;
+    adc_scan_handle.Init.NbrOfDiscConversion = 0;
+    adc_scan_handle.Init.ExternalTrigConv = ADC_SOFTWARE_START;
+    adc_scan_handle.Init.ExternalTrigConvEdge = ADC_EXTERNALTRIGCONVEDGE_NONE;
+    adc_scan_handle.Init.NbrOfConversion = adc_scan_count;
+    adc_scan_handle.Init.DMAContinuousRequests = ENABLE;
+    adc_scan_handle.Init.EOCSelection = ADC_EOC_SEQ_CONV;
+    HAL_ADC_Init(&adc_scan_handle);
+
+    for (uint8_t i = 0; i < pin_count; i++) {
+      if (adc_scan_rank[i] < 0) continue;
+      const PinName pin = analogInputToPinName(pins[i]);
+      pinmap_pinout(pin, PinMap_ADC);                 // Analog mode
+      ADC_ChannelConfTypeDef config;
+      config.Channel = STM_PIN_CHANNEL(pinmap_function(pin, PinMap_ADC));
+      config.Rank = adc_scan_rank[i] + 1;
+      config.SamplingTime = ADC_SAMPLETIME_480CYCLES; // Slowest. Temperatures change slowly.
+      config.Offset = 0;
+      HAL_ADC_ConfigChannel(&adc_scan_handle, &config);
+    }
+
+    HAL_ADC_Start_DMA(&adc_scan_handle, (uint32_t*)adc_scan_buffer, HAL_ADC_SCAN_SAMPLES * adc_scan_count);
+  }
+
+  uint32_t HAL_adc_scan_sum(const uint8_t index) {
+    const int8_t rank = adc_scan_rank[index];
+    if (rank < 0) return uint32_t(analogRead(adc_poll_pin[index])) * (HAL_ADC_SCAN_SAMPLES);
+    uint32_t sum = 0;
+    for (uint16_t i = rank; i < HAL_ADC_SCAN_SAMPLES * adc_scan_count; i += adc_scan_count)
+      sum += adc_scan_buffer[i] >> 2; // 12 to 10 bits, as Marlin expects
+    return sum;
+  }
+
+#endif // CONTINUOUS_ADC
+
 #endif // ARDUINO_ARCH_STM32
@@ -213,6 +213,12 @@ void HAL_adc_start_conversion(const uint8_t adc_pin);
 
 uint16_t HAL_adc_get_result(void);
 
+// Continuous ADC scanning (CONTINUOUS_ADC)
+#define HAL_ADC_SCAN_SAMPLES 16   // Scans kept for each pin, summed by HAL_adc_scan_sum()
+
+void HAL_adc_scan_start(const pin_t pins[], const uint8_t count);
+uint32_t HAL_adc_scan_sum(const uint8_t index);
+
 #define GET_PIN_MAP_PIN(index) index
 #define GET_PIN_MAP_INDEX(pin) pin
 #define PARSED_PIN_INDEX(code, dval) parser.intval(code, dval)
@@ -69,3 +69,7 @@
 #if ENABLED(EMERGENCY_PARSER)
   #error "EMERGENCY_PARSER is not yet implemented for STM32. Disable EMERGENCY_PARSER to continue."
 #endif
+
+#if ENABLED(CONTINUOUS_ADC) && !(defined(STM32F4xx) || defined(STM32F7xx))
+  #error "CONTINUOUS_ADC is currently only supported for STM32F4xx and STM32F7xx."
+#endif
@@ -39,6 +39,7 @@
 char HAL_STM32F1_eeprom_content[HAL_STM32F1_EEPROM_SIZE];
 
 char eeprom_filename[] = "eeprom.dat";
+static bool eeprom_dirty; // Only write the file back if the data changed
 
 bool PersistentStore::access_start() {
   if (!card.isDetected()) return false;
@@ -54,16 +55,22 @@ bool PersistentStore::access_start() {
 }
 
 bool PersistentStore::access_finish() {
+  if (!eeprom_dirty) return true;
   if (!card.isDetected()) return false;
   card.openFile(eeprom_filename, true);
   int16_t bytes_written = card.write(HAL_STM32F1_eeprom_content, HAL_STM32F1_EEPROM_SIZE);
   card.closefile();
-  return (bytes_written == HAL_STM32F1_EEPROM_SIZE);
+  if (bytes_written != HAL_STM32F1_EEPROM_SIZE) return false;
+  eeprom_dirty = false;
+  return true;
 }
 
 bool PersistentStore::write_data(int &pos, const uint8_t *value, const size_t size, uint16_t *crc) {
   for (size_t i = 0; i < size; i++)
-    HAL_STM32F1_eeprom_content[pos + i] = value[i];
+    if (HAL_STM32F1_eeprom_content[pos + i] != value[i]) {
+      HAL_STM32F1_eeprom_content[pos + i] = value[i];
+      eeprom_dirty = true;
+    }
   crc16(crc, value, size);
   pos += size;
   return false;
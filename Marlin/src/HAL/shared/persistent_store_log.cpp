@@ -0,0 +1,231 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Description: log-structured settings store over flash (FLASH_EEPROM_LOG).
+ * Not platform dependent. The HAL provides a FlashLogDevice.
+ *
+ * The emulated EEPROM is kept in RAM and divided into 16-byte blocks.
+ * Saving appends one record for each changed block to the active sector,
+ * so a save costs a few small programs and no erase. A record holds the
+ * block number, a CRC and the block data. On startup the records of the
+ * active sector are replayed in order over an erased (0xFF) image, and
+ * records with a bad CRC (interrupted writes) are skipped.
+ *
+ * When the active sector is full the whole image is compacted into the
+ * other sector, which is only then erased. Its header is programmed last,
+ * so a power loss during compaction leaves the old sector in charge.
+ * The sector with the highest sequence number is the active one. Erases
+ * alternate between the two sectors.
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(EEPROM_SETTINGS) && ENABLED(FLASH_EEPROM_LOG)
+
+#include "persistent_store_api.h"
+#include "persistent_store_log.h"
+
+#ifndef E2END
+  #define E2END 0xFFF // Default to 4K of emulated EEPROM
+#endif
+
+#define LOG_MAGIC       0x474F4C4DUL  // "MLOG"
+#define LOG_BLOCK_SIZE  16
+#define LOG_BLOCKS      ((E2END + 1) / (LOG_BLOCK_SIZE))
+#define LOG_MAX_STRIDE  32            // Largest record after padding to program_size
+
+typedef struct {
+  uint32_t magic, sequence;
+} log_header_t;
+
+typedef struct {
+  uint16_t block, crc;
+  uint8_t data[LOG_BLOCK_SIZE];
+} log_record_t;
+
+static_assert(LOG_BLOCKS * (LOG_BLOCK_SIZE) == E2END + 1, "The emulated EEPROM size must be a multiple of 16 bytes.");
+static_assert(LOG_BLOCKS < 0xFFFF, "The emulated EEPROM is too large for FLASH_EEPROM_LOG.");
+
+static uint8_t ram_eeprom[E2END + 1],
+               dirty[(LOG_BLOCKS + 7) / 8],   // Blocks changed since the last save
+               active_sector;
+static uint32_t sequence,                     // Sequence number of the active sector
+                write_offset;                 // Next free record in the active sector
+static bool loaded;
+
+// Round a size up to whole program units
+static inline uint16_t padded(const uint16_t size) {
+  const uint8_t u = FlashLogDevice::program_size;
+  return (size + u - 1) / u * u;
+}
+
+static inline bool is_erased(const uint8_t *p, const uint16_t size) {
+  for (uint16_t i = 0; i < size; i++) if (p[i] != 0xFF) return false;
+  return true;
+}
+
+static uint16_t record_crc(const log_record_t &rec) {
+  uint16_t crc = 0;
+  crc16(&crc, (uint8_t*)&rec.block, sizeof(rec.block));
+  crc16(&crc, rec.data, sizeof(rec.data));
+  return crc;
+}
+
+static inline bool is_dirty(const uint16_t b) { return TEST(dirty[b >> 3], b & 7); }
+
+// Program a block as a record at the given offset of a sector
+static bool append(const uint8_t s, uint32_t &offset, const uint16_t b) {
+  uint8_t buf[LOG_MAX_STRIDE];
+  const uint16_t stride = padded(sizeof(log_record_t));
+  if (offset + stride > FlashLogDevice::sector_size) return true;
+
+  memset(buf, 0xFF, stride);
+  log_record_t &rec = *(log_record_t*)buf;
+  rec.block = b;
+  memcpy(rec.data, &ram_eeprom[b * (LOG_BLOCK_SIZE)], LOG_BLOCK_SIZE);
+  rec.crc = record_crc(rec);
+
+  // Never program the same slot twice, even after a failure
+  const bool err = FlashLogDevice::program(s, offset, buf, stride);
+  offset += stride;
+  return err;
+}
+
+// Find the newest sector and replay its records into RAM
+static void load() {
+  const uint16_t stride = padded(sizeof(log_record_t));
+  bool found = false;
+
+  memset(ram_eeprom, 0xFF, sizeof(ram_eeprom));
+  memset(dirty, 0, sizeof(dirty));
+
+  for (uint8_t s = 0; s < 2; s++) {
+    const log_header_t &hdr = *(const log_header_t*)FlashLogDevice::sector(s);
+    if (hdr.magic == LOG_MAGIC && (!found || hdr.sequence > sequence)) {
+      active_sector = s;
+      sequence = hdr.sequence;
+      found = true;
+    }
+  }
+
+  if (!found) {
+    // Nothing stored yet. Mark sector 1 full so the first save formats sector 0.
+    active_sector = 1;
+    sequence = 0;
+    write_offset = FlashLogDevice::sector_size;
+  }
+  else {
+    const uint8_t * const base = FlashLogDevice::sector(active_sector);
+    write_offset = padded(sizeof(log_header_t));
+    for (; write_offset + stride <= FlashLogDevice::sector_size; write_offset += stride) {
+      const uint8_t * const p = base + write_offset;
+      if (is_erased(p, stride)) break;
+      log_record_t rec;
+      memcpy(&rec, p, sizeof(rec));
+      if (rec.block < LOG_BLOCKS && rec.crc == record_crc(rec))
+        memcpy(&ram_eeprom[rec.block * (LOG_BLOCK_SIZE)], rec.data, LOG_BLOCK_SIZE);
+    }
+  }
+
+  loaded = true;
+}
+
+// Write every non-empty block into the other sector and make it active
+static bool compact() {
+  const uint8_t s = active_sector ^ 1;
+
+  if (FlashLogDevice::erase(s)) return true;
+
+  uint32_t offset = padded(sizeof(log_header_t));
+  for (uint16_t b = 0; b < LOG_BLOCKS; b++)
+    if (!is_erased(&ram_eeprom[b * (LOG_BLOCK_SIZE)], LOG_BLOCK_SIZE) && append(s, offset, b))
+      return true;
+
+  // The header goes last, making the new sector valid
+  uint8_t buf[LOG_MAX_STRIDE];
+  memset(buf, 0xFF, sizeof(buf));
+  const log_header_t hdr = { LOG_MAGIC, sequence + 1 };
+  memcpy(buf, &hdr, sizeof(hdr));
+  if (FlashLogDevice::program(s, 0, buf, padded(sizeof(hdr)))) return true;
+
+  active_sector = s;
+  sequence++;
+  write_offset = offset;
+  return false;
+}
+
+// Append changed blocks, compacting first if they don't fit
+static bool flush() {
+  uint16_t count = 0;
+  for (uint16_t b = 0; b < LOG_BLOCKS; b++) if (is_dirty(b)) count++;
+  if (!count) return false;
+
+  if (write_offset + count * padded(sizeof(log_record_t)) > FlashLogDevice::sector_size) {
+    if (compact()) return true;
+  }
+  else {
+    for (uint16_t b = 0; b < LOG_BLOCKS; b++)
+      if (is_dirty(b) && append(active_sector, write_offset, b)) return true;
+  }
+
+  memset(dirty, 0, sizeof(dirty));
+  return false;
+}
+
+bool PersistentStore::access_start() {
+  if (!loaded) load();
+  return true;
+}
+
+bool PersistentStore::access_finish() {
+  if (flush()) {
+    SERIAL_ECHO_MSG(MSG_ERR_EEPROM_WRITE);
+    return false;
+  }
+  return true;
+}
+
+bool PersistentStore::write_data(int &pos, const uint8_t *value, size_t size, uint16_t *crc) {
+  for (size_t i = 0; i < size; i++) {
+    const int p = pos + i;
+    if (ram_eeprom[p] != value[i]) {
+      ram_eeprom[p] = value[i];
+      SBI(dirty[p / (LOG_BLOCK_SIZE) >> 3], (p / (LOG_BLOCK_SIZE)) & 7);
+    }
+  }
+  crc16(crc, value, size);
+  pos += size;
+  return false;
+}
+
+bool PersistentStore::read_data(int &pos, uint8_t* value, size_t size, uint16_t *crc, const bool writing/*=true*/) {
+  const uint8_t * const src = &ram_eeprom[pos];
+  if (writing) memcpy(value, src, size);
+  crc16(crc, src, size);
+  pos += size;
+  return false;
+}
+
+size_t PersistentStore::capacity() { return E2END + 1; }
+
+#endif // EEPROM_SETTINGS && FLASH_EEPROM_LOG
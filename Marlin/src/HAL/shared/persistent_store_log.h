@@ -0,0 +1,43 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Flash device for the log-structured settings store (FLASH_EEPROM_LOG).
+ *
+ * A HAL supporting FLASH_EEPROM_LOG provides two equal, memory-mapped
+ * sectors. Erasing sets every byte of a sector to 0xFF. Programming may
+ * only clear bits, in aligned units of program_size (at most 16) bytes.
+ * erase() and program() return true on error, like write_data().
+ */
+
+#include <stdint.h>
+
+class FlashLogDevice {
+public:
+  static const uint32_t sector_size;
+  static const uint8_t program_size;
+
+  static const uint8_t* sector(const uint8_t s);
+  static bool erase(const uint8_t s);
+  static bool program(const uint8_t s, const uint32_t offset, const void *data, const uint16_t size);
+};
@@ -60,6 +60,10 @@
   #include "feature/host_actions.h"
 #endif
 
+#if ENABLED(BINARY_TELEMETRY)
+  #include "feature/telemetry.h"
+#endif
+
 #if HAS_BUZZER && DISABLED(LCD_USE_I2C_BUZZER)
   #include "libs/buzzer.h"
 #endif
@@ -688,6 +692,14 @@ void idle(
 
   thermalManager.manage_heater();
 
+  #if ENABLED(PRIORITY_COMMANDS)
+    get_priority_commands();
+  #endif
+
+  #if ENABLED(DEFERRED_SERIAL_OUTPUT)
+    deferred_serial.task();
+  #endif
+
   #if ENABLED(PRINTCOUNTER)
     print_job_timer.tick();
   #endif
@@ -716,6 +728,9 @@ void idle(
       #if ENABLED(AUTO_REPORT_SD_STATUS)
         card.auto_report_sd_status();
       #endif
+      #if ENABLED(BINARY_TELEMETRY)
+        telemetry.report();
+      #endif
     }
   #endif
 
@@ -752,6 +767,10 @@ void kill(PGM_P const lcd_msg/*=NULL*/) {
 
 void minkill() {
 
+  #if ENABLED(DEFERRED_SERIAL_OUTPUT)
+    deferred_serial.flushTX(); // Send all queued messages
+  #endif
+
   // Wait a short time (allows messages to get out before shutting down.
   for (int i = 1000; i--;) DELAY_US(600);
 
@@ -0,0 +1,379 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * deferred_serial.cpp - Non-blocking serial output
+ *
+ * Each record starts with a tag byte holding the record type (low nybble)
+ * and the destination ports (high nybble):
+ *
+ *   REC_TEXT    tag, chars..., NUL    Consecutive text is appended in place
+ *   REC_CHAR    tag, byte             Any byte, including NUL
+ *   REC_PGM     tag, PGM_P            A string in PROGMEM
+ *   REC_LONG    tag, long, base
+ *   REC_ULONG   tag, unsigned long, base
+ *   REC_DOUBLE  tag, double, digits
+ *
+ * Numbers are only converted to text once the port has room for them.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(DEFERRED_SERIAL_OUTPUT)
+
+#include "serial.h"
+#include <stdarg.h>
+
+DeferredSerial deferred_serial;
+
+enum : uint8_t { REC_TEXT, REC_CHAR, REC_PGM, REC_LONG, REC_ULONG, REC_DOUBLE };
+
+#define RING_MASK (DEFERRED_SERIAL_BUFFER_SIZE - 1)
+#define MAX_RECORD_SIZE (2 + MAX(sizeof(long), sizeof(double)))
+
+typedef uint16_t ring_pos_t;
+
+static uint8_t ring[DEFERRED_SERIAL_BUFFER_SIZE];
+static volatile ring_pos_t ring_head, ring_tail;
+
+static bool text_open;          // The newest record is text and may be appended to
+static uint8_t text_ports;
+static volatile bool pumping;   // Set while task() is sending
+
+// The record being sent
+static enum : uint8_t { OUT_NONE, OUT_RING, OUT_PGM, OUT_TEXT } out_source;
+static uint8_t out_ports, out_len, out_pos;
+static PGM_P out_pgm;
+static char out_text[sizeof(long) * 8 + 2]; // Formatted number: a binary long, or a sign and a float
+
+FORCE_INLINE static ring_pos_t ring_free() { return RING_MASK - ((ring_head - ring_tail) & RING_MASK); }
+
+// The tail is only moved by task(), but it is read by writers in interrupts
+static void advance_tail(const ring_pos_t count) {
+  CRITICAL_SECTION_START;
+  ring_tail = (ring_tail + count) & RING_MASK;
+  CRITICAL_SECTION_END;
+}
+
+/**
+ * Ports addressed by serial_port_index, as a bit-mask
+ */
+static uint8_t current_ports() {
+  #if NUM_SERIAL > 1
+    return (!serial_port_index || serial_port_index == SERIAL_BOTH ? _BV(0) : 0) | (serial_port_index ? _BV(1) : 0);
+  #else
+    return _BV(0);
+  #endif
+}
+
+static uint8_t port_room(const uint8_t ports) {
+  uint8_t room = 0xFF;
+  if (TEST(ports, 0)) NOMORE(room, MYSERIAL0.availableForWrite());
+  #if NUM_SERIAL > 1
+    if (TEST(ports, 1)) NOMORE(room, MYSERIAL1.availableForWrite());
+  #endif
+  return room;
+}
+
+static void port_write(const uint8_t ports, const uint8_t c) {
+  if (TEST(ports, 0)) MYSERIAL0.write(c);
+  #if NUM_SERIAL > 1
+    if (TEST(ports, 1)) MYSERIAL1.write(c);
+  #endif
+}
+
+static uint8_t record_size(const uint8_t type) {
+  switch (type) {
+    case REC_CHAR:   return 2;
+    case REC_PGM:    return 1 + sizeof(PGM_P);
+    case REC_LONG:
+    case REC_ULONG:  return 2 + sizeof(long);
+    case REC_DOUBLE: return 2 + sizeof(double);
+  }
+  return 1;
+}
+
+static uint8_t format_number(char * const out, uint8_t len, unsigned long n, uint8_t base) {
+  if (base < 2) base = 10;
+  char digits[8 * sizeof(long)];
+  uint8_t i = 0;
+  do {
+    const uint8_t d = n % base;
+    digits[i++] = d < 10 ? '0' + d : 'A' + d - 10;
+    n /= base;
+  } while (n);
+  while (i) out[len++] = digits[--i];
+  return len;
+}
+
+// Same output as MarlinSerial::printFloat
+static uint8_t format_float(char * const out, double number, uint8_t digits) {
+  uint8_t len = 0;
+  NOMORE(digits, 10);
+  if (number < 0.0) { out[len++] = '-'; number = -number; }
+
+  double rounding = 0.5;
+  for (uint8_t i = 0; i < digits; ++i) rounding *= 0.1;
+  number += rounding;
+
+  const unsigned long int_part = (unsigned long)number;
+  double remainder = number - (double)int_part;
+  len = format_number(out, len, int_part, 10);
+
+  if (digits) {
+    out[len++] = '.';
+    while (digits--) {
+      remainder *= 10.0;
+      const uint8_t d = uint8_t(remainder);
+      out[len++] = '0' + d;
+      remainder -= d;
+    }
+  }
+  return len;
+}
+
+/**
+ * Convert a fixed-size record (other than REC_PGM) to text.
+ * Return the number of characters written to 'out'.
+ */
+static uint8_t format_record(const uint8_t * const rec, char * const out) {
+  switch (rec[0] & 0x0F) {
+    case REC_CHAR: out[0] = rec[1]; return 1;
+    case REC_LONG: {
+      long n; memcpy(&n, &rec[1], sizeof(n));
+      const uint8_t base = rec[1 + sizeof(n)];
+      if (base == 10 && n < 0) { out[0] = '-'; return format_number(out, 1, -n, 10); }
+      return format_number(out, 0, n, base);
+    }
+    case REC_ULONG: {
+      unsigned long n; memcpy(&n, &rec[1], sizeof(n));
+      return format_number(out, 0, n, rec[1 + sizeof(n)]);
+    }
+    case REC_DOUBLE: {
+      double n; memcpy(&n, &rec[1], sizeof(n));
+      return format_float(out, n, rec[1 + sizeof(n)]);
+    }
+  }
+  return 0;
+}
+
+/**
+ * Send queued output. Unless blocking, stop as soon as a port is full.
+ * Blocking is used to drain the buffer, and when interrupts are disabled.
+ */
+static void pump(const bool block) {
+  if (pumping) return;
+  pumping = true;
+
+  for (;;) {
+    if (out_source == OUT_NONE) {
+      if (ring_head == ring_tail) break;
+
+      // Start the next record
+      uint8_t rec[MAX_RECORD_SIZE];
+      rec[0] = ring[ring_tail];
+      out_ports = rec[0] >> 4;
+      const uint8_t type = rec[0] & 0x0F;
+      if (type == REC_TEXT) {
+        advance_tail(1);
+        out_source = OUT_RING;
+      }
+      else {
+        const uint8_t size = record_size(type);
+        for (uint8_t i = 1; i < size; i++) rec[i] = ring[(ring_tail + i) & RING_MASK];
+        advance_tail(size);
+        if (type == REC_PGM) {
+          memcpy(&out_pgm, &rec[1], sizeof(out_pgm));
+          out_source = OUT_PGM;
+        }
+        else {
+          out_len = format_record(rec, out_text);
+          out_pos = 0;
+          out_source = OUT_TEXT;
+        }
+      }
+    }
+
+    uint8_t room = block ? 0xFF : port_room(out_ports);
+    if (!room) break;
+
+    // Send characters until the record ends or the port is full
+    for (; room; --room) {
+      uint8_t c;
+      if (out_source == OUT_RING) {
+        c = ring[ring_tail];
+        advance_tail(1);
+        if (!c) break;
+      }
+      else if (out_source == OUT_PGM) {
+        c = pgm_read_byte(out_pgm++);
+        if (!c) break;
+      }
+      else {
+        if (out_pos >= out_len) break;
+        c = out_text[out_pos++];
+      }
+      port_write(out_ports, c);
+    }
+    if (room) out_source = OUT_NONE;
+  }
+
+  pumping = false;
+}
+
+/**
+ * Add a fixed-size record, waiting for room if needed.
+ * Return false if the caller should send the output directly instead.
+ */
+static bool enqueue(const uint8_t * const rec) {
+  const uint8_t size = record_size(rec[0] & 0x0F);
+  for (;;) {
+    bool done = false;
+    {
+      CRITICAL_SECTION_START;
+      if (ring_free() >= size) {
+        for (uint8_t i = 0; i < size; i++) ring[(ring_head + i) & RING_MASK] = rec[i];
+        ring_head = (ring_head + size) & RING_MASK;
+        text_open = false;
+        done = true;
+      }
+      CRITICAL_SECTION_END;
+    }
+    if (done) return true;
+    if (pumping) return false; // Output from an interrupt while sending
+    pump(!ISRS_ENABLED());
+  }
+}
+
+/**
+ * Add a character to the newest text record or start a new one.
+ * Return false if the caller should send the character directly instead.
+ */
+static bool enqueue_text(const uint8_t ports, const char c) {
+  for (;;) {
+    bool done = false;
+    {
+      CRITICAL_SECTION_START;
+      const ring_pos_t h = ring_head;
+      if (text_open && text_ports == ports && h != ring_tail && !pumping) {
+        // Replace the terminator and add a new one
+        if (ring_free() >= 1) {
+          ring[(h - 1) & RING_MASK] = c;
+          ring[h] = '\0';
+          ring_head = (h + 1) & RING_MASK;
+          done = true;
+        }
+      }
+      else if (ring_free() >= 3) {
+        ring[h] = REC_TEXT | (ports << 4);
+        ring[(h + 1) & RING_MASK] = c;
+        ring[(h + 2) & RING_MASK] = '\0';
+        ring_head = (h + 3) & RING_MASK;
+        text_open = true;
+        text_ports = ports;
+        done = true;
+      }
+      CRITICAL_SECTION_END;
+    }
+    if (done) return true;
+    if (pumping) return false; // Output from an interrupt while sending
+    pump(!ISRS_ENABLED());
+  }
+}
+
+static void write_direct(const uint8_t * const rec) {
+  char text[sizeof(out_text)];
+  const uint8_t ports = rec[0] >> 4, len = format_record(rec, text);
+  for (uint8_t i = 0; i < len; i++) port_write(ports, text[i]);
+}
+
+void DeferredSerial::write(const uint8_t c) {
+  const uint8_t ports = current_ports();
+  if (c) {
+    if (!enqueue_text(ports, c)) port_write(ports, c);
+  }
+  else {
+    const uint8_t rec[2] = { uint8_t(REC_CHAR | (ports << 4)), c };
+    if (!enqueue(rec)) write_direct(rec);
+  }
+  task();
+}
+
+void DeferredSerial::print(const char *str) {
+  const uint8_t ports = current_ports();
+  while (const char c = *str++)
+    if (!enqueue_text(ports, c)) port_write(ports, c);
+  task();
+}
+
+void DeferredSerial::print_P(PGM_P str) {
+  uint8_t rec[1 + sizeof(PGM_P)] = { uint8_t(REC_PGM | (current_ports() << 4)) };
+  memcpy(&rec[1], &str, sizeof(str));
+  if (!enqueue(rec)) while (const char c = pgm_read_byte(str++)) port_write(rec[0] >> 4, c);
+  task();
+}
+
+void DeferredSerial::print(long n, int base) {
+  if (base == 0) return write(n);
+  uint8_t rec[2 + sizeof(n)] = { uint8_t(REC_LONG | (current_ports() << 4)) };
+  memcpy(&rec[1], &n, sizeof(n));
+  rec[1 + sizeof(n)] = base;
+  if (!enqueue(rec)) write_direct(rec);
+  task();
+}
+
+void DeferredSerial::print(unsigned long n, int base) {
+  if (base == 0) return write(n);
+  uint8_t rec[2 + sizeof(n)] = { uint8_t(REC_ULONG | (current_ports() << 4)) };
+  memcpy(&rec[1], &n, sizeof(n));
+  rec[1 + sizeof(n)] = base;
+  if (!enqueue(rec)) write_direct(rec);
+  task();
+}
+
+void DeferredSerial::print(double n, int digits) {
+  uint8_t rec[2 + sizeof(n)] = { uint8_t(REC_DOUBLE | (current_ports() << 4)) };
+  memcpy(&rec[1], &n, sizeof(n));
+  rec[1 + sizeof(n)] = digits;
+  if (!enqueue(rec)) write_direct(rec);
+  task();
+}
+
+void DeferredSerial::printf(const char *format, ...) {
+  char buffer[128];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(buffer, sizeof(buffer), format, args);
+  va_end(args);
+  print(buffer);
+}
+
+void DeferredSerial::flush() { SERIAL_PORT_OUT(flush); }
+
+void DeferredSerial::flushTX() {
+  pump(true);
+  SERIAL_PORT_OUT(flushTX);
+}
+
+void DeferredSerial::task() { pump(!ISRS_ENABLED()); }
+
+#endif // DEFERRED_SERIAL_OUTPUT
@@ -0,0 +1,73 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * deferred_serial.h - Non-blocking serial output
+ *
+ * Output is stored as compact records (text, PROGMEM pointers, raw numbers)
+ * in a ring buffer and formatted only as the port's TX buffer has room.
+ * The buffer is pumped by task(), called from idle() and after each record.
+ * Callers only block if the record buffer itself is full, waiting for the
+ * port to send enough to make room. DEFERRED_SERIAL_BUFFER_SIZE sets how
+ * much output can be queued before that happens.
+ */
+
+#include "../inc/MarlinConfigPre.h"
+
+class DeferredSerial {
+  public:
+    static void write(const uint8_t c);
+    static void print(const char *str);
+    static void print_P(PGM_P str);
+
+    static void print(char c, int base=0)             { print((long)c, base); }
+    static void print(unsigned char c, int base=0)    { print((unsigned long)c, base); }
+    static void print(int n, int base=10)             { print((long)n, base); }
+    static void print(unsigned int n, int base=10)    { print((unsigned long)n, base); }
+    static void print(long n, int base=10);
+    static void print(unsigned long n, int base=10);
+    static void print(double n, int digits=2);
+
+    static void println()                             { write('\n'); }
+    static void println(const char *str)              { print(str); println(); }
+    static void println(char c, int base=0)           { print(c, base); println(); }
+    static void println(unsigned char c, int base=0)  { print(c, base); println(); }
+    static void println(int n, int base=10)           { print(n, base); println(); }
+    static void println(unsigned int n, int base=10)  { print(n, base); println(); }
+    static void println(long n, int base=10)          { print(n, base); println(); }
+    static void println(unsigned long n, int base=10) { print(n, base); println(); }
+    static void println(double n, int digits=2)       { print(n, digits); println(); }
+
+    static void printf(const char *format, ...);
+
+    // Flush the receive buffer(s) of the current port
+    static void flush();
+
+    // Send all queued output and wait for the port(s) to finish
+    static void flushTX();
+
+    // Send as much queued output as the port(s) can take without blocking
+    static void task();
+};
+
+extern DeferredSerial deferred_serial;
@@ -231,6 +231,7 @@
 #define MSG_SD_NOT_PRINTING                 "Not SD printing"
 #define MSG_SD_ERR_WRITE_TO_FILE            "error writing to file"
 #define MSG_SD_ERR_READ                     "SD read error"
+#define MSG_SD_ERR_SEEK                     "SD seek error"
 #define MSG_SD_CANT_ENTER_SUBDIR            "Cannot enter subdir: "
 
 #define MSG_STEPPER_TOO_HIGH                "Steprate too high: "
@@ -262,6 +263,8 @@
 #define MSG_PID_AUTOTUNE_FAILED             MSG_PID_AUTOTUNE " failed!"
 #define MSG_PID_BAD_EXTRUDER_NUM            MSG_PID_AUTOTUNE_FAILED " Bad extruder number"
 #define MSG_PID_TEMP_TOO_HIGH               MSG_PID_AUTOTUNE_FAILED " Temperature too high"
+#define MSG_PID_TEMP_TOO_LOW                MSG_PID_AUTOTUNE_FAILED " Temperature too low"
+#define MSG_PID_NO_MODEL                    MSG_PID_AUTOTUNE_FAILED " No model fit"
 #define MSG_PID_TIMEOUT                     MSG_PID_AUTOTUNE_FAILED " timeout"
 #define MSG_BIAS                            " bias: "
 #define MSG_D                               " d: "
@@ -269,6 +272,9 @@
 #define MSG_T_MAX                           " max: "
 #define MSG_KU                              " Ku: "
 #define MSG_TU                              " Tu: "
+#define MSG_MODEL_K                         " K: "
+#define MSG_MODEL_TAU                       " tau: "
+#define MSG_MODEL_L                         " L: "
 #define MSG_CLASSIC_PID                     " Classic PID "
 #define MSG_KP                              " Kp: "
 #define MSG_KI                              " Ki: "
@@ -32,8 +32,21 @@ static const char echomagic[]  PROGMEM = "echo:";
   int8_t serial_port_index = SERIAL_PORT;
 #endif
 
+#if ENABLED(BINARY_TELEMETRY)
+  SerialLineTracker serial_line;
+  bool SerialLineTracker::line_open; // = false
+#endif
+
 void serialprintPGM(PGM_P str) {
-  while (const char c = pgm_read_byte(str++)) SERIAL_CHAR(c);
+  #if ENABLED(DEFERRED_SERIAL_OUTPUT)
+    deferred_serial.print_P(str);
+    #if ENABLED(BINARY_TELEMETRY)
+      const size_t len = strlen_P(str);
+      if (len) serial_line.line_open = pgm_read_byte(&str[len - 1]) != '\n';
+    #endif
+  #else
+    while (const char c = pgm_read_byte(str++)) SERIAL_CHAR(c);
+  #endif
 }
 void serial_echo_start()  { serialprintPGM(echomagic); }
 void serial_error_start() { serialprintPGM(errormagic); }
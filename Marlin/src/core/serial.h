@@ -47,14 +47,62 @@ extern uint8_t marlin_debug_flags;
   extern int8_t serial_port_index;
   #define _PORT_REDIRECT(n,p)   REMEMBER(n,serial_port_index,p)
   #define _PORT_RESTORE(n)      RESTORE(n)
-  #define SERIAL_OUT(WHAT, ...) do{ \
+  #define SERIAL_PORT_OUT(WHAT, ...) do{ \
     if (!serial_port_index || serial_port_index == SERIAL_BOTH) MYSERIAL0.WHAT(__VA_ARGS__); \
     if ( serial_port_index) MYSERIAL1.WHAT(__VA_ARGS__); \
   }while(0)
 #else
   #define _PORT_REDIRECT(n,p)   NOOP
   #define _PORT_RESTORE(n)      NOOP
-  #define SERIAL_OUT(WHAT, ...) MYSERIAL0.WHAT(__VA_ARGS__)
+  #define SERIAL_PORT_OUT(WHAT, ...) MYSERIAL0.WHAT(__VA_ARGS__)
+#endif
+
+#if ENABLED(DEFERRED_SERIAL_OUTPUT)
+  #include "deferred_serial.h"
+  #define _SERIAL_OUT(WHAT, ...) deferred_serial.WHAT(__VA_ARGS__)
+#else
+  #define _SERIAL_OUT(WHAT, ...) SERIAL_PORT_OUT(WHAT, __VA_ARGS__)
+#endif
+
+#if ENABLED(BINARY_TELEMETRY)
+
+  /**
+   * Pass output through, noting whether it left a line unfinished.
+   * Binary telemetry frames are only sent between lines of text.
+   */
+  class SerialLineTracker {
+    public:
+      static bool line_open;
+
+      static void write(const uint8_t c)                          { _SERIAL_OUT(write, c); line_open = c != '\n'; }
+      static void print(const char *str)                          { _SERIAL_OUT(print, str); if (*str) line_open = str[strlen(str) - 1] != '\n'; }
+      static void print(char *str)                                { print((const char*)str); }
+      static void print(char c, int base=0)                       { _SERIAL_OUT(print, c, base); line_open = base || c != '\n'; }
+      static void print(unsigned char c, int base=0)              { _SERIAL_OUT(print, c, base); line_open = base || c != '\n'; }
+      template<typename T> static void print(const T v)           { _SERIAL_OUT(print, v); line_open = true; }
+      template<typename T> static void print(const T v, int b)    { _SERIAL_OUT(print, v, b); line_open = true; }
+      static void println()                                       { _SERIAL_OUT(println); line_open = false; }
+      template<typename T> static void println(const T v)         { _SERIAL_OUT(println, v); line_open = false; }
+      template<typename T> static void println(const T v, int b)  { _SERIAL_OUT(println, v, b); line_open = false; }
+      template<typename... Args> static void printf(const char *format, Args... args) {
+        _SERIAL_OUT(printf, format, args...);
+        if (*format) line_open = format[strlen(format) - 1] != '\n';
+      }
+      static void flush()                                         { _SERIAL_OUT(flush); }
+      static void flushTX()                                       { _SERIAL_OUT(flushTX); }
+
+      // Send a byte of a binary frame, leaving the line state as it was
+      static void write_binary(const uint8_t c)                   { _SERIAL_OUT(write, c); }
+  };
+
+  extern SerialLineTracker serial_line;
+
+  #define SERIAL_OUT(WHAT, ...) serial_line.WHAT(__VA_ARGS__)
+
+#else
+
+  #define SERIAL_OUT(WHAT, ...) _SERIAL_OUT(WHAT, __VA_ARGS__)
+
 #endif
 
 #define PORT_REDIRECT(p)        _PORT_REDIRECT(1,p)
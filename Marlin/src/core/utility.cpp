@@ -35,18 +35,26 @@ void safe_delay(millis_t ms) {
   thermalManager.manage_heater(); // This keeps us safe if too many small safe_delay() calls are made
 }
 
-#if ENABLED(EEPROM_SETTINGS) || ENABLED(SD_FIRMWARE_UPDATE)
+#if ENABLED(EEPROM_SETTINGS) || ENABLED(SD_FIRMWARE_UPDATE) || ENABLED(BINARY_TELEMETRY) || ENABLED(POWER_LOSS_JOURNAL) || ENABLED(EXTENSIBLE_UI)
+
+  // CRC-16 (polynomial 0x1021) of each nibble, so a byte takes two lookups instead of eight shifts
+  static const uint16_t crc16_table[16] PROGMEM = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+  };
 
   void crc16(uint16_t *crc, const void * const data, uint16_t cnt) {
-    uint8_t *ptr = (uint8_t *)data;
+    const uint8_t *ptr = (const uint8_t *)data;
+    uint16_t c = *crc;
     while (cnt--) {
-      *crc = (uint16_t)(*crc ^ (uint16_t)(((uint16_t)*ptr++) << 8));
-      for (uint8_t i = 0; i < 8; i++)
-        *crc = (uint16_t)((*crc & 0x8000) ? ((uint16_t)(*crc << 1) ^ 0x1021) : (*crc << 1));
+      const uint8_t b = *ptr++;
+      c = (c << 4) ^ pgm_read_word(&crc16_table[(c >> 12) ^ (b >> 4)]);
+      c = (c << 4) ^ pgm_read_word(&crc16_table[(c >> 12) ^ (b & 0x0F)]);
     }
+    *crc = c;
   }
 
-#endif // EEPROM_SETTINGS || SD_FIRMWARE_UPDATE
+#endif // EEPROM_SETTINGS || SD_FIRMWARE_UPDATE || BINARY_TELEMETRY || POWER_LOSS_JOURNAL || EXTENSIBLE_UI
 
 #if ENABLED(ULTRA_LCD) || ENABLED(DEBUG_LEVELING_FEATURE) || ENABLED(EXTENSIBLE_UI)
 
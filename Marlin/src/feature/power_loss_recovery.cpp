@@ -36,6 +36,10 @@ bool PrintJobRecovery::enabled; // Initialized by settings.load()
 SdFile PrintJobRecovery::file;
 job_recovery_info_t PrintJobRecovery::info;
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+  uint8_t PrintJobRecovery::journal_count; // = 0
+#endif
+
 #include "../sd/cardreader.h"
 #include "../lcd/ultralcd.h"
 #include "../gcode/queue.h"
@@ -46,6 +50,10 @@ job_recovery_info_t PrintJobRecovery::info;
 #include "../module/temperature.h"
 #include "../core/serial.h"
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+  #include "../core/utility.h"
+#endif
+
 #if ENABLED(FWRETRACT)
   #include "fwretract.h"
 #endif
@@ -108,6 +116,9 @@ void PrintJobRecovery::load() {
   if (exists()) {
     open(true);
     (void)file.read(&info, sizeof(info));
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      if (valid()) replay();
+    #endif
     close();
   }
   #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
@@ -125,8 +136,16 @@ void PrintJobRecovery::save(const bool force/*=false*/, const bool save_queue/*=
     millis_t ms = millis();
   #endif
 
+  #if ENABLED(POWER_LOSS_JOURNAL)
+    static float saved_z; // = 0 (Z of the last checkpoint or record)
+  #else
+    const float &saved_z = info.current_position[Z_AXIS];
+  #endif
+
   if (force
-    #if DISABLED(SAVE_EACH_CMD_MODE)      // Always save state when enabled
+    #if ENABLED(SAVE_EACH_CMD_MODE)       // Always save state when enabled
+      || true
+    #else
       #if PIN_EXISTS(POWER_LOSS)          // Save if power loss pin is triggered
         || READ(POWER_LOSS_PIN) == POWER_LOSS_STATE
       #endif
@@ -134,7 +153,7 @@ void PrintJobRecovery::save(const bool force/*=false*/, const bool save_queue/*=
         || ELAPSED(ms, next_save_ms)
       #endif
       // Save every time Z is higher than the last call
-      || current_position[Z_AXIS] > info.current_position[Z_AXIS]
+      || current_position[Z_AXIS] > saved_z
     #endif
   ) {
 
@@ -142,6 +161,13 @@ void PrintJobRecovery::save(const bool force/*=false*/, const bool save_queue/*=
       next_save_ms = ms + SAVE_INFO_INTERVAL_MS;
     #endif
 
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      saved_z = current_position[Z_AXIS];
+      // Append a record until the journal is full or a checkpoint is needed
+      if (!force && file.isOpen() && journal_count < POWER_LOSS_JOURNAL_SIZE && !state_changed())
+        return append();
+    #endif
+
     // Set Head and Foot to matching non-zero values
     if (!++info.valid_head) ++info.valid_head; // non-zero in sequence
     //if (!IS_SD_PRINTING()) info.valid_head = 0;
@@ -197,6 +223,11 @@ void PrintJobRecovery::save(const bool force/*=false*/, const bool save_queue/*=
     card.getAbsFilename(info.sd_filename);
     info.sdpos = card.getIndex();
 
+    // Records resume counting from the last one written
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      if (file.isOpen()) info.journal_sequence += journal_count;
+    #endif
+
     write();
 
     // KILL now if the power-loss pin was triggered
@@ -217,7 +248,18 @@ void PrintJobRecovery::write() {
 
   open(false);
   file.seekSet(0);
-  const int16_t ret = file.write(&info, sizeof(info));
+  int16_t ret = file.write(&info, sizeof(info));
+
+  #if ENABLED(POWER_LOSS_JOURNAL)
+    // Zero the journal space of a new file so no stale data can pass for a record
+    if (ret != -1) {
+      const job_recovery_record_t blank = {};
+      while (ret != -1 && file.fileSize() < sizeof(info) + sizeof(blank) * (POWER_LOSS_JOURNAL_SIZE))
+        ret = file.write(&blank, sizeof(blank));
+    }
+    journal_count = 0;
+  #endif
+
   #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
     if (ret == -1) SERIAL_ECHOLNPGM("Power-loss file write failed.");
   #else
@@ -225,6 +267,94 @@ void PrintJobRecovery::write() {
   #endif
 }
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+
+  /**
+   * A checkpoint is needed when state kept only in the checkpoint changes
+   */
+  bool PrintJobRecovery::state_changed() {
+    #if HOTENDS > 1
+      if (info.active_hotend != active_extruder) return true;
+    #endif
+    if (memcmp(info.target_temperature, thermalManager.target_temperature, sizeof(info.target_temperature))) return true;
+    #if HAS_HEATED_BED
+      if (info.target_temperature_bed != thermalManager.target_temperature_bed) return true;
+    #endif
+    #if FAN_COUNT
+      if (memcmp(info.fan_speed, thermalManager.fan_speed, sizeof(info.fan_speed))) return true;
+    #endif
+    #if HAS_LEVELING
+      if (info.leveling != planner.leveling_active) return true;
+      #if ENABLED(ENABLE_LEVELING_FADE_HEIGHT)
+        if (info.fade != planner.z_fade_height) return true;
+      #endif
+    #endif
+    #if ENABLED(GRADIENT_MIX)
+      if (memcmp(&info.gradient, &mixer.gradient, sizeof(info.gradient))) return true;
+    #endif
+    #if ENABLED(FWRETRACT)
+      if (memcmp(info.retract, fwretract.current_retract, sizeof(info.retract)) || info.retract_hop != fwretract.current_hop) return true;
+    #endif
+    return false;
+  }
+
+  /**
+   * Write a record for the command just run into the next journal slot.
+   * The slot lies within the file, so only its data block is written.
+   */
+  void PrintJobRecovery::append() {
+    // Resume from the command just run, as the checkpoint replays its queue from there.
+    // A command that didn't come from the file (serial, injected) has no place to resume
+    // from, so the last record stands until the next command from the file.
+    const uint32_t sdpos = commands_in_queue ? command_queue_sdpos[cmd_queue_index_r] : card.getIndex();
+    if (sdpos != NO_SDPOS) {
+      job_recovery_record_t rec;
+      rec.sequence = info.journal_sequence + journal_count + 1;
+      COPY(rec.current_position, current_position);
+      rec.sdpos = sdpos;
+      rec.print_job_elapsed = print_job_timer.duration();
+      rec.feedrate = uint16_t(feedrate_mm_s * 60.0f);
+      rec.crc = 0;
+      crc16(&rec.crc, &rec, offsetof(job_recovery_record_t, crc));
+
+      file.seekSet(sizeof(info) + sizeof(rec) * journal_count);
+      if (file.write(&rec, sizeof(rec)) == sizeof(rec))
+        journal_count++;
+      #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
+        else
+          SERIAL_ECHOLNPGM("Power-loss journal write failed.");
+      #endif
+    }
+
+    // KILL now if the power-loss pin was triggered
+    #if PIN_EXISTS(POWER_LOSS)
+      if (READ(POWER_LOSS_PIN) == POWER_LOSS_STATE) kill(PSTR(MSG_OUTAGE_RECOVERY));
+    #endif
+  }
+
+  /**
+   * Apply the journal records that follow the loaded checkpoint,
+   * stopping at the first record that is stale or torn.
+   */
+  void PrintJobRecovery::replay() {
+    job_recovery_record_t rec;
+    uint32_t sequence = info.journal_sequence;
+    while (file.read(&rec, sizeof(rec)) == sizeof(rec) && rec.sequence == sequence + 1) {
+      uint16_t crc = 0;
+      crc16(&crc, &rec, offsetof(job_recovery_record_t, crc));
+      if (crc != rec.crc) break;
+      sequence++;
+      COPY(info.current_position, rec.current_position);
+      info.sdpos = rec.sdpos;
+      info.print_job_elapsed = rec.print_job_elapsed;
+      info.feedrate = rec.feedrate;
+      info.commands_in_queue = 0; // The file is read again from the record's command
+    }
+    info.journal_sequence = sequence;
+  }
+
+#endif // POWER_LOSS_JOURNAL
+
 /**
  * Resume the saved print job
  */
@@ -412,6 +542,9 @@ void PrintJobRecovery::resume() {
         SERIAL_ECHOLNPAIR("sd_filename: ", info.sd_filename);
         SERIAL_ECHOLNPAIR("sdpos: ", info.sdpos);
         SERIAL_ECHOLNPAIR("print_job_elapsed: ", info.print_job_elapsed);
+        #if ENABLED(POWER_LOSS_JOURNAL)
+          SERIAL_ECHOLNPAIR("journal_sequence: ", info.journal_sequence);
+        #endif
       }
       else
         SERIAL_ECHOLNPGM("INVALID DATA");
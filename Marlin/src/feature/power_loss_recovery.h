@@ -87,10 +87,32 @@ typedef struct {
   // Job elapsed time
   millis_t print_job_elapsed;
 
+  #if ENABLED(POWER_LOSS_JOURNAL)
+    uint32_t journal_sequence;  // Sequence number of the checkpoint
+  #endif
+
   uint8_t valid_foot;
 
 } job_recovery_info_t;
 
+#if ENABLED(POWER_LOSS_JOURNAL)
+
+  /**
+   * Journal records follow the checkpoint in the recovery file. A record
+   * is valid when its sequence number follows the checkpoint (or the prior
+   * record) and its CRC matches, so stale and torn records end the replay.
+   */
+  typedef struct {
+    uint32_t sequence;
+    float current_position[XYZE];
+    uint32_t sdpos;
+    millis_t print_job_elapsed;
+    uint16_t feedrate;
+    uint16_t crc;
+  } job_recovery_record_t;
+
+#endif
+
 class PrintJobRecovery {
   public:
     static SdFile file;
@@ -111,14 +133,7 @@ class PrintJobRecovery {
 
     static void purge();
     static void load();
-    static void save(const bool force=
-      #if ENABLED(SAVE_EACH_CMD_MODE)
-        true
-      #else
-        false
-      #endif
-      , const bool save_queue=true
-    );
+    static void save(const bool force=false, const bool save_queue=true);
 
   static inline bool valid() { return info.valid_head && info.valid_head == info.valid_foot; }
 
@@ -128,6 +143,13 @@ class PrintJobRecovery {
 
   private:
     static void write();
+
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      static uint8_t journal_count;
+      static bool state_changed();
+      static void append();
+      static void replay();
+    #endif
 };
 
 extern PrintJobRecovery recovery;
@@ -0,0 +1,152 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(BINARY_TELEMETRY)
+
+#include "telemetry.h"
+#include "../core/utility.h"
+#include "../module/motion.h"
+#include "../module/planner.h"
+#include "../module/temperature.h"
+#include "../module/printcounter.h"
+#include "../sd/cardreader.h"
+
+Telemetry telemetry;
+
+#define TELEMETRY_SYNC 0xA5
+
+uint16_t Telemetry::interval_ms[TELEMETRY_CHANNELS]; // = { 0 }
+millis_t Telemetry::next_report_ms[TELEMETRY_CHANNELS];
+uint8_t Telemetry::sequence;
+
+#if NUM_SERIAL > 1
+  int8_t Telemetry::port = SERIAL_BOTH;
+#endif
+
+static const char channel_id[TELEMETRY_CHANNELS] PROGMEM = { 'T', 'P', 'S' };
+
+/**
+ * Frames are assembled here, payload first, then the header and CRC
+ */
+#define THERMAL_PAYLOAD_SIZE (2 + 6 * (HOTENDS + 1) + FAN_COUNT)
+#define POSITION_PAYLOAD_SIZE (4 * XYZE + 4 + 2 + 2 + 2)
+static uint8_t frame[8 + MAX(THERMAL_PAYLOAD_SIZE, POSITION_PAYLOAD_SIZE) + 2], frame_len;
+
+static void put(const void * const data, const uint8_t size) {
+  memcpy(&frame[frame_len], data, size);
+  frame_len += size;
+}
+template<typename T> inline void put(const T value) { put(&value, sizeof(T)); }
+
+#if HAS_TEMP_SENSOR
+  static void put_heater(const uint8_t id, const float temp, const int16_t target, const int power) {
+    frame[8]++;                             // Count of heaters
+    put(id);
+    put(int16_t(temp * 10));
+    put(int16_t(target * 10));
+    put(uint8_t(power));
+  }
+#endif
+
+void Telemetry::set_interval(const TelemetryChannel ch, uint16_t ms) {
+  if (ms) NOLESS(ms, TELEMETRY_MIN_INTERVAL);
+  interval_ms[ch] = ms;
+  next_report_ms[ch] = millis() + ms;
+}
+
+void Telemetry::report() {
+  if (serial_line.line_open) return; // Wait for the end of the line
+  const millis_t ms = millis();
+  for (uint8_t ch = 0; ch < TELEMETRY_CHANNELS; ch++)
+    if (interval_ms[ch] && ELAPSED(ms, next_report_ms[ch])) {
+      next_report_ms[ch] = ms + interval_ms[ch];
+      send((TelemetryChannel)ch);
+    }
+}
+
+void Telemetry::send(const TelemetryChannel ch) {
+  frame_len = 8;
+
+  switch (ch) {
+    case TELEMETRY_THERMAL:
+      put(uint8_t(0));
+      #if HAS_TEMP_SENSOR
+        HOTEND_LOOP() put_heater(e, thermalManager.degHotend(e), thermalManager.degTargetHotend(e), thermalManager.getHeaterPower(e));
+        #if HAS_HEATED_BED
+          put_heater(0x80, thermalManager.degBed(), thermalManager.degTargetBed(), thermalManager.getHeaterPower(-1));
+        #endif
+      #endif
+      put(uint8_t(FAN_COUNT));
+      #if FAN_COUNT > 0
+        put(thermalManager.fan_speed, FAN_COUNT);
+      #endif
+      break;
+
+    case TELEMETRY_POSITION:
+      put(current_position, sizeof(float) * XYZE);
+      put(feedrate_mm_s);
+      put(feedrate_percentage);
+      put(planner.flow_percentage[active_extruder]);
+      put(planner.movesplanned());
+      put(uint8_t(BLOCK_BUFFER_SIZE));
+      break;
+
+    case TELEMETRY_STATUS:
+      put(uint8_t(
+          (print_job_timer.isRunning() ? _BV(0) : 0)
+        | (print_job_timer.isPaused()  ? _BV(1) : 0)
+        | (IS_SD_PRINTING()            ? _BV(2) : 0)
+      ));
+      put(uint8_t(
+        #if ENABLED(SDSUPPORT)
+          card.percentDone()
+        #else
+          0
+        #endif
+      ));
+      put(uint32_t(print_job_timer.duration()));
+      put(active_extruder);
+      break;
+
+    default: return;
+  }
+
+  frame[0] = TELEMETRY_SYNC;
+  frame[1] = pgm_read_byte(&channel_id[ch]);
+  frame[2] = sequence++;
+  frame[3] = frame_len - 8;
+  const uint32_t now = millis();
+  memcpy(&frame[4], &now, sizeof(now));
+
+  uint16_t crc = 0;
+  crc16(&crc, &frame[1], frame_len - 1);
+  put(crc);
+
+  #if NUM_SERIAL > 1
+    PORT_REDIRECT(port);
+  #endif
+  for (uint8_t i = 0; i < frame_len; i++) serial_line.write_binary(frame[i]);
+}
+
+#endif // BINARY_TELEMETRY
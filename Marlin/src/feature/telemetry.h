@@ -0,0 +1,87 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * telemetry.h - Binary telemetry frames, multiplexed with the text output
+ *
+ * Frames are only sent at the start of a line, never inside one. Text
+ * lines start with ASCII or a UTF-8 lead byte, never with 0xA5, so 0xA5
+ * at the start of a line always begins a frame. The text that follows a
+ * frame starts a new line. A host that reads a frame with a bad CRC, for
+ * instance after dropped bytes, treats the 0xA5 as text and reads on to
+ * the next line.
+ *
+ * Frame layout (multi-byte values are little-endian):
+ *
+ *   0xA5          Start of frame
+ *   uint8_t       Channel: 'T'hermal, 'P'osition, or 'S'tatus
+ *   uint8_t       Sequence number, counting all frames
+ *   uint8_t       Payload length
+ *   uint32_t      millis() at the time of the report
+ *   payload
+ *   uint16_t      CRC-16/XMODEM of everything after the start byte
+ *
+ * 'T' payload: uint8_t count, then per heater
+ *                uint8_t id (hotend index, or 0x80 for the bed),
+ *                int16_t temperature, int16_t target (both in 0.1°C),
+ *                uint8_t power (0-255);
+ *              then uint8_t fan count and a uint8_t speed per fan
+ * 'P' payload: float X, Y, Z, E (mm, as in M114), float feedrate (mm/s),
+ *              int16_t feedrate %, int16_t flow %,
+ *              uint8_t planned moves, uint8_t planner buffer size
+ * 'S' payload: uint8_t flags (bit 0: job running, 1: job paused,
+ *              2: SD printing), uint8_t progress (%), uint32_t job time (s),
+ *              uint8_t active extruder
+ */
+
+#include "../inc/MarlinConfig.h"
+
+enum TelemetryChannel : uint8_t {
+  TELEMETRY_THERMAL,
+  TELEMETRY_POSITION,
+  TELEMETRY_STATUS,
+  TELEMETRY_CHANNELS
+};
+
+class Telemetry {
+  public:
+    static uint16_t interval_ms[TELEMETRY_CHANNELS];  // 0 = Off
+
+    #if NUM_SERIAL > 1
+      static int8_t port;                             // Port to send frames on
+    #endif
+
+    static void set_interval(const TelemetryChannel ch, uint16_t ms);
+
+    // Send due frames. Called from idle().
+    static void report();
+
+    // Send a frame right now
+    static void send(const TelemetryChannel ch);
+
+  private:
+    static millis_t next_report_ms[TELEMETRY_CHANNELS];
+    static uint8_t sequence;
+};
+
+extern Telemetry telemetry;
@@ -0,0 +1,182 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(THERMAL_HISTORY)
+
+#include "thermal_history.h"
+#include "../module/temperature.h"
+
+ThermalHistory thermal_history;
+
+#define THERMAL_HISTORY_MIN_INTERVAL 200 // (ms) Temperatures are measured every ~164ms
+
+uint16_t ThermalHistory::interval_ms = THERMAL_HISTORY_INTERVAL,
+         ThermalHistory::samples; // = 0
+uint8_t ThermalHistory::buffer[THERMAL_HISTORY_SIZE];
+uint16_t ThermalHistory::tail, ThermalHistory::used;
+uint32_t ThermalHistory::span;
+int16_t ThermalHistory::first[THERMAL_HISTORY_VALUES],
+        ThermalHistory::last[THERMAL_HISTORY_VALUES];
+millis_t ThermalHistory::next_sample_ms;
+
+void ThermalHistory::set_interval(uint16_t ms) {
+  if (ms) NOLESS(ms, THERMAL_HISTORY_MIN_INTERVAL);
+  interval_ms = ms;
+  clear();
+}
+
+void ThermalHistory::clear() {
+  samples = tail = used = 0;
+  span = 0;
+  next_sample_ms = millis();
+}
+
+void ThermalHistory::take_sample(int16_t (&v)[THERMAL_HISTORY_VALUES]) {
+  uint8_t n = 0;
+  HOTEND_LOOP() {
+    v[n++] = int16_t(thermalManager.degHotend(e) * 10);
+    v[n++] = thermalManager.degTargetHotend(e);
+    v[n++] = thermalManager.getHeaterPower(e);
+  }
+  #if HAS_HEATED_BED
+    v[n++] = int16_t(thermalManager.degBed() * 10);
+    v[n++] = thermalManager.degTargetBed();
+    v[n++] = thermalManager.getHeaterPower(-1);
+  #endif
+}
+
+/**
+ * Apply the changes stored at index i to the values in v, get the
+ * intervals since the sample before, and return the index of the next
+ */
+uint16_t ThermalHistory::decode(uint16_t i, int16_t (&v)[THERMAL_HISTORY_VALUES], uint8_t &intervals) {
+  intervals = at(i++);
+  uint8_t mask[THERMAL_HISTORY_MASK_SIZE];
+  for (uint8_t m = 0; m < THERMAL_HISTORY_MASK_SIZE; m++) mask[m] = at(i++);
+  for (uint8_t n = 0; n < THERMAL_HISTORY_VALUES; n++) if (TEST(mask[n >> 3], n & 7)) {
+    const int8_t d = at(i++);
+    if (d == -128) {
+      v[n] = at(i) | (at(i + 1) << 8);
+      i += 2;
+    }
+    else
+      v[n] += d;
+  }
+  return i % (THERMAL_HISTORY_SIZE);
+}
+
+void ThermalHistory::update() {
+  if (!interval_ms) return;
+  const millis_t ms = millis();
+  if (PENDING(ms, next_sample_ms)) return;
+  // Keep to the schedule, though samples wait for a new measurement.
+  // Skip the intervals missed while busy, and count them in this sample.
+  const uint32_t intervals = (ms - next_sample_ms) / interval_ms + 1;
+  next_sample_ms += intervals * interval_ms;
+
+  int16_t v[THERMAL_HISTORY_VALUES];
+  take_sample(v);
+
+  // The oldest sample is kept whole
+  if (!samples) {
+    COPY(first, v);
+    COPY(last, v);
+    samples = 1;
+    return;
+  }
+
+  // Encode the changes since the last sample
+  uint8_t rec[THERMAL_HISTORY_MAX_SAMPLE], len = 1 + THERMAL_HISTORY_MASK_SIZE;
+  ZERO(rec);
+  rec[0] = MIN(intervals, 255U);
+  for (uint8_t n = 0; n < THERMAL_HISTORY_VALUES; n++) {
+    const int32_t d = v[n] - last[n];
+    if (!d) continue;
+    SBI(rec[1 + (n >> 3)], n & 7);
+    if (WITHIN(d, -127, 127))
+      rec[len++] = uint8_t(d);
+    else {
+      rec[len++] = 0x80;
+      rec[len++] = v[n] & 0xFF;
+      rec[len++] = v[n] >> 8;
+    }
+  }
+  COPY(last, v);
+
+  // Make room by folding the oldest changes into the first sample
+  while (used + len > THERMAL_HISTORY_SIZE) {
+    uint8_t dropped;
+    const uint16_t next = decode(tail, first, dropped);
+    used -= (next + THERMAL_HISTORY_SIZE - tail) % (THERMAL_HISTORY_SIZE);
+    tail = next;
+    span -= dropped;
+    samples--;
+  }
+
+  for (uint8_t j = 0; j < len; j++) buffer[(tail + used + j) % (THERMAL_HISTORY_SIZE)] = rec[j];
+  used += len;
+  span += rec[0];
+  samples++;
+}
+
+void ThermalHistory::report() {
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR("Thermal history: ", samples);
+  SERIAL_ECHOPAIR(" samples every ", interval_ms);
+  SERIAL_ECHOLNPGM("ms, oldest first");
+  if (!samples) return;
+
+  int16_t v[THERMAL_HISTORY_VALUES];
+  COPY(v, first);
+  uint16_t i = tail;
+  int32_t t = -int32_t(span); // Intervals before the newest sample
+  for (uint16_t s = 0; s < samples; s++) {
+    if (s) {
+      uint8_t intervals;
+      i = decode(i, v, intervals);
+      t += intervals;
+    }
+    // Time relative to the newest sample
+    SERIAL_ECHOPAIR("TH:", t * interval_ms);
+    uint8_t n = 0;
+    HOTEND_LOOP() {
+      SERIAL_ECHOPAIR(" T", e);
+      SERIAL_CHAR(':');
+      SERIAL_ECHO_F(v[n] * 0.1f, 1);
+      SERIAL_ECHOPAIR(" /", v[n + 1]);
+      SERIAL_ECHOPAIR(" @", e);
+      SERIAL_ECHOPAIR(":", v[n + 2]);
+      n += 3;
+    }
+    #if HAS_HEATED_BED
+      SERIAL_ECHOPGM(" B:");
+      SERIAL_ECHO_F(v[n] * 0.1f, 1);
+      SERIAL_ECHOPAIR(" /", v[n + 1]);
+      SERIAL_ECHOPAIR(" B@:", v[n + 2]);
+    #endif
+    SERIAL_EOL();
+  }
+}
+
+#endif // THERMAL_HISTORY
@@ -0,0 +1,82 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * thermal_history.h - Ring buffer of recent heater samples
+ *
+ * Each sample holds the temperature (0.1°C), target (°C) and power (0-127)
+ * of every heater, hotends first and then the bed. A sample is stored as
+ * the change from the one before it:
+ *
+ *   uint8_t       Intervals since the previous sample (1-255)
+ *   uint8_t[]     Bitmask of the values that changed, bit 0 first
+ *   per change    int8_t delta, or 0x80 and then the new int16_t value
+ *
+ * Samples are taken on a fixed schedule. Intervals missed while the
+ * firmware was busy are skipped, so the next sample counts more than one.
+ * When the buffer is full the oldest samples are dropped, and their
+ * changes are folded into the values the history starts from.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if HAS_HEATED_BED
+  #define THERMAL_HISTORY_HEATERS (HOTENDS + 1)
+#else
+  #define THERMAL_HISTORY_HEATERS HOTENDS
+#endif
+#define THERMAL_HISTORY_VALUES (THERMAL_HISTORY_HEATERS * 3)
+#define THERMAL_HISTORY_MASK_SIZE ((THERMAL_HISTORY_VALUES + 7) / 8)
+#define THERMAL_HISTORY_MAX_SAMPLE (1 + THERMAL_HISTORY_MASK_SIZE + 3 * (THERMAL_HISTORY_VALUES)) // Every value escaped
+
+// Dropping the oldest sample must always free room for the newest
+static_assert(THERMAL_HISTORY_SIZE >= 2 * (THERMAL_HISTORY_MAX_SAMPLE), "THERMAL_HISTORY_SIZE is too small for two samples of every heater.");
+
+class ThermalHistory {
+  public:
+    static uint16_t interval_ms;  // 0 = Off
+    static uint16_t samples;      // Samples in the buffer
+
+    static void set_interval(uint16_t ms);
+    static void clear();
+
+    // Take a sample when one is due. Called from manage_heater().
+    static void update();
+
+    // Print every sample, oldest first
+    static void report();
+
+  private:
+    static uint8_t buffer[THERMAL_HISTORY_SIZE];
+    static uint16_t tail, used;                   // Oldest change, and bytes in use
+    static uint32_t span;                         // Intervals from the oldest sample to the newest
+    static int16_t first[THERMAL_HISTORY_VALUES], // Values of the oldest sample
+                   last[THERMAL_HISTORY_VALUES];  // Values of the newest sample
+    static millis_t next_sample_ms;
+
+    static void take_sample(int16_t (&v)[THERMAL_HISTORY_VALUES]);
+    static uint16_t decode(uint16_t i, int16_t (&v)[THERMAL_HISTORY_VALUES], uint8_t &intervals);
+    static inline uint8_t at(const uint16_t i) { return buffer[i % (THERMAL_HISTORY_SIZE)]; }
+};
+
+extern ThermalHistory thermal_history;
@@ -0,0 +1,55 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(EXTRUSION_FEEDFORWARD)
+
+#include "../gcode.h"
+#include "../../module/temperature.h"
+
+/**
+ * M309: Set hotend feedforward coefficients
+ *
+ *   E[int]   Hotend to set. Default 0.
+ *   V[float] Heater PWM per mm³/s of extrusion (not negative)
+ *   F[float] Heater PWM at full part-cooling fan speed (not negative)
+ */
+void GcodeSuite::M309() {
+  const uint8_t e = parser.byteval('E'); // hotend being updated
+
+  if (e < HOTENDS) { // catch bad input value
+    if (parser.seen('V')) thermalManager.feedforward[e].flow = MAX(0, parser.value_float());
+    if (parser.seen('F')) thermalManager.feedforward[e].fan = MAX(0, parser.value_float());
+
+    SERIAL_ECHO_START();
+    #if HOTENDS > 1
+      SERIAL_ECHOPAIR(" e:", e); // specify hotend in serial output
+    #endif
+    SERIAL_ECHOPAIR(" v:", thermalManager.feedforward[e].flow);
+    SERIAL_ECHOLNPAIR(" f:", thermalManager.feedforward[e].fan);
+  }
+  else
+    SERIAL_ERROR_MSG(MSG_INVALID_EXTRUDER);
+}
+
+#endif // EXTRUSION_FEEDFORWARD
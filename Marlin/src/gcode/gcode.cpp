@@ -157,595 +157,723 @@ void GcodeSuite::dwell(millis_t time) {
   extern void M100_dump_routine(PGM_P const title, const char *start, const char *end);
 #endif
 
+//
+// Adapters for handlers that take arguments or need special handling
+//
+void GcodeSuite::_G0_G1() {
+  G0_G1(
+    #if IS_SCARA || defined(G0_FEEDRATE)
+      parser.codenum == 0
+    #endif
+  );
+}
+
+#if ENABLED(ARC_SUPPORT) && DISABLED(SCARA)
+  void GcodeSuite::_G2_G3() { G2_G3(parser.codenum == 2); }
+#endif
+
+void GcodeSuite::_G28() { G28(false); }
+
+#if ENABLED(G38_PROBE_TARGET)
+  void GcodeSuite::_G38() {                                       // G38.2 & G38.3: Probe towards target
+    if (parser.subcode == 2 || parser.subcode == 3)
+      G38(parser.subcode == 2);
+  }
+#endif
+
+void GcodeSuite::_G90() { relative_mode = false; }
+void GcodeSuite::_G91() { relative_mode = true; }
+
+#if ENABLED(SPINDLE_LASER_ENABLE)
+  void GcodeSuite::_M3_M4() { M3_M4(parser.codenum == 4); }
+#endif
+
+#if ENABLED(FWRETRACT) && ENABLED(FWRETRACT_AUTORETRACT)
+  void GcodeSuite::_M209() { if (MIN_AUTORETRACT <= MAX_AUTORETRACT) M209(); }
+#endif
+
+#if ENABLED(MORGAN_SCARA)
+  static bool skip_ok; // Set when a SCARA calibration move is underway
+  void GcodeSuite::_M360() { skip_ok = M360(); }
+  void GcodeSuite::_M361() { skip_ok = M361(); }
+  void GcodeSuite::_M362() { skip_ok = M362(); }
+  void GcodeSuite::_M363() { skip_ok = M363(); }
+  void GcodeSuite::_M364() { skip_ok = M364(); }
+#endif
+
+void GcodeSuite::_T() { T(parser.codenum); }
+
+#if ENABLED(DEBUG_GCODE_PARSER)
+  void GcodeSuite::_parser_debug() { parser.debug(); }
+#endif
+
+static constexpr bool command_precedes(const GcodeSuite::CommandInfo &a, const GcodeSuite::CommandInfo &b) {
+  return a.letter < b.letter || (a.letter == b.letter && a.code < b.code);
+}
+static constexpr bool commands_sorted(const GcodeSuite::CommandInfo *table, const size_t count) {
+  return count < 2 || (command_precedes(table[0], table[1]) && commands_sorted(table + 1, count - 1));
+}
+static constexpr bool priority_commands_safe(const GcodeSuite::CommandInfo *table, const size_t count) {
+  return !count || (
+    (!(table->flags & GcodeSuite::CMD_PRIORITY) || !(table->flags & (GcodeSuite::CMD_MOTION | GcodeSuite::CMD_BLOCKING)))
+    && priority_commands_safe(table + 1, count - 1)
+  );
+}
+
 /**
- * Process the parsed command and dispatch it to its handler
+ * Look up a command in the dispatch table by binary search.
+ * A 'T' command is looked up as "T0" whatever the tool number.
+ * Return false if the command is unknown or disabled.
  */
-void GcodeSuite::process_parsed_command(
-  #if USE_EXECUTE_COMMANDS_IMMEDIATE
-    const bool no_ok
-  #endif
-) {
-  KEEPALIVE_STATE(IN_HANDLER);
+bool GcodeSuite::command_info(const char letter, const uint16_t code, CommandInfo &info) {
 
-  // Handle a known G, M, or T
-  switch (parser.command_letter) {
-    case 'G': switch (parser.codenum) {
-
-      case 0: case 1: G0_G1(                                      // G0: Fast Move, G1: Linear Move
-                        #if IS_SCARA || defined(G0_FEEDRATE)
-                          parser.codenum == 0
-                        #endif
-                      );
-                      break;
-
-      #if ENABLED(ARC_SUPPORT) && DISABLED(SCARA)
-        case 2: case 3: G2_G3(parser.codenum == 2); break;        // G2: CW ARC, G3: CCW ARC
-      #endif
+  #define MOTION    CMD_MOTION
+  #define BLOCKING  CMD_BLOCKING
+  #define PRIORITY  CMD_PRIORITY
 
-      case 4: G4(); break;                                        // G4: Dwell
+  /**
+   * The table of enabled commands, sorted by letter and code.
+   * A NULL handler accepts the command and does nothing.
+   */
+  static constexpr CommandInfo command_table[] PROGMEM = {
 
-      #if ENABLED(BEZIER_CURVE_SUPPORT)
-        case 5: G5(); break;                                      // G5: Cubic B_spline
-      #endif
+    { 'G',    0, _G0_G1,          MOTION },                       // G0: Fast Move
+    { 'G',    1, _G0_G1,          MOTION },                       // G1: Linear Move
 
-      #if ENABLED(FWRETRACT)
-        case 10: G10(); break;                                    // G10: Retract / Swap Retract
-        case 11: G11(); break;                                    // G11: Recover / Swap Recover
-      #endif
+    #if ENABLED(ARC_SUPPORT) && DISABLED(SCARA)
+      { 'G',  2, _G2_G3,          MOTION },                       // G2: CW ARC
+      { 'G',  3, _G2_G3,          MOTION },                       // G3: CCW ARC
+    #endif
 
-      #if ENABLED(NOZZLE_CLEAN_FEATURE)
-        case 12: G12(); break;                                    // G12: Nozzle Clean
-      #endif
+    { 'G',    4, G4,              BLOCKING },                     // G4: Dwell
 
-      #if ENABLED(CNC_WORKSPACE_PLANES)
-        case 17: G17(); break;                                    // G17: Select Plane XY
-        case 18: G18(); break;                                    // G18: Select Plane ZX
-        case 19: G19(); break;                                    // G19: Select Plane YZ
-      #endif
+    #if ENABLED(BEZIER_CURVE_SUPPORT)
+      { 'G',  5, G5,              MOTION },                       // G5: Cubic B_spline
+    #endif
+
+    #if ENABLED(FWRETRACT)
+      { 'G', 10, G10,             MOTION },                       // G10: Retract / Swap Retract
+      { 'G', 11, G11,             MOTION },                       // G11: Recover / Swap Recover
+    #endif
+
+    #if ENABLED(NOZZLE_CLEAN_FEATURE)
+      { 'G', 12, G12,             MOTION | BLOCKING },            // G12: Nozzle Clean
+    #endif
+
+    #if ENABLED(CNC_WORKSPACE_PLANES)
+      { 'G', 17, G17,             0 },                            // G17: Select Plane XY
+      { 'G', 18, G18,             0 },                            // G18: Select Plane ZX
+      { 'G', 19, G19,             0 },                            // G19: Select Plane YZ
+    #endif
+
+    #if ENABLED(INCH_MODE_SUPPORT)
+      { 'G', 20, G20,             0 },                            // G20: Inch Mode
+      { 'G', 21, G21,             0 },                            // G21: MM Mode
+    #else
+      { 'G', 21, NULL,            0 },                            // No error on unknown G21
+    #endif
+
+    #if ENABLED(G26_MESH_VALIDATION)
+      { 'G', 26, G26,             MOTION | BLOCKING },            // G26: Mesh Validation Pattern generation
+    #endif
+
+    #if ENABLED(NOZZLE_PARK_FEATURE)
+      { 'G', 27, G27,             MOTION | BLOCKING },            // G27: Nozzle Park
+    #endif
+
+    { 'G',   28, _G28,            MOTION | BLOCKING },            // G28: Home all axes, one at a time
 
-      #if ENABLED(INCH_MODE_SUPPORT)
-        case 20: G20(); break;                                    // G20: Inch Mode
-        case 21: G21(); break;                                    // G21: MM Mode
+    #if HAS_LEVELING                                              // G29: Bed leveling calibration
+      #if ENABLED(G29_RETRY_AND_RECOVER)
+        { 'G', 29, G29_with_retry, MOTION | BLOCKING },
       #else
-        case 21: NOOP; break;                                     // No error on unknown G21
+        { 'G', 29, G29,           MOTION | BLOCKING },
       #endif
+    #endif
 
-      #if ENABLED(G26_MESH_VALIDATION)
-        case 26: G26(); break;                                    // G26: Mesh Validation Pattern generation
+    #if HAS_BED_PROBE
+      { 'G', 30, G30,             MOTION | BLOCKING },            // G30: Single Z probe
+      #if ENABLED(Z_PROBE_SLED)
+        { 'G', 31, G31,           MOTION | BLOCKING },            // G31: dock the sled
+        { 'G', 32, G32,           MOTION | BLOCKING },            // G32: undock the sled
       #endif
+    #endif
 
-      #if ENABLED(NOZZLE_PARK_FEATURE)
-        case 27: G27(); break;                                    // G27: Nozzle Park
-      #endif
+    #if ENABLED(DELTA_AUTO_CALIBRATION)
+      { 'G', 33, G33,             MOTION | BLOCKING },            // G33: Delta Auto-Calibration
+    #endif
 
-      case 28: G28(false); break;                                 // G28: Home all axes, one at a time
+    #if ENABLED(Z_STEPPER_AUTO_ALIGN)
+      { 'G', 34, G34,             MOTION | BLOCKING },            // G34: Z Stepper automatic alignment using probe
+    #endif
 
-      #if HAS_LEVELING
-        case 29:                                                  // G29: Bed leveling calibration
-          #if ENABLED(G29_RETRY_AND_RECOVER)
-            G29_with_retry();
-          #else
-            G29();
-          #endif
-          break;
-      #endif // HAS_LEVELING
+    #if ENABLED(G38_PROBE_TARGET)
+      { 'G', 38, _G38,            MOTION | BLOCKING },            // G38.2 & G38.3: Probe towards target
+    #endif
 
-      #if HAS_BED_PROBE
-        case 30: G30(); break;                                    // G30: Single Z probe
-        #if ENABLED(Z_PROBE_SLED)
-          case 31: G31(); break;                                  // G31: dock the sled
-          case 32: G32(); break;                                  // G32: undock the sled
-        #endif
-      #endif
+    #if HAS_MESH
+      { 'G', 42, G42,             MOTION },                       // G42: Coordinated move to a mesh point
+    #endif
 
-      #if ENABLED(DELTA_AUTO_CALIBRATION)
-        case 33: G33(); break;                                    // G33: Delta Auto-Calibration
-      #endif
+    #if ENABLED(GCODE_MOTION_MODES)
+      { 'G', 80, G80,             0 },                            // G80: Reset the current motion mode
+    #endif
 
-      #if ENABLED(Z_STEPPER_AUTO_ALIGN)
-        case 34: G34(); break;                                    // G34: Z Stepper automatic alignment using probe
-      #endif
+    { 'G',   90, _G90,            0 },                            // G90: Absolute Mode
+    { 'G',   91, _G91,            0 },                            // G91: Relative Mode
+    { 'G',   92, G92,             0 },                            // G92: Set current axis position(s)
 
-      #if ENABLED(G38_PROBE_TARGET)
-        case 38:                                                  // G38.2 & G38.3: Probe towards target
-          if (parser.subcode == 2 || parser.subcode == 3)
-            G38(parser.subcode == 2);
-          break;
-      #endif
+    #if ENABLED(CALIBRATION_GCODE)
+      { 'G', 425, G425,           MOTION | BLOCKING },            // G425: Perform calibration with calibration cube
+    #endif
 
-      #if ENABLED(GCODE_MOTION_MODES)
-        case 80: G80(); break;                                    // G80: Reset the current motion mode
-      #endif
+    #if ENABLED(DEBUG_GCODE_PARSER)
+      { 'G', 800, _parser_debug,  0 },                            // G800: GCode Parser Test for G
+    #endif
 
-      case 90: relative_mode = false; break;                      // G90: Relative Mode
-      case 91: relative_mode = true; break;                       // G91: Absolute Mode
+    #if HAS_RESUME_CONTINUE
+      { 'M',  0, M0_M1,           BLOCKING },                     // M0: Unconditional stop - Wait for user button press on LCD
+      { 'M',  1, M0_M1,           BLOCKING },                     // M1: Conditional stop - Wait for user button press on LCD
+    #endif
 
-      case 92: G92(); break;                                      // G92: Set current axis position(s)
+    #if ENABLED(SPINDLE_LASER_ENABLE)
+      { 'M',  3, _M3_M4,          BLOCKING },                     // M3: turn spindle/laser on, set laser/spindle power/speed, set rotation direction CW
+      { 'M',  4, _M3_M4,          BLOCKING },                     // M4: turn spindle/laser on, set laser/spindle power/speed, set rotation direction CCW
+      { 'M',  5, M5,              BLOCKING },                     // M5 - turn spindle/laser off
+    #endif
 
-      #if HAS_MESH
-        case 42: G42(); break;                                    // G42: Coordinated move to a mesh point
-      #endif
+    #if ENABLED(EXTERNAL_CLOSED_LOOP_CONTROLLER)
+      { 'M', 12, M12,             BLOCKING },                     // M12: Synchronize and optionally force a CLC set
+    #endif
 
-      #if ENABLED(CALIBRATION_GCODE)
-        case 425: G425(); break;                                  // G425: Perform calibration with calibration cube
-      #endif
+    { 'M',   17, M17,             0 },                            // M17: Enable all stepper motors
+    { 'M',   18, M18_M84,         0 },                            // M18: Disable Steppers / Set Timeout
+
+    #if ENABLED(SDSUPPORT)
+      { 'M', 20, M20,             0 },                            // M20: list SD card
+      { 'M', 21, M21,             0 },                            // M21: init SD card
+      { 'M', 22, M22,             0 },                            // M22: release SD card
+      { 'M', 23, M23,             0 },                            // M23: Select file
+      { 'M', 24, M24,             0 },                            // M24: Start SD print
+      { 'M', 25, M25,             0 },                            // M25: Pause SD print
+      { 'M', 26, M26,             0 },                            // M26: Set SD index
+      { 'M', 27, M27,             PRIORITY },                     // M27: Get SD status
+      { 'M', 28, M28,             0 },                            // M28: Start SD write
+      { 'M', 29, M29,             0 },                            // M29: Stop SD write
+      { 'M', 30, M30,             0 },                            // M30 <filename> Delete File
+    #endif
 
-      #if ENABLED(DEBUG_GCODE_PARSER)
-        case 800: parser.debug(); break;                          // G800: GCode Parser Test for G
+    { 'M',   31, M31,             PRIORITY },                     // M31: Report time since the start of SD print or last M109
+
+    #if ENABLED(SDSUPPORT)
+      { 'M', 32, M32,             0 },                            // M32: Select file and start SD print
+      #if ENABLED(LONG_FILENAME_HOST_SUPPORT)
+        { 'M', 33, M33,           0 },                            // M33: Get the long full path to a file or folder
+      #endif
+      #if ENABLED(SDCARD_SORT_ALPHA) && ENABLED(SDSORT_GCODE)
+        { 'M', 34, M34,           0 },                            // M34: Set SD card sorting options
       #endif
+    #endif
 
-      default: parser.unknown_command_error(); break;
-    }
-    break;
+    { 'M',   42, M42,             0 },                            // M42: Change pin state
 
-    case 'M': switch (parser.codenum) {
-      #if HAS_RESUME_CONTINUE
-        case 0:                                                   // M0: Unconditional stop - Wait for user button press on LCD
-        case 1: M0_M1(); break;                                   // M1: Conditional stop - Wait for user button press on LCD
-      #endif
+    #if ENABLED(PINS_DEBUGGING)
+      { 'M', 43, M43,             0 },                            // M43: Read pin state
+    #endif
 
-      #if ENABLED(SPINDLE_LASER_ENABLE)
-        case 3: M3_M4(false); break;                              // M3: turn spindle/laser on, set laser/spindle power/speed, set rotation direction CW
-        case 4: M3_M4(true ); break;                              // M4: turn spindle/laser on, set laser/spindle power/speed, set rotation direction CCW
-        case 5: M5(); break;                                      // M5 - turn spindle/laser off
-      #endif
+    #if ENABLED(Z_MIN_PROBE_REPEATABILITY_TEST)
+      { 'M', 48, M48,             MOTION | BLOCKING },            // M48: Z probe repeatability test
+    #endif
 
-      #if ENABLED(EXTERNAL_CLOSED_LOOP_CONTROLLER)
-        case 12: M12(); break;                                    // M12: Synchronize and optionally force a CLC set
-      #endif
+    #if ENABLED(G26_MESH_VALIDATION)
+      { 'M', 49, M49,             0 },                            // M49: Turn on or off G26 debug flag for verbose output
+    #endif
 
-      case 17: M17(); break;                                      // M17: Enable all stepper motors
-
-      #if ENABLED(SDSUPPORT)
-        case 20: M20(); break;                                    // M20: list SD card
-        case 21: M21(); break;                                    // M21: init SD card
-        case 22: M22(); break;                                    // M22: release SD card
-        case 23: M23(); break;                                    // M23: Select file
-        case 24: M24(); break;                                    // M24: Start SD print
-        case 25: M25(); break;                                    // M25: Pause SD print
-        case 26: M26(); break;                                    // M26: Set SD index
-        case 27: M27(); break;                                    // M27: Get SD status
-        case 28: M28(); break;                                    // M28: Start SD write
-        case 29: M29(); break;                                    // M29: Stop SD write
-        case 30: M30(); break;                                    // M30 <filename> Delete File
-        case 32: M32(); break;                                    // M32: Select file and start SD print
-
-        #if ENABLED(LONG_FILENAME_HOST_SUPPORT)
-          case 33: M33(); break;                                  // M33: Get the long full path to a file or folder
-        #endif
+    #if ENABLED(LCD_SET_PROGRESS_MANUALLY)
+      { 'M', 73, M73,             0 },                            // M73: Set progress percentage (for display on LCD)
+    #endif
 
-        #if ENABLED(SDCARD_SORT_ALPHA) && ENABLED(SDSORT_GCODE)
-          case 34: M34(); break;                                  // M34: Set SD card sorting options
-        #endif
+    { 'M',   75, M75,             0 },                            // M75: Start print timer
+    { 'M',   76, M76,             0 },                            // M76: Pause print timer
+    { 'M',   77, M77,             0 },                            // M77: Stop print timer
 
-        case 928: M928(); break;                                  // M928: Start SD write
-      #endif // SDSUPPORT
+    #if ENABLED(PRINTCOUNTER)
+      { 'M', 78, M78,             0 },                            // M78: Show print statistics
+    #endif
 
-      case 31: M31(); break;                                      // M31: Report time since the start of SD print or last M109
-      case 42: M42(); break;                                      // M42: Change pin state
+    #if HAS_POWER_SWITCH
+      { 'M', 80, M80,             0 },                            // M80: Turn on Power Supply
+    #endif
+    { 'M',   81, M81,             BLOCKING },                     // M81: Turn off Power, including Power Supply, if possible
+    { 'M',   82, M82,             0 },                            // M82: Set E axis normal mode (same as other axes)
+    { 'M',   83, M83,             0 },                            // M83: Set E axis relative mode
+    { 'M',   84, M18_M84,         0 },                            // M84: Disable Steppers / Set Timeout
+    { 'M',   85, M85,             0 },                            // M85: Set inactivity stepper shutdown timeout
+    { 'M',   92, M92,             0 },                            // M92: Set the steps-per-unit for one or more axes
 
-      #if ENABLED(PINS_DEBUGGING)
-        case 43: M43(); break;                                    // M43: Read pin state
-      #endif
+    #if ENABLED(M100_FREE_MEMORY_WATCHER)
+      { 'M', 100, M100,           0 },                            // M100: Free Memory Report
+    #endif
 
-      #if ENABLED(Z_MIN_PROBE_REPEATABILITY_TEST)
-        case 48: M48(); break;                                    // M48: Z probe repeatability test
-      #endif
+    { 'M',  104, M104,            0 },                            // M104: Set hot end temperature
+    { 'M',  105, M105,            PRIORITY | CMD_NO_OK },         // M105: Report Temperatures (and say "ok")
 
-      #if ENABLED(G26_MESH_VALIDATION)
-        case 49: M49(); break;                                    // M49: Turn on or off G26 debug flag for verbose output
-      #endif
+    #if FAN_COUNT > 0
+      { 'M', 106, M106,           0 },                            // M106: Fan On
+      { 'M', 107, M107,           0 },                            // M107: Fan Off
+    #endif
 
-      #if ENABLED(LCD_SET_PROGRESS_MANUALLY)
-        case 73: M73(); break;                                    // M73: Set progress percentage (for display on LCD)
-      #endif
+    #if DISABLED(EMERGENCY_PARSER)
+      { 'M', 108, M108,           0 },                            // M108: Cancel Waiting
+    #else
+      { 'M', 108, NULL,           0 },                            // Handled by the emergency parser
+    #endif
 
-      case 75: M75(); break;                                      // M75: Start print timer
-      case 76: M76(); break;                                      // M76: Pause print timer
-      case 77: M77(); break;                                      // M77: Stop print timer
+    { 'M',  109, M109,            BLOCKING },                     // M109: Wait for hotend temperature to reach target
+    { 'M',  110, M110,            0 },                            // M110: Set Current Line Number
+    { 'M',  111, M111,            0 },                            // M111: Set debug level
 
-      #if ENABLED(PRINTCOUNTER)
-        case 78: M78(); break;                                    // M78: Show print statistics
-      #endif
+    #if DISABLED(EMERGENCY_PARSER)
+      { 'M', 112, M112,           0 },                            // M112: Emergency Stop
+    #else
+      { 'M', 112, NULL,           0 },                            // Handled by the emergency parser
+    #endif
 
-      #if ENABLED(M100_FREE_MEMORY_WATCHER)
-        case 100: M100(); break;                                  // M100: Free Memory Report
-      #endif
+    #if ENABLED(HOST_KEEPALIVE_FEATURE)
+      { 'M', 113, M113,           0 },                            // M113: Set Host Keepalive interval
+    #endif
 
-      case 104: M104(); break;                                    // M104: Set hot end temperature
-      case 109: M109(); break;                                    // M109: Wait for hotend temperature to reach target
-      case 110: M110(); break;                                    // M110: Set Current Line Number
-      case 111: M111(); break;                                    // M111: Set debug level
+    { 'M',  114, M114,            0 },                            // M114: Report current position
+    { 'M',  115, M115,            PRIORITY },                     // M115: Report capabilities
+    { 'M',  117, M117,            0 },                            // M117: Set LCD message text, if possible
+    { 'M',  118, M118,            0 },                            // M118: Display a message in the host console
+    { 'M',  119, M119,            0 },                            // M119: Report endstop states
+    { 'M',  120, M120,            0 },                            // M120: Enable endstops
+    { 'M',  121, M121,            0 },                            // M121: Disable endstops
 
-      #if DISABLED(EMERGENCY_PARSER)
-        case 108: M108(); break;                                  // M108: Cancel Waiting
-        case 112: M112(); break;                                  // M112: Emergency Stop
-        case 410: M410(); break;                                  // M410: Quickstop - Abort all the planned moves.
-        #if ENABLED(HOST_PROMPT_SUPPORT)
-          case 876: M876(); break;                                  // M876: Handle Host prompt responses
-        #endif
-      #else
-        case 108: case 112: case 410:
-        #if ENABLED(HOST_PROMPT_SUPPORT)
-          case 876:
-        #endif
-        break;
-      #endif
+    #if HAS_TRINAMIC || HAS_DRIVER(L6470)
+      { 'M', 122, M122,           0 },                            // M122: Report driver configuration and status
+    #endif
 
-      #if ENABLED(HOST_KEEPALIVE_FEATURE)
-        case 113: M113(); break;                                  // M113: Set Host Keepalive interval
-      #endif
+    #if ENABLED(PARK_HEAD_ON_PAUSE)
+      { 'M', 125, M125,           MOTION | BLOCKING },            // M125: Store current position and move to filament change position
+    #endif
 
-      #if HAS_HEATED_BED
-        case 140: M140(); break;                                  // M140: Set bed temperature
-        case 190: M190(); break;                                  // M190: Wait for bed temperature to reach target
+    #if ENABLED(BARICUDA)
+      #if HAS_HEATER_1                                            // PWM for HEATER_1_PIN
+        { 'M', 126, M126,         0 },                            // M126: valve open
+        { 'M', 127, M127,         0 },                            // M127: valve closed
+      #endif
+      #if HAS_HEATER_2                                            // PWM for HEATER_2_PIN
+        { 'M', 128, M128,         0 },                            // M128: valve open
+        { 'M', 129, M129,         0 },                            // M129: valve closed
       #endif
+    #endif
 
-      case 105: M105(); KEEPALIVE_STATE(NOT_BUSY); return;        // M105: Report Temperatures (and say "ok")
+    #if HAS_HEATED_BED
+      { 'M', 140, M140,           0 },                            // M140: Set bed temperature
+    #endif
 
-      #if ENABLED(AUTO_REPORT_TEMPERATURES) && HAS_TEMP_SENSOR
-        case 155: M155(); break;                                  // M155: Set temperature auto-report interval
-      #endif
+    #if HAS_LCD_MENU
+      { 'M', 145, M145,           0 },                            // M145: Set material heatup parameters
+    #endif
 
-      #if FAN_COUNT > 0
-        case 106: M106(); break;                                  // M106: Fan On
-        case 107: M107(); break;                                  // M107: Fan Off
-      #endif
+    #if ENABLED(TEMPERATURE_UNITS_SUPPORT)
+      { 'M', 149, M149,           0 },                            // M149: Set temperature units
+    #endif
 
-      #if ENABLED(PARK_HEAD_ON_PAUSE)
-        case 125: M125(); break;                                  // M125: Store current position and move to filament change position
-      #endif
+    #if HAS_COLOR_LEDS
+      { 'M', 150, M150,           0 },                            // M150: Set Status LED Color
+    #endif
 
-      #if ENABLED(BARICUDA)
-        // PWM for HEATER_1_PIN
-        #if HAS_HEATER_1
-          case 126: M126(); break;                                // M126: valve open
-          case 127: M127(); break;                                // M127: valve closed
-        #endif
+    #if ENABLED(AUTO_REPORT_TEMPERATURES) && HAS_TEMP_SENSOR
+      { 'M', 155, M155,           PRIORITY },                     // M155: Set temperature auto-report interval
+    #endif
 
-        // PWM for HEATER_2_PIN
-        #if HAS_HEATER_2
-          case 128: M128(); break;                                // M128: valve open
-          case 129: M129(); break;                                // M129: valve closed
-        #endif
-      #endif // BARICUDA
+    #if ENABLED(BINARY_TELEMETRY)
+      { 'M', 156, M156,           PRIORITY },                     // M156: Set binary telemetry intervals
+    #endif
+
+    #if ENABLED(THERMAL_HISTORY)
+      { 'M', 157, M157,           0 },                            // M157: Report thermal history
+    #endif
 
-      #if HAS_POWER_SWITCH
-        case 80: M80(); break;                                    // M80: Turn on Power Supply
+    #if ENABLED(MIXING_EXTRUDER)
+      { 'M', 163, M163,           0 },                            // M163: Set a component weight for mixing extruder
+      { 'M', 164, M164,           0 },                            // M164: Save current mix as a virtual extruder
+      #if ENABLED(DIRECT_MIXING_IN_G1)
+        { 'M', 165, M165,         0 },                            // M165: Set multiple mix weights
       #endif
-      case 81: M81(); break;                                      // M81: Turn off Power, including Power Supply, if possible
-
-      case 82: M82(); break;                                      // M82: Set E axis normal mode (same as other axes)
-      case 83: M83(); break;                                      // M83: Set E axis relative mode
-      case 18: case 84: M18_M84(); break;                         // M18/M84: Disable Steppers / Set Timeout
-      case 85: M85(); break;                                      // M85: Set inactivity stepper shutdown timeout
-      case 92: M92(); break;                                      // M92: Set the steps-per-unit for one or more axes
-      case 114: M114(); break;                                    // M114: Report current position
-      case 115: M115(); break;                                    // M115: Report capabilities
-      case 117: M117(); break;                                    // M117: Set LCD message text, if possible
-      case 118: M118(); break;                                    // M118: Display a message in the host console
-      case 119: M119(); break;                                    // M119: Report endstop states
-      case 120: M120(); break;                                    // M120: Enable endstops
-      case 121: M121(); break;                                    // M121: Disable endstops
-
-      #if HAS_LCD_MENU
-        case 145: M145(); break;                                  // M145: Set material heatup parameters
+      #if ENABLED(GRADIENT_MIX)
+        { 'M', 166, M166,         0 },                            // M166: Set Gradient Mix
       #endif
+    #endif
 
-      #if ENABLED(TEMPERATURE_UNITS_SUPPORT)
-        case 149: M149(); break;                                  // M149: Set temperature units
-      #endif
+    #if HAS_HEATED_BED
+      { 'M', 190, M190,           BLOCKING },                     // M190: Wait for bed temperature to reach target
+    #endif
 
-      #if HAS_COLOR_LEDS
-        case 150: M150(); break;                                  // M150: Set Status LED Color
-      #endif
+    #if DISABLED(NO_VOLUMETRICS)
+      { 'M', 200, M200,           0 },                            // M200: Set filament diameter, E to cubic units
+    #endif
 
-      #if ENABLED(MIXING_EXTRUDER)
-        case 163: M163(); break;                                  // M163: Set a component weight for mixing extruder
-        case 164: M164(); break;                                  // M164: Save current mix as a virtual extruder
-        #if ENABLED(DIRECT_MIXING_IN_G1)
-          case 165: M165(); break;                                // M165: Set multiple mix weights
-        #endif
-        #if ENABLED(GRADIENT_MIX)
-          case 166: M166(); break;                                // M166: Set Gradient Mix
-        #endif
-      #endif
+    { 'M',  201, M201,            0 },                            // M201: Set max acceleration for print moves (units/s^2)
+    { 'M',  203, M203,            0 },                            // M203: Set max feedrate (units/sec)
+    { 'M',  204, M204,            0 },                            // M204: Set acceleration
+    { 'M',  205, M205,            0 },                            // M205: Set advanced settings
+
+    #if HAS_M206_COMMAND
+      { 'M', 206, M206,           0 },                            // M206: Set home offsets
+    #endif
 
-      #if DISABLED(NO_VOLUMETRICS)
-        case 200: M200(); break;                                  // M200: Set filament diameter, E to cubic units
+    #if ENABLED(FWRETRACT)
+      { 'M', 207, M207,           0 },                            // M207: Set Retract Length, Feedrate, and Z lift
+      { 'M', 208, M208,           0 },                            // M208: Set Recover (unretract) Additional Length and Feedrate
+      #if ENABLED(FWRETRACT_AUTORETRACT)
+        { 'M', 209, _M209,        0 },                            // M209: Turn Automatic Retract Detection on/off
       #endif
+    #endif
 
-      case 201: M201(); break;                                    // M201: Set max acceleration for print moves (units/s^2)
+    #if HAS_SOFTWARE_ENDSTOPS
+      { 'M', 211, M211,           0 },                            // M211: Enable, Disable, and/or Report software endstops
+    #endif
 
-      #if 0
-        case 202: M202(); break;                                  // M202: Not used for Sprinter/grbl gen6
-      #endif
+    #if EXTRUDERS > 1
+      { 'M', 217, M217,           0 },                            // M217: Set filament swap parameters
+    #endif
 
-      case 203: M203(); break;                                    // M203: Set max feedrate (units/sec)
-      case 204: M204(); break;                                    // M204: Set acceleration
-      case 205: M205(); break;                                    // M205: Set advanced settings
+    #if HOTENDS > 1
+      { 'M', 218, M218,           0 },                            // M218: Set a tool offset
+    #endif
 
-      #if HAS_M206_COMMAND
-        case 206: M206(); break;                                  // M206: Set home offsets
-      #endif
+    { 'M',  220, M220,            PRIORITY },                     // M220: Set Feedrate Percentage: S<percent> ("FR" on your LCD)
+    { 'M',  221, M221,            PRIORITY },                     // M221: Set Flow Percentage
+    { 'M',  226, M226,            BLOCKING },                     // M226: Wait until a pin reaches a state
 
-      #if ENABLED(DELTA)
-        case 665: M665(); break;                                  // M665: Set delta configurations
-      #endif
+    #if ENABLED(PHOTO_GCODE)
+      { 'M', 240, M240,           MOTION | BLOCKING },            // M240: Trigger a camera
+    #endif
 
-      #if ENABLED(DELTA) || ENABLED(X_DUAL_ENDSTOPS) || ENABLED(Y_DUAL_ENDSTOPS) || ENABLED(Z_DUAL_ENDSTOPS)
-        case 666: M666(); break;                                  // M666: Set delta or dual endstop adjustment
-      #endif
+    #if HAS_LCD_CONTRAST
+      { 'M', 250, M250,           0 },                            // M250: Set LCD contrast
+    #endif
 
-      #if ENABLED(FWRETRACT)
-        case 207: M207(); break;                                  // M207: Set Retract Length, Feedrate, and Z lift
-        case 208: M208(); break;                                  // M208: Set Recover (unretract) Additional Length and Feedrate
-        #if ENABLED(FWRETRACT_AUTORETRACT)
-          case 209:
-            if (MIN_AUTORETRACT <= MAX_AUTORETRACT) M209();       // M209: Turn Automatic Retract Detection on/off
-            break;
-        #endif
-      #endif
+    #if ENABLED(EXPERIMENTAL_I2CBUS)
+      { 'M', 260, M260,           0 },                            // M260: Send data to an i2c slave
+      { 'M', 261, M261,           0 },                            // M261: Request data from an i2c slave
+    #endif
 
-      #if HAS_SOFTWARE_ENDSTOPS
-        case 211: M211(); break;                                  // M211: Enable, Disable, and/or Report software endstops
+    #if HAS_SERVOS
+      { 'M', 280, M280,           0 },                            // M280: Set servo position absolute
+      #if ENABLED(EDITABLE_SERVO_ANGLES)
+        { 'M', 281, M281,         0 },                            // M281: Set servo angles
       #endif
+    #endif
 
-      #if EXTRUDERS > 1
-        case 217: M217(); break;                                  // M217: Set filament swap parameters
-      #endif
+    #if ENABLED(BABYSTEPPING)
+      { 'M', 290, M290,           PRIORITY },                     // M290: Babystepping
+    #endif
 
-      #if HOTENDS > 1
-        case 218: M218(); break;                                  // M218: Set a tool offset
-      #endif
+    #if HAS_BUZZER
+      { 'M', 300, M300,           0 },                            // M300: Play beep tone
+    #endif
 
-      case 220: M220(); break;                                    // M220: Set Feedrate Percentage: S<percent> ("FR" on your LCD)
-      case 221: M221(); break;                                    // M221: Set Flow Percentage
-      case 226: M226(); break;                                    // M226: Wait until a pin reaches a state
+    #if ENABLED(PIDTEMP)
+      { 'M', 301, M301,           0 },                            // M301: Set hotend PID parameters
+    #endif
 
-      #if HAS_SERVOS
-        case 280: M280(); break;                                  // M280: Set servo position absolute
-        #if ENABLED(EDITABLE_SERVO_ANGLES)
-          case 281: M281(); break;                                // M281: Set servo angles
-        #endif
-      #endif
+    #if ENABLED(PREVENT_COLD_EXTRUSION)
+      { 'M', 302, M302,           0 },                            // M302: Allow cold extrudes (set the minimum extrude temperature)
+    #endif
 
-      #if ENABLED(BABYSTEPPING)
-        case 290: M290(); break;                                  // M290: Babystepping
-      #endif
+    #if HAS_PID_HEATING
+      { 'M', 303, M303,           BLOCKING },                     // M303: PID autotune
+    #endif
 
-      #if HAS_BUZZER
-        case 300: M300(); break;                                  // M300: Play beep tone
-      #endif
+    #if ENABLED(PIDTEMPBED)
+      { 'M', 304, M304,           0 },                            // M304: Set bed PID parameters
+    #endif
 
-      #if ENABLED(PIDTEMP)
-        case 301: M301(); break;                                  // M301: Set hotend PID parameters
-      #endif
+    #if ENABLED(EXTRUSION_FEEDFORWARD)
+      { 'M', 309, M309,           0 },                            // M309: Set hotend feedforward coefficients
+    #endif
 
-      #if ENABLED(PIDTEMPBED)
-        case 304: M304(); break;                                  // M304: Set bed PID parameters
-      #endif
+    #if HAS_MICROSTEPS
+      { 'M', 350, M350,           0 },                            // M350: Set microstepping mode. Warning: Steps per unit remains unchanged. S code sets stepping mode for all drivers.
+      { 'M', 351, M351,           0 },                            // M351: Toggle MS1 MS2 pins directly, S# determines MS1 or MS2, X# sets the pin high/low.
+    #endif
 
-      #if ENABLED(PHOTO_GCODE)
-        case 240: M240(); break;                                  // M240: Trigger a camera
-      #endif
+    #if HAS_CASE_LIGHT
+      { 'M', 355, M355,           0 },                            // M355: Set case light brightness
+    #endif
 
-      #if HAS_LCD_CONTRAST
-        case 250: M250(); break;                                  // M250: Set LCD contrast
-      #endif
+    #if ENABLED(MORGAN_SCARA)
+      { 'M', 360, _M360,          MOTION },                       // M360: SCARA Theta pos1
+      { 'M', 361, _M361,          MOTION },                       // M361: SCARA Theta pos2
+      { 'M', 362, _M362,          MOTION },                       // M362: SCARA Psi pos1
+      { 'M', 363, _M363,          MOTION },                       // M363: SCARA Psi pos2
+      { 'M', 364, _M364,          MOTION },                       // M364: SCARA Psi pos3 (90 deg to Theta)
+    #endif
 
-      #if ENABLED(EXPERIMENTAL_I2CBUS)
-        case 260: M260(); break;                                  // M260: Send data to an i2c slave
-        case 261: M261(); break;                                  // M261: Request data from an i2c slave
-      #endif
+    #if ENABLED(EXT_SOLENOID) || ENABLED(MANUAL_SOLENOID_CONTROL)
+      { 'M', 380, M380,           0 },                            // M380: Activate solenoid on active (or specified) extruder
+      { 'M', 381, M381,           0 },                            // M381: Disable all solenoids or, if MANUAL_SOLENOID_CONTROL, active (or specified) solenoid
+    #endif
 
-      #if ENABLED(PREVENT_COLD_EXTRUSION)
-        case 302: M302(); break;                                  // M302: Allow cold extrudes (set the minimum extrude temperature)
-      #endif
+    { 'M',  400, M400,            BLOCKING },                     // M400: Finish all moves
 
-      #if HAS_PID_HEATING
-        case 303: M303(); break;                                  // M303: PID autotune
-      #endif
+    #if HAS_BED_PROBE
+      { 'M', 401, M401,           MOTION | BLOCKING },            // M401: Deploy probe
+      { 'M', 402, M402,           MOTION | BLOCKING },            // M402: Stow probe
+    #endif
 
-      #if ENABLED(MORGAN_SCARA)
-        case 360: if (M360()) return; break;                      // M360: SCARA Theta pos1
-        case 361: if (M361()) return; break;                      // M361: SCARA Theta pos2
-        case 362: if (M362()) return; break;                      // M362: SCARA Psi pos1
-        case 363: if (M363()) return; break;                      // M363: SCARA Psi pos2
-        case 364: if (M364()) return; break;                      // M364: SCARA Psi pos3 (90 deg to Theta)
-      #endif
+    #if ENABLED(PRUSA_MMU2)
+      { 'M', 403, M403,           0 },                            // M403: Set filament type for MMU2
+    #endif
 
-      #if ENABLED(EXT_SOLENOID) || ENABLED(MANUAL_SOLENOID_CONTROL)
-        case 380: M380(); break;                                  // M380: Activate solenoid on active (or specified) extruder
-        case 381: M381(); break;                                  // M381: Disable all solenoids or, if MANUAL_SOLENOID_CONTROL, active (or specified) solenoid
-      #endif
+    #if ENABLED(FILAMENT_WIDTH_SENSOR)
+      { 'M', 404, M404,           0 },                            // M404: Enter the nominal filament width (3mm, 1.75mm ) N<3.0> or display nominal filament width
+      { 'M', 405, M405,           0 },                            // M405: Turn on filament sensor for control
+      { 'M', 406, M406,           0 },                            // M406: Turn off filament sensor for control
+      { 'M', 407, M407,           0 },                            // M407: Display measured filament diameter
+    #endif
 
-      case 400: M400(); break;                                    // M400: Finish all moves
+    #if DISABLED(EMERGENCY_PARSER)
+      { 'M', 410, M410,           0 },                            // M410: Quickstop - Abort all the planned moves.
+    #else
+      { 'M', 410, NULL,           0 },                            // Handled by the emergency parser
+    #endif
 
-      #if HAS_BED_PROBE
-        case 401: M401(); break;                                  // M401: Deploy probe
-        case 402: M402(); break;                                  // M402: Stow probe
-      #endif
+    #if HAS_FILAMENT_SENSOR
+      { 'M', 412, M412,           0 },                            // M412: Enable/Disable filament runout detection
+    #endif
 
-      #if ENABLED(PRUSA_MMU2)
-        case 403: M403(); break;
-      #endif
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      { 'M', 413, M413,           0 },                            // M413: Enable/disable/query Power-Loss Recovery
+    #endif
 
-      #if ENABLED(FILAMENT_WIDTH_SENSOR)
-        case 404: M404(); break;                                  // M404: Enter the nominal filament width (3mm, 1.75mm ) N<3.0> or display nominal filament width
-        case 405: M405(); break;                                  // M405: Turn on filament sensor for control
-        case 406: M406(); break;                                  // M406: Turn off filament sensor for control
-        case 407: M407(); break;                                  // M407: Display measured filament diameter
-      #endif
+    #if HAS_LEVELING
+      { 'M', 420, M420,           0 },                            // M420: Enable/Disable Bed Leveling
+    #endif
 
-      #if HAS_FILAMENT_SENSOR
-        case 412: M412(); break;                                  // M412: Enable/Disable filament runout detection
-      #endif
+    #if HAS_MESH
+      { 'M', 421, M421,           0 },                            // M421: Set a Mesh Bed Leveling Z coordinate
+    #endif
 
-      #if HAS_LEVELING
-        case 420: M420(); break;                                  // M420: Enable/Disable Bed Leveling
-      #endif
+    #if ENABLED(Z_STEPPER_AUTO_ALIGN)
+      { 'M', 422, M422,           0 },                            // M422: Set Z Stepper automatic alignment position using probe
+    #endif
 
-      #if HAS_MESH
-        case 421: M421(); break;                                  // M421: Set a Mesh Bed Leveling Z coordinate
-      #endif
+    #if ENABLED(BACKLASH_GCODE)
+      { 'M', 425, M425,           0 },                            // M425: Tune backlash compensation
+    #endif
 
-      #if ENABLED(BACKLASH_GCODE)
-        case 425: M425(); break;                                  // M425: Tune backlash compensation
-      #endif
+    #if HAS_M206_COMMAND
+      { 'M', 428, M428,           0 },                            // M428: Apply current_position to home_offset
+    #endif
 
-      #if HAS_M206_COMMAND
-        case 428: M428(); break;                                  // M428: Apply current_position to home_offset
-      #endif
+    { 'M',  500, M500,            0 },                            // M500: Store settings in EEPROM
+    { 'M',  501, M501,            0 },                            // M501: Read settings from EEPROM
+    { 'M',  502, M502,            0 },                            // M502: Revert to default settings
 
-      case 500: M500(); break;                                    // M500: Store settings in EEPROM
-      case 501: M501(); break;                                    // M501: Read settings from EEPROM
-      case 502: M502(); break;                                    // M502: Revert to default settings
-      #if DISABLED(DISABLE_M503)
-        case 503: M503(); break;                                  // M503: print settings currently in memory
-      #endif
-      #if ENABLED(EEPROM_SETTINGS)
-        case 504: M504(); break;                                  // M504: Validate EEPROM contents
-      #endif
+    #if DISABLED(DISABLE_M503)
+      { 'M', 503, M503,           0 },                            // M503: print settings currently in memory
+    #endif
 
-      #if ENABLED(SDSUPPORT)
-        case 524: M524(); break;                                   // M524: Abort the current SD print job
-      #endif
+    #if ENABLED(EEPROM_SETTINGS)
+      { 'M', 504, M504,           0 },                            // M504: Validate EEPROM contents
+    #endif
 
-      #if ENABLED(ABORT_ON_ENDSTOP_HIT_FEATURE_ENABLED)
-        case 540: M540(); break;                                  // M540: Set abort on endstop hit for SD printing
-      #endif
+    #if ENABLED(SDSUPPORT)
+      { 'M', 524, M524,           0 },                            // M524: Abort the current SD print job
+    #endif
 
-      #if HAS_BED_PROBE
-        case 851: M851(); break;                                  // M851: Set Z Probe Z Offset
-      #endif
+    #if ENABLED(ABORT_ON_ENDSTOP_HIT_FEATURE_ENABLED)
+      { 'M', 540, M540,           0 },                            // M540: Set abort on endstop hit for SD printing
+    #endif
 
-      #if ENABLED(SKEW_CORRECTION_GCODE)
-        case 852: M852(); break;                                  // M852: Set Skew factors
-      #endif
+    #if HAS_TRINAMIC && HAS_STEALTHCHOP
+      { 'M', 569, M569,           0 },                            // M569: Enable stealthChop on an axis.
+    #endif
 
-      #if ENABLED(ADVANCED_PAUSE_FEATURE)
-        case 600: M600(); break;                                  // M600: Pause for Filament Change
-        case 603: M603(); break;                                  // M603: Configure Filament Change
-      #endif
+    #if ENABLED(ADVANCED_PAUSE_FEATURE)
+      { 'M', 600, M600,           MOTION | BLOCKING },            // M600: Pause for Filament Change
+      { 'M', 603, M603,           0 },                            // M603: Configure Filament Change
+    #endif
 
-      #if ENABLED(DUAL_X_CARRIAGE) || ENABLED(DUAL_NOZZLE_DUPLICATION_MODE)
-        case 605: M605(); break;                                  // M605: Set Dual X Carriage movement mode
-      #endif
+    #if ENABLED(DUAL_X_CARRIAGE) || ENABLED(DUAL_NOZZLE_DUPLICATION_MODE)
+      { 'M', 605, M605,           MOTION | BLOCKING },            // M605: Set Dual X Carriage movement mode
+    #endif
 
-      #if ENABLED(FILAMENT_LOAD_UNLOAD_GCODES)
-        case 701: M701(); break;                                  // M701: Load Filament
-        case 702: M702(); break;                                  // M702: Unload Filament
-      #endif
+    #if ENABLED(DELTA)
+      { 'M', 665, M665,           0 },                            // M665: Set delta configurations
+    #endif
 
-      #if ENABLED(MAX7219_GCODE)
-        case 7219: M7219(); break;                                // M7219: Set LEDs, columns, and rows
-      #endif
+    #if ENABLED(DELTA) || ENABLED(X_DUAL_ENDSTOPS) || ENABLED(Y_DUAL_ENDSTOPS) || ENABLED(Z_DUAL_ENDSTOPS)
+      { 'M', 666, M666,           0 },                            // M666: Set delta or dual endstop adjustment
+    #endif
 
-      #if ENABLED(GCODE_MACROS)
-        case 810: case 811: case 812: case 813: case 814:
-        case 815: case 816: case 817: case 818: case 819:
-        M810_819(); break;                                        // M810-M819: Define/execute G-code macro
-      #endif
+    #if ENABLED(FILAMENT_LOAD_UNLOAD_GCODES)
+      { 'M', 701, M701,           MOTION | BLOCKING },            // M701: Load Filament
+      { 'M', 702, M702,           MOTION | BLOCKING },            // M702: Unload Filament
+    #endif
 
-      #if ENABLED(LIN_ADVANCE)
-        case 900: M900(); break;                                  // M900: Set advance K factor.
-      #endif
+    #if ENABLED(DEBUG_GCODE_PARSER)
+      { 'M', 800, _parser_debug,  0 },                            // M800: GCode Parser Test for M
+    #endif
 
-      #if HAS_DIGIPOTSS || HAS_MOTOR_CURRENT_PWM || ENABLED(DIGIPOT_I2C) || ENABLED(DAC_STEPPER_CURRENT)
-        case 907: M907(); break;                                  // M907: Set digital trimpot motor current using axis codes.
-        #if HAS_DIGIPOTSS || ENABLED(DAC_STEPPER_CURRENT)
-          case 908: M908(); break;                                // M908: Control digital trimpot directly.
-          #if ENABLED(DAC_STEPPER_CURRENT)
-            case 909: M909(); break;                              // M909: Print digipot/DAC current value
-            case 910: M910(); break;                              // M910: Commit digipot/DAC value to external EEPROM
-          #endif
-        #endif
+    #if ENABLED(GCODE_MACROS)                                     // M810-M819: Define/execute G-code macro
+      { 'M', 810, M810_819,       0 }, { 'M', 811, M810_819,      0 },
+      { 'M', 812, M810_819,       0 }, { 'M', 813, M810_819,      0 },
+      { 'M', 814, M810_819,       0 }, { 'M', 815, M810_819,      0 },
+      { 'M', 816, M810_819,       0 }, { 'M', 817, M810_819,      0 },
+      { 'M', 818, M810_819,       0 }, { 'M', 819, M810_819,      0 },
+    #endif
+
+    #if HAS_BED_PROBE
+      { 'M', 851, M851,           0 },                            // M851: Set Z Probe Z Offset
+    #endif
+
+    #if ENABLED(SKEW_CORRECTION_GCODE)
+      { 'M', 852, M852,           0 },                            // M852: Set Skew factors
+    #endif
+
+    #if ENABLED(I2C_POSITION_ENCODERS)
+      { 'M', 860, M860,           0 },                            // M860: Report encoder module position
+      { 'M', 861, M861,           0 },                            // M861: Report encoder module status
+      { 'M', 862, M862,           MOTION | BLOCKING },            // M862: Perform axis test
+      { 'M', 863, M863,           MOTION | BLOCKING },            // M863: Calibrate steps/mm
+      { 'M', 864, M864,           0 },                            // M864: Change module address
+      { 'M', 865, M865,           0 },                            // M865: Check module firmware version
+      { 'M', 866, M866,           0 },                            // M866: Report axis error count
+      { 'M', 867, M867,           0 },                            // M867: Toggle error correction
+      { 'M', 868, M868,           0 },                            // M868: Set error correction threshold
+      { 'M', 869, M869,           0 },                            // M869: Report axis error
+    #endif
+
+    #if ENABLED(HOST_PROMPT_SUPPORT)
+      #if DISABLED(EMERGENCY_PARSER)
+        { 'M', 876, M876,         0 },                            // M876: Handle Host prompt responses
+      #else
+        { 'M', 876, NULL,         0 },                            // Handled by the emergency parser
       #endif
+    #endif
 
-      #if HAS_TRINAMIC
-        case 122: M122(); break;                                  // M122: Report driver configuration and status
-        case 906: M906(); break;                                  // M906: Set motor current in milliamps using axis codes X, Y, Z, E
-        #if HAS_STEALTHCHOP
-          case 569: M569(); break;                                // M569: Enable stealthChop on an axis.
-        #endif
-        #if ENABLED(MONITOR_DRIVER_STATUS)
-          case 911: M911(); break;                                // M911: Report TMC2130 prewarn triggered flags
-          case 912: M912(); break;                                // M912: Clear TMC2130 prewarn triggered flags
-        #endif
-        #if ENABLED(HYBRID_THRESHOLD)
-          case 913: M913(); break;                                // M913: Set HYBRID_THRESHOLD speed.
-        #endif
-        #if USE_SENSORLESS
-          case 914: M914(); break;                                // M914: Set StallGuard sensitivity.
+    #if ENABLED(LIN_ADVANCE)
+      { 'M', 900, M900,           0 },                            // M900: Set advance K factor.
+    #endif
+
+    #if HAS_TRINAMIC || HAS_DRIVER(L6470)
+      { 'M', 906, M906,           0 },                            // M906: Set motor current in milliamps using axis codes X, Y, Z, E
+    #endif
+
+    #if HAS_DIGIPOTSS || HAS_MOTOR_CURRENT_PWM || ENABLED(DIGIPOT_I2C) || ENABLED(DAC_STEPPER_CURRENT)
+      { 'M', 907, M907,           0 },                            // M907: Set digital trimpot motor current using axis codes.
+      #if HAS_DIGIPOTSS || ENABLED(DAC_STEPPER_CURRENT)
+        { 'M', 908, M908,         0 },                            // M908: Control digital trimpot directly.
+        #if ENABLED(DAC_STEPPER_CURRENT)
+          { 'M', 909, M909,       0 },                            // M909: Print digipot/DAC current value
+          { 'M', 910, M910,       0 },                            // M910: Commit digipot/DAC value to external EEPROM
         #endif
       #endif
+    #endif
 
-      #if HAS_DRIVER(L6470)
-        case 122: M122(); break;                                   // M122: Report status
-        case 906: M906(); break;                                   // M906: Set or get motor drive level
-        case 916: M916(); break;                                   // M916: L6470 tuning: Increase drive level until thermal warning
-        case 917: M917(); break;                                   // M917: L6470 tuning: Find minimum current thresholds
-        case 918: M918(); break;                                   // M918: L6470 tuning: Increase speed until max or error
+    #if HAS_TRINAMIC
+      #if ENABLED(MONITOR_DRIVER_STATUS)
+        { 'M', 911, M911,         0 },                            // M911: Report TMC2130 prewarn triggered flags
+        { 'M', 912, M912,         0 },                            // M912: Clear TMC2130 prewarn triggered flags
       #endif
-
-      #if HAS_MICROSTEPS
-        case 350: M350(); break;                                  // M350: Set microstepping mode. Warning: Steps per unit remains unchanged. S code sets stepping mode for all drivers.
-        case 351: M351(); break;                                  // M351: Toggle MS1 MS2 pins directly, S# determines MS1 or MS2, X# sets the pin high/low.
+      #if ENABLED(HYBRID_THRESHOLD)
+        { 'M', 913, M913,         0 },                            // M913: Set HYBRID_THRESHOLD speed.
       #endif
-
-      #if HAS_CASE_LIGHT
-        case 355: M355(); break;                                  // M355: Set case light brightness
+      #if USE_SENSORLESS
+        { 'M', 914, M914,         0 },                            // M914: Set StallGuard sensitivity.
       #endif
+    #endif
 
-      #if ENABLED(DEBUG_GCODE_PARSER)
-        case 800: parser.debug(); break;                          // M800: GCode Parser Test for M
-      #endif
+    #if HAS_DRIVER(L6470)
+      { 'M', 916, M916,           MOTION | BLOCKING },            // M916: L6470 tuning: Increase drive level until thermal warning
+      { 'M', 917, M917,           MOTION | BLOCKING },            // M917: L6470 tuning: Find minimum current thresholds
+      { 'M', 918, M918,           MOTION | BLOCKING },            // M918: L6470 tuning: Increase speed until max or error
+    #endif
 
-      #if ENABLED(I2C_POSITION_ENCODERS)
-        case 860: M860(); break;                                  // M860: Report encoder module position
-        case 861: M861(); break;                                  // M861: Report encoder module status
-        case 862: M862(); break;                                  // M862: Perform axis test
-        case 863: M863(); break;                                  // M863: Calibrate steps/mm
-        case 864: M864(); break;                                  // M864: Change module address
-        case 865: M865(); break;                                  // M865: Check module firmware version
-        case 866: M866(); break;                                  // M866: Report axis error count
-        case 867: M867(); break;                                  // M867: Toggle error correction
-        case 868: M868(); break;                                  // M868: Set error correction threshold
-        case 869: M869(); break;                                  // M869: Report axis error
-      #endif
+    #if ENABLED(SDSUPPORT)
+      { 'M', 928, M928,           0 },                            // M928: Start SD write
+    #endif
 
-      #if ENABLED(MAGNETIC_PARKING_EXTRUDER)
-        case 951: M951(); break;                                  // M951: Set Magnetic Parking Extruder parameters
-      #endif
+    #if ENABLED(MAGNETIC_PARKING_EXTRUDER)
+      { 'M', 951, M951,           0 },                            // M951: Set Magnetic Parking Extruder parameters
+    #endif
 
-      #if ENABLED(Z_STEPPER_AUTO_ALIGN)
-        case 422: M422(); break;                                  // M422: Set Z Stepper automatic alignment position using probe
-      #endif
+    #if ENABLED(PLATFORM_M997_SUPPORT)
+      { 'M', 997, M997,           0 },                            // M997: Perform in-application firmware update
+    #endif
 
-      #if ENABLED(PLATFORM_M997_SUPPORT)
-        case 997: M997(); break;                                  // M997: Perform in-application firmware update
-      #endif
+    { 'M',  999, M999,            0 },                            // M999: Restart after being Stopped
 
-      case 999: M999(); break;                                    // M999: Restart after being Stopped
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      { 'M', 1000, M1000,         MOTION | BLOCKING },            // M1000: Resume from power-loss
+    #endif
 
-      #if ENABLED(POWER_LOSS_RECOVERY)
-        case 413: M413(); break;                                  // M413: Enable/disable/query Power-Loss Recovery
-        case 1000: M1000(); break;                                // M1000: Resume from power-loss
-      #endif
+    #if ENABLED(MAX7219_GCODE)
+      { 'M', 7219, M7219,         0 },                            // M7219: Set LEDs, columns, and rows
+    #endif
+
+    { 'T',    0, _T,              MOTION | BLOCKING }             // Tn: Tool Change
+  };
 
-      default: parser.unknown_command_error(); break;
+  #undef MOTION
+  #undef BLOCKING
+  #undef PRIORITY
+
+  static_assert(commands_sorted(command_table, COUNT(command_table)), "The G-code dispatch table must be sorted by letter and code, without duplicates.");
+  static_assert(priority_commands_safe(command_table, COUNT(command_table)), "Commands flagged PRIORITY run out of order, so they can't be MOTION or BLOCKING.");
+
+  uint16_t lo = 0, hi = COUNT(command_table);
+  while (lo < hi) {
+    const uint16_t mid = (lo + hi) >> 1;
+    const char l = pgm_read_byte(&command_table[mid].letter);
+    const uint16_t n = pgm_read_word(&command_table[mid].code);
+    if (l == letter && n == code) {
+      memcpy_P(&info, &command_table[mid], sizeof(info));
+      return true;
     }
-    break;
+    if (l < letter || (l == letter && n < code)) lo = mid + 1; else hi = mid;
+  }
+  return false;
+}
 
-    case 'T': T(parser.codenum); break;                           // Tn: Tool Change
+/**
+ * Process the parsed command and dispatch it to its handler
+ */
+void GcodeSuite::process_parsed_command(
+  #if USE_EXECUTE_COMMANDS_IMMEDIATE || ENABLED(PRIORITY_COMMANDS)
+    const bool no_ok
+  #endif
+) {
+  KEEPALIVE_STATE(IN_HANDLER);
 
-    default: parser.unknown_command_error();
+  // Handle a known G, M, or T
+  CommandInfo cmd;
+  if (!command_info(parser.command_letter, parser.command_letter == 'T' ? 0 : parser.codenum, cmd)) {
+    cmd.flags = 0;
+    parser.unknown_command_error();
+  }
+  else if (cmd.handler) {
+    #if ENABLED(MORGAN_SCARA)
+      skip_ok = false;
+    #endif
+    cmd.handler();
+    #if ENABLED(MORGAN_SCARA)
+      if (skip_ok) return;
+    #endif
   }
 
   KEEPALIVE_STATE(NOT_BUSY);
 
-  #if USE_EXECUTE_COMMANDS_IMMEDIATE
+  if (cmd.flags & CMD_NO_OK) return;                              // Handler sent "ok"
+
+  #if USE_EXECUTE_COMMANDS_IMMEDIATE || ENABLED(PRIORITY_COMMANDS)
     if (!no_ok)
   #endif
       ok_to_send();
@@ -812,6 +940,28 @@ void GcodeSuite::process_next_command() {
 
 #endif // USE_EXECUTE_COMMANDS_IMMEDIATE
 
+#if ENABLED(PRIORITY_COMMANDS)
+
+  /**
+   * Run a command from the priority lane, ahead of the command queue.
+   * This may be called from idle() while another command is in progress,
+   * so the parser state is restored afterward. No "ok" is sent here.
+   */
+  void GcodeSuite::process_priority_command(char * const cmd) {
+    char * const saved_cmd = parser.command_ptr;        // Save the parser state
+    #if ENABLED(HOST_KEEPALIVE_FEATURE)
+      const MarlinBusyState saved_state = busy_state;   // Save the busy state
+    #endif
+    parser.parse(cmd);                                  // Parse the command
+    process_parsed_command(true);                       // Process it
+    if (saved_cmd) parser.parse(saved_cmd);             // Restore the parser state
+    #if ENABLED(HOST_KEEPALIVE_FEATURE)
+      busy_state = saved_state;                         // Restore the busy state
+    #endif
+  }
+
+#endif // PRIORITY_COMMANDS
+
 #if ENABLED(HOST_KEEPALIVE_FEATURE)
 
   /**
@@ -124,6 +124,7 @@
  * M109 - Sxxx Wait for extruder current temp to reach target temp. Waits only when heating
  *        Rxxx Wait for extruder current temp to reach target temp. Waits when heating and cooling
  *        If AUTOTEMP is enabled, S<mintemp> B<maxtemp> F<factor>. Exit autotemp by any M109 without F
+ *        With D, wait before the next extruding move instead. (Requires TEMPERATURE_BARRIERS)
  * M110 - Set the current line number. (Used by host printing)
  * M111 - Set debug flags: "M111 S<flagbits>". See flag bits defined in enum.h.
  * M112 - Emergency stop.
@@ -146,12 +147,16 @@
  * M149 - Set temperature units. (Requires TEMPERATURE_UNITS_SUPPORT)
  * M150 - Set Status LED Color as R<red> U<green> B<blue> P<bright>. Values 0-255. (Requires BLINKM, RGB_LED, RGBW_LED, NEOPIXEL_LED, or PCA9632).
  * M155 - Auto-report temperatures with interval of S<seconds>. (Requires AUTO_REPORT_TEMPERATURES)
+ *        D<degrees> and C<bool> report only changes, in a compact format. (Requires AUTO_REPORT_TEMPERATURE_CHANGES)
+ * M156 - Set binary telemetry intervals: T<ms> thermal, P<ms> position, S<ms> status. (Requires BINARY_TELEMETRY)
+ * M157 - Report thermal history. S<ms> sets the sample interval, C clears. (Requires THERMAL_HISTORY)
  * M163 - Set a single proportion for a mixing extruder. (Requires MIXING_EXTRUDER)
  * M164 - Commit the mix and save to a virtual tool (current, or as specified by 'S'). (Requires MIXING_EXTRUDER)
  * M165 - Set the mix for the mixing extruder (and current virtual tool) with parameters ABCDHI. (Requires MIXING_EXTRUDER and DIRECT_MIXING_IN_G1)
  * M166 - Set the Gradient Mix for the mixing extruder. (Requires GRADIENT_MIX)
  * M190 - Sxxx Wait for bed current temp to reach target temp. ** Waits only when heating! **
  *        Rxxx Wait for bed current temp to reach target temp. ** Waits for heating or cooling. **
+ *        With D, wait before the next extruding move instead. (Requires TEMPERATURE_BARRIERS)
  * M200 - Set filament diameter, D<diameter>, setting E axis units to cubic. (Use S0 to revert to linear units.)
  * M201 - Set max acceleration in units/s^2 for print moves: "M201 X<accel> Y<accel> Z<accel> E<accel>"
  * M202 - Set max acceleration in units/s^2 for travel moves: "M202 X<accel> Y<accel> Z<accel> E<accel>" ** UNUSED IN MARLIN! **
@@ -184,6 +189,7 @@
  * M302 - Allow cold extrudes, or set the minimum extrude S<temperature>. (Requires PREVENT_COLD_EXTRUSION)
  * M303 - PID relay autotune S<temperature> sets the target temperature. Default 150C. (Requires PIDTEMP)
  * M304 - Set bed PID parameters P I and D. (Requires PIDTEMPBED)
+ * M309 - Set hotend feedforward E<hotend> V<per mm³/s> F<full fan>. (Requires EXTRUSION_FEEDFORWARD)
  * M350 - Set microstepping mode. (Requires digital microstepping pins.)
  * M351 - Toggle MS1 MS2 pins directly. (Requires digital microstepping pins.)
  * M355 - Set Case Light on/off and set brightness. (Requires CASE_LIGHT_PIN)
@@ -300,8 +306,29 @@ public:
   static int8_t get_target_extruder_from_command();
   static void get_destination_from_command();
 
+  /**
+   * Command attributes in the dispatch table
+   */
+  enum CommandFlag : uint8_t {
+    CMD_MOTION    = _BV(0),   // Moves the machine or changes the planned path
+    CMD_BLOCKING  = _BV(1),   // May wait (for moves, heaters, the user...) before returning
+    CMD_PRIORITY  = _BV(2),   // Safe to run out of order, ahead of the queue
+    CMD_NO_OK     = _BV(3)    // The handler sends its own "ok"
+  };
+
+  typedef void (*CommandHandler)();
+
+  typedef struct {
+    char letter;              // 'G', 'M', or 'T'
+    uint16_t code;            // Command number (0 for 'T')
+    CommandHandler handler;   // NULL to accept the command and do nothing
+    uint8_t flags;            // CommandFlag bits
+  } CommandInfo;
+
+  static bool command_info(const char letter, const uint16_t code, CommandInfo &info);
+
   static void process_parsed_command(
-    #if USE_EXECUTE_COMMANDS_IMMEDIATE
+    #if USE_EXECUTE_COMMANDS_IMMEDIATE || ENABLED(PRIORITY_COMMANDS)
       const bool no_ok = false
     #endif
   );
@@ -312,6 +339,10 @@ public:
     static void process_subcommands_now(char * gcode);
   #endif
 
+  #if ENABLED(PRIORITY_COMMANDS)
+    static void process_priority_command(char * const cmd);
+  #endif
+
   FORCE_INLINE static void home_all_axes() { G28(true); }
 
   #if ENABLED(HOST_KEEPALIVE_FEATURE)
@@ -341,6 +372,35 @@ public:
 
 private:
 
+  // Dispatch table adapters, for handlers that take arguments
+  static void _G0_G1();
+  #if ENABLED(ARC_SUPPORT) && DISABLED(SCARA)
+    static void _G2_G3();
+  #endif
+  static void _G28();
+  #if ENABLED(G38_PROBE_TARGET)
+    static void _G38();
+  #endif
+  static void _G90();
+  static void _G91();
+  #if ENABLED(SPINDLE_LASER_ENABLE)
+    static void _M3_M4();
+  #endif
+  #if ENABLED(FWRETRACT) && ENABLED(FWRETRACT_AUTORETRACT)
+    static void _M209();
+  #endif
+  #if ENABLED(MORGAN_SCARA)
+    static void _M360();
+    static void _M361();
+    static void _M362();
+    static void _M363();
+    static void _M364();
+  #endif
+  static void _T();
+  #if ENABLED(DEBUG_GCODE_PARSER)
+    static void _parser_debug();
+  #endif
+
   static void G0_G1(
     #if IS_SCARA || defined(G0_FEEDRATE)
       bool fast_move=false
@@ -592,6 +652,14 @@ private:
     static void M155();
   #endif
 
+  #if ENABLED(BINARY_TELEMETRY)
+    static void M156();
+  #endif
+
+  #if ENABLED(THERMAL_HISTORY)
+    static void M157();
+  #endif
+
   #if ENABLED(MIXING_EXTRUDER)
     static void M163();
     static void M164();
@@ -684,6 +752,10 @@ private:
     static void M304();
   #endif
 
+  #if ENABLED(EXTRUSION_FEEDFORWARD)
+    static void M309();
+  #endif
+
   #if HAS_MICROSTEPS
     static void M350();
     static void M351();
@@ -76,6 +76,13 @@ void GcodeSuite::M115() {
       #endif
     );
 
+    // BINARY_TELEMETRY (M156)
+    cap_line(PSTR("BINARY_TELEMETRY")
+      #if ENABLED(BINARY_TELEMETRY)
+        , true
+      #endif
+    );
+
     // PROGRESS (M530 S L, M531 <file>, M532 X L)
     cap_line(PSTR("PROGRESS"));
 
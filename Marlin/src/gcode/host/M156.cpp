@@ -0,0 +1,63 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(BINARY_TELEMETRY)
+
+#include "../gcode.h"
+#include "../../feature/telemetry.h"
+
+/**
+ * M156: Set binary telemetry report intervals, in milliseconds
+ *
+ *  T<ms> - Temperatures, heater power and fan speeds
+ *  P<ms> - Position, feedrate and planner queue depth
+ *  S<ms> - Print job state and progress
+ *
+ * An interval of 0 stops the channel. Frames are sent to the port
+ * that sent the last M156. With no parameters report the intervals.
+ */
+void GcodeSuite::M156() {
+  static const char channel_param[TELEMETRY_CHANNELS] PROGMEM = { 'T', 'P', 'S' };
+
+  bool changed = false;
+  for (uint8_t ch = 0; ch < TELEMETRY_CHANNELS; ch++)
+    if (parser.seenval(pgm_read_byte(&channel_param[ch]))) {
+      telemetry.set_interval((TelemetryChannel)ch, parser.value_ushort());
+      changed = true;
+    }
+
+  if (changed) {
+    #if NUM_SERIAL > 1
+      telemetry.port = serial_port_index;
+    #endif
+    return;
+  }
+
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR("M156 T", telemetry.interval_ms[TELEMETRY_THERMAL]);
+  SERIAL_ECHOPAIR(" P", telemetry.interval_ms[TELEMETRY_POSITION]);
+  SERIAL_ECHOLNPAIR(" S", telemetry.interval_ms[TELEMETRY_STATUS]);
+}
+
+#endif // BINARY_TELEMETRY
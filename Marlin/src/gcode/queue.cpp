@@ -70,6 +70,14 @@ char command_queue[BUFSIZE][MAX_CMD_SIZE];
   int16_t command_queue_port[BUFSIZE];
 #endif
 
+/*
+ * The SD file position of each command, or NO_SDPOS if it wasn't read from the SD card
+ */
+#if ENABLED(POWER_LOSS_JOURNAL)
+  uint32_t command_queue_sdpos[BUFSIZE];
+  static uint32_t commit_sdpos = NO_SDPOS; // Set by the SD reader for the line it commits
+#endif
+
 /**
  * Serial command injection
  */
@@ -77,6 +85,13 @@ char command_queue[BUFSIZE][MAX_CMD_SIZE];
 // Number of characters read in the current line of serial input
 static int serial_count[NUM_SERIAL] = { 0 };
 
+// The current line of serial input, when read one character at a time
+static char serial_line_buffer[NUM_SERIAL][MAX_CMD_SIZE];
+
+#if NO_TIMEOUTS > 0
+  static millis_t last_command_time = 0;
+#endif
+
 bool send_ok[BUFSIZE];
 
 /**
@@ -110,6 +125,10 @@ inline void _commit_command(bool say_ok
   #if NUM_SERIAL > 1
     command_queue_port[cmd_queue_index_w] = port;
   #endif
+  #if ENABLED(POWER_LOSS_JOURNAL)
+    command_queue_sdpos[cmd_queue_index_w] = commit_sdpos;
+    commit_sdpos = NO_SDPOS;
+  #endif
   if (++cmd_queue_index_w >= BUFSIZE) cmd_queue_index_w = 0;
   commands_in_queue++;
 }
@@ -215,16 +234,9 @@ void enqueue_and_echo_commands_P(PGM_P const pgcode) {
  *   P<int>  Planner space remaining
  *   B<int>  Block queue space remaining
  */
-void ok_to_send() {
-  #if NUM_SERIAL > 1
-    const int16_t port = command_queue_port[cmd_queue_index_r];
-    if (port < 0) return;
-    PORT_REDIRECT(port);
-  #endif
-  if (!send_ok[cmd_queue_index_r]) return;
+inline void _ok_to_send(const char* p) {
   SERIAL_ECHOPGM(MSG_OK);
   #if ENABLED(ADVANCED_OK)
-    char* p = command_queue[cmd_queue_index_r];
     if (*p == 'N') {
       SERIAL_ECHO(' ');
       SERIAL_ECHO(*p++);
@@ -233,10 +245,23 @@ void ok_to_send() {
     }
     SERIAL_ECHOPGM(" P"); SERIAL_ECHO(int(BLOCK_BUFFER_SIZE - planner.movesplanned() - 1));
     SERIAL_ECHOPGM(" B"); SERIAL_ECHO(BUFSIZE - commands_in_queue);
+  #else
+    UNUSED(p);
   #endif
   SERIAL_EOL();
 }
 
+// Send an "ok" for the command at the head of the queue
+void ok_to_send() {
+  #if NUM_SERIAL > 1
+    const int16_t port = command_queue_port[cmd_queue_index_r];
+    if (port < 0) return;
+    PORT_REDIRECT(port);
+  #endif
+  if (!send_ok[cmd_queue_index_r]) return;
+  _ok_to_send(command_queue[cmd_queue_index_r]);
+}
+
 /**
  * Send a "Resend: nnn" message to the host to
  * indicate that a command needs to be re-sent.
@@ -262,6 +287,16 @@ inline bool serial_data_available() {
   ;
 }
 
+inline bool serial_data_available(const uint8_t index) {
+  switch (index) {
+    case 0: return MYSERIAL0.available();
+    #if NUM_SERIAL > 1
+      case 1: return MYSERIAL1.available();
+    #endif
+    default: return false;
+  }
+}
+
 inline int read_serial(const uint8_t index) {
   switch (index) {
     case 0: return MYSERIAL0.read();
@@ -284,16 +319,6 @@ void gcode_line_error(PGM_P const err, const int8_t port) {
 
 #if ENABLED(BINARY_FILE_TRANSFER)
 
-  inline bool serial_data_available(const uint8_t index) {
-    switch (index) {
-      case 0: return MYSERIAL0.available();
-      #if NUM_SERIAL > 1
-        case 1: return MYSERIAL1.available();
-      #endif
-      default: return false;
-    }
-  }
-
   class BinaryStream {
   public:
     enum class StreamState : uint8_t {
@@ -398,6 +423,9 @@ void gcode_line_error(PGM_P const err, const int8_t port) {
               stream_state = StreamState::PACKET_RESET;
               bytes_received = 0;
               time_stream_start = millis();
+              #if ENABLED(SD_STREAMING_WRITES)
+                card.preallocate(stream_header.filesize);
+              #endif
               SERIAL_ECHOPAIR("echo: Datastream initialized (", stream_header.filesize);
               SERIAL_ECHOLNPGM(" bytes expected)");
               SERIAL_ECHOLNPAIR("so", buffer_size); // confirm active stream and the maximum block size supported
@@ -537,13 +565,291 @@ FORCE_INLINE bool is_M29(const char * const cmd) {
   return cmd[0] == 'M' && cmd[1] == '2' && cmd[2] == '9' && !WITHIN(cmd[3], '0', '9');
 }
 
+#if ENABLED(PRIORITY_COMMANDS)
+
+  // A complete line is held here for each port while the queue is full
+  static bool serial_line_parked[NUM_SERIAL] = { false };
+
+  // Set while a priority command runs, to prevent re-entry from idle()
+  static bool priority_command_busy = false;
+
+  /**
+   * Priority commands are non-motion, non-blocking commands that are safe to
+   * run out of order, ahead of the commands already waiting in the queue.
+   * They are flagged CMD_PRIORITY in the G-code dispatch table.
+   * Return the command flags of a priority command, or 0 for any other line.
+   */
+  static uint8_t priority_command_flags(const char *cmd) {
+    #if ENABLED(SDSUPPORT)
+      if (card.flag.saving) return 0;         // Lines are being written to a file
+    #endif
+    if (*cmd == 'N') {                        // Skip the line number
+      do ++cmd; while (NUMERIC_SIGNED(*cmd));
+      while (*cmd == ' ') ++cmd;
+    }
+    const char letter = *cmd;
+    if ((letter != 'G' && letter != 'M') || !NUMERIC(cmd[1])) return 0;
+    char *end;
+    const uint16_t code = strtoul(cmd + 1, &end, 10);
+    if (*end == '.') return 0;                // No subcodes in the lane
+    GcodeSuite::CommandInfo info;
+    if (!GcodeSuite::command_info(letter, code, info) || !(info.flags & GcodeSuite::CMD_PRIORITY)) return 0;
+    if (info.flags & (GcodeSuite::CMD_MOTION | GcodeSuite::CMD_BLOCKING)) return 0; // Must wait its turn
+    return info.flags;
+  }
+
+  /**
+   * Run a priority command right away and acknowledge it,
+   * unless the handler sends its own "ok" (as M105 does).
+   */
+  static void process_priority_command(char * const cmd, const uint8_t port, const uint8_t flags) {
+    PORT_REDIRECT(port);
+    priority_command_busy = true;
+    gcode.process_priority_command(cmd);
+    if (!(flags & GcodeSuite::CMD_NO_OK)) _ok_to_send(cmd);
+    priority_command_busy = false;
+  }
+
+#endif // PRIORITY_COMMANDS
+
+#if HAS_SERIAL_RX_RING
+
+  /**
+   * The serial RX ring is scanned in place for complete lines, which are
+   * copied once, without comments, straight into the command queue.
+   * A line too long to fit in the ring is read one character at a time.
+   */
+  static bool rx_bytewise[NUM_SERIAL] = { false };
+
+  inline uint16_t serial_rx_run(const uint8_t index, const uint16_t offset, const uint8_t* &ptr) {
+    switch (index) {
+      #if NUM_SERIAL > 1
+        case 1: return MYSERIAL1.rx_run(offset, ptr);
+      #endif
+      default: return MYSERIAL0.rx_run(offset, ptr);
+    }
+  }
+
+  inline void serial_rx_discard(const uint8_t index, const uint16_t count) {
+    switch (index) {
+      #if NUM_SERIAL > 1
+        case 1: MYSERIAL1.rx_discard(count); break;
+      #endif
+      default: MYSERIAL0.rx_discard(count); break;
+    }
+  }
+
+  inline bool serial_rx_full(const uint8_t index) {
+    switch (index) {
+      #if NUM_SERIAL > 1
+        case 1: return MYSERIAL1.rx_full();
+      #endif
+      default: return MYSERIAL0.rx_full();
+    }
+  }
+
+  /**
+   * Find the end of the next line in the RX ring of a serial port.
+   * Return the line length, not including the EOL, or -1 if incomplete.
+   */
+  inline int16_t find_serial_line(const uint8_t i) {
+    const uint8_t *run;
+    uint16_t offset = 0;
+    while (const uint16_t n = serial_rx_run(i, offset, run)) {
+      for (uint16_t k = 0; k < n; ++k)
+        if (run[k] == '\n' || run[k] == '\r') return offset + k;
+      offset += n;
+    }
+    return -1;
+  }
+
+  /**
+   * Copy a line of 'len' characters from the RX ring into 'dst', stripping
+   * comments, escapes and leading spaces, then drop the line and its EOL.
+   */
+  inline void copy_serial_line(const uint8_t i, uint16_t len, char * const dst) {
+    bool comment = false, escape = false;
+    #if ENABLED(PAREN_COMMENTS)
+      bool paren = false;
+    #endif
+    uint8_t count = 0;
+    uint16_t offset = 0;
+    while (len) {
+      const uint8_t *run;
+      const uint16_t n = MIN(serial_rx_run(i, offset, run), len);
+      for (uint16_t k = 0; k < n; ++k) {
+        const char c = run[k];
+        if (escape)
+          escape = false;                           // Keep an escaped character
+        else if (c == '\\') { escape = true; continue; }
+        else if (c == ';') { comment = true; continue; }
+        #if ENABLED(PAREN_COMMENTS)
+          else if (c == '(') { paren = true; continue; }
+          else if (c == ')') { paren = false; continue; }
+        #endif
+        else if (c == ' ' && !count) continue;      // Skip leading spaces
+        if (!comment
+          #if ENABLED(PAREN_COMMENTS)
+            && !paren
+          #endif
+          && count < MAX_CMD_SIZE - 1
+        ) dst[count++] = c;
+      }
+      offset += n;
+      len -= n;
+    }
+    dst[count] = '\0';
+    serial_rx_discard(i, offset + 1);
+  }
+
+#endif // HAS_SERIAL_RX_RING
+
+/**
+ * Return whether characters should be read one at a time from a port
+ */
+inline bool serial_reads_chars(const uint8_t i) {
+  #if ENABLED(PRIORITY_COMMANDS)
+    if (serial_line_parked[i]) return false;
+  #endif
+  #if HAS_SERIAL_RX_RING
+    if (!rx_bytewise[i]) return false;
+  #endif
+  UNUSED(i);
+  return true;
+}
+
+inline bool serial_chars_available() {
+  for (uint8_t i = 0; i < NUM_SERIAL; ++i)
+    if (serial_reads_chars(i) && serial_data_available(i)) return true;
+  return false;
+}
+
+/**
+ * Handle a complete line of serial input. Check its line number and
+ * checksum, then run it now (a priority command), queue it, or hold it.
+ * The line may already be in place in the next free queue slot.
+ * Return false after a line error, when the rest of the input is flushed.
+ */
+inline bool process_serial_line(char * const line, const uint8_t i) {
+  char* command = line;
+
+  while (*command == ' ') command++;                // Skip leading spaces
+  char *npos = (*command == 'N') ? command : NULL;  // Require the N parameter to start the line
+
+  if (npos) {
+
+    bool M110 = strstr_P(command, PSTR("M110")) != NULL;
+
+    if (M110) {
+      char* n2pos = strchr(command + 4, 'N');
+      if (n2pos) npos = n2pos;
+    }
+
+    gcode_N = strtol(npos + 1, NULL, 10);
+
+    if (gcode_N != gcode_LastN + 1 && !M110) {
+      gcode_line_error(PSTR(MSG_ERR_LINE_NO), i);
+      return false;
+    }
+
+    char *apos = strrchr(command, '*');
+    if (apos) {
+      uint8_t checksum = 0, count = uint8_t(apos - command);
+      while (count) checksum ^= command[--count];
+      if (strtol(apos + 1, NULL, 10) != checksum) {
+        gcode_line_error(PSTR(MSG_ERR_CHECKSUM_MISMATCH), i);
+        return false;
+      }
+    }
+    else {
+      gcode_line_error(PSTR(MSG_ERR_NO_CHECKSUM), i);
+      return false;
+    }
+
+    gcode_LastN = gcode_N;
+  }
+  #if ENABLED(SDSUPPORT)
+    // Pronterface "M29" and "M29 " has no line number
+    else if (card.flag.saving && !is_M29(command)) {
+      gcode_line_error(PSTR(MSG_ERR_NO_CHECKSUM), i);
+      return false;
+    }
+  #endif
+
+  // Movement commands alert when stopped
+  if (IsStopped()) {
+    char* gpos = strchr(command, 'G');
+    if (gpos) {
+      switch (strtol(gpos + 1, NULL, 10)) {
+        case 0:
+        case 1:
+        #if ENABLED(ARC_SUPPORT)
+          case 2:
+          case 3:
+        #endif
+        #if ENABLED(BEZIER_CURVE_SUPPORT)
+          case 5:
+        #endif
+          SERIAL_ECHOLNPGM(MSG_ERR_STOPPED);
+          LCD_MESSAGEPGM(MSG_STOPPED);
+          break;
+      }
+    }
+  }
+
+  #if DISABLED(EMERGENCY_PARSER)
+    // Process critical commands early
+    if (strcmp(command, "M108") == 0) {
+      wait_for_heatup = false;
+      #if HAS_LCD_MENU
+        wait_for_user = false;
+      #endif
+    }
+    if (strcmp(command, "M112") == 0) kill();
+    if (strcmp(command, "M410") == 0) quickstop_stepper();
+  #endif
+
+  #if NO_TIMEOUTS > 0
+    last_command_time = millis();
+  #endif
+
+  #if ENABLED(PRIORITY_COMMANDS)
+    // Run priority commands now, ahead of the queue
+    const uint8_t flags = priority_command_flags(command);
+    if (flags) {
+      process_priority_command(command, i, flags);
+      return true;
+    }
+    // Hold this line until the queue has room
+    if (commands_in_queue >= BUFSIZE) {
+      serial_line_parked[i] = true;
+      return true;
+    }
+  #endif
+
+  // Add the command to the queue
+  if (line == command_queue[cmd_queue_index_w])     // Already in place?
+    _commit_command(true
+      #if NUM_SERIAL > 1
+        , i
+      #endif
+    );
+  else
+    _enqueuecommand(line, true
+      #if NUM_SERIAL > 1
+        , i
+      #endif
+    );
+
+  return true;
+}
+
 /**
  * Get all commands waiting on the serial port and queue them.
  * Exit when the buffer is full or when no more characters are
  * left on the serial port.
  */
 inline void get_serial_commands() {
-  static char serial_line_buffer[NUM_SERIAL][MAX_CMD_SIZE];
   static bool serial_comment_mode[NUM_SERIAL] = { false }
               #if ENABLED(PAREN_COMMENTS)
                 , serial_comment_paren_mode[NUM_SERIAL] = { false }
@@ -565,7 +871,6 @@ inline void get_serial_commands() {
   // If the command buffer is empty for too long,
   // send "wait" to indicate Marlin is still waiting.
   #if NO_TIMEOUTS > 0
-    static millis_t last_command_time = 0;
     const millis_t ms = millis();
     if (commands_in_queue == 0 && !serial_data_available() && ELAPSED(ms, last_command_time + NO_TIMEOUTS)) {
       SERIAL_ECHOLNPGM(MSG_WAIT);
@@ -573,13 +878,65 @@ inline void get_serial_commands() {
     }
   #endif
 
+  #if ENABLED(PRIORITY_COMMANDS)
+    // Queue any lines that were parked while the queue was full
+    for (uint8_t i = 0; i < NUM_SERIAL; ++i)
+      if (serial_line_parked[i] && commands_in_queue < BUFSIZE) {
+        serial_line_parked[i] = false;
+        _enqueuecommand(serial_line_buffer[i], true
+          #if NUM_SERIAL > 1
+            , i
+          #endif
+        );
+      }
+  #endif
+
+  #if HAS_SERIAL_RX_RING
+    /**
+     * Take complete lines from the RX ring while the queue has room.
+     * With PRIORITY_COMMANDS keep taking lines while the queue is full,
+     * so that priority commands can bypass it, and park other lines.
+     */
+    for (uint8_t i = 0; i < NUM_SERIAL; ++i) {
+      while (!rx_bytewise[i]
+        #if ENABLED(PRIORITY_COMMANDS)
+          && !serial_line_parked[i]
+        #endif
+      ) {
+        const int16_t len = find_serial_line(i);
+        if (len < 0) {
+          if (serial_rx_full(i)) rx_bytewise[i] = true;
+          break;
+        }
+        char *line;
+        if (commands_in_queue < BUFSIZE)
+          line = command_queue[cmd_queue_index_w];
+        else {
+          #if ENABLED(PRIORITY_COMMANDS)
+            line = serial_line_buffer[i];
+          #else
+            break;
+          #endif
+        }
+        copy_serial_line(i, len, line);
+        if (*line && !process_serial_line(line, i)) return;
+      }
+    }
+  #endif
+
   /**
-   * Loop while serial characters are incoming and the queue is not full
+   * Loop while serial characters are incoming and the queue is not full.
+   * With PRIORITY_COMMANDS keep reading while the queue is full.
    */
-  while (commands_in_queue < BUFSIZE && serial_data_available()) {
+  while (
+    #if DISABLED(PRIORITY_COMMANDS)
+      commands_in_queue < BUFSIZE &&
+    #endif
+    serial_chars_available()
+  ) {
     for (uint8_t i = 0; i < NUM_SERIAL; ++i) {
       int c;
-      if ((c = read_serial(i)) < 0) continue;
+      if (!serial_reads_chars(i) || (c = read_serial(i)) < 0) continue;
 
       char serial_char = c;
 
@@ -594,92 +951,17 @@ inline void get_serial_commands() {
           serial_comment_paren_mode[i] = false;
         #endif
 
+        #if HAS_SERIAL_RX_RING
+          rx_bytewise[i] = false;                         // Back to whole lines
+        #endif
+
         // Skip empty lines and comments
         if (!serial_count[i]) { thermalManager.manage_heater(); continue; }
 
         serial_line_buffer[i][serial_count[i]] = 0;       // Terminate string
         serial_count[i] = 0;                              // Reset buffer
 
-        char* command = serial_line_buffer[i];
-
-        while (*command == ' ') command++;                // Skip leading spaces
-        char *npos = (*command == 'N') ? command : NULL;  // Require the N parameter to start the line
-
-        if (npos) {
-
-          bool M110 = strstr_P(command, PSTR("M110")) != NULL;
-
-          if (M110) {
-            char* n2pos = strchr(command + 4, 'N');
-            if (n2pos) npos = n2pos;
-          }
-
-          gcode_N = strtol(npos + 1, NULL, 10);
-
-          if (gcode_N != gcode_LastN + 1 && !M110)
-            return gcode_line_error(PSTR(MSG_ERR_LINE_NO), i);
-
-          char *apos = strrchr(command, '*');
-          if (apos) {
-            uint8_t checksum = 0, count = uint8_t(apos - command);
-            while (count) checksum ^= command[--count];
-            if (strtol(apos + 1, NULL, 10) != checksum)
-              return gcode_line_error(PSTR(MSG_ERR_CHECKSUM_MISMATCH), i);
-          }
-          else
-            return gcode_line_error(PSTR(MSG_ERR_NO_CHECKSUM), i);
-
-          gcode_LastN = gcode_N;
-        }
-        #if ENABLED(SDSUPPORT)
-          // Pronterface "M29" and "M29 " has no line number
-          else if (card.flag.saving && !is_M29(command))
-            return gcode_line_error(PSTR(MSG_ERR_NO_CHECKSUM), i);
-        #endif
-
-        // Movement commands alert when stopped
-        if (IsStopped()) {
-          char* gpos = strchr(command, 'G');
-          if (gpos) {
-            switch (strtol(gpos + 1, NULL, 10)) {
-              case 0:
-              case 1:
-              #if ENABLED(ARC_SUPPORT)
-                case 2:
-                case 3:
-              #endif
-              #if ENABLED(BEZIER_CURVE_SUPPORT)
-                case 5:
-              #endif
-                SERIAL_ECHOLNPGM(MSG_ERR_STOPPED);
-                LCD_MESSAGEPGM(MSG_STOPPED);
-                break;
-            }
-          }
-        }
-
-        #if DISABLED(EMERGENCY_PARSER)
-          // Process critical commands early
-          if (strcmp(command, "M108") == 0) {
-            wait_for_heatup = false;
-            #if HAS_LCD_MENU
-              wait_for_user = false;
-            #endif
-          }
-          if (strcmp(command, "M112") == 0) kill();
-          if (strcmp(command, "M410") == 0) quickstop_stepper();
-        #endif
-
-        #if defined(NO_TIMEOUTS) && NO_TIMEOUTS > 0
-          last_command_time = ms;
-        #endif
-
-        // Add the command to the queue
-        _enqueuecommand(serial_line_buffer[i], true
-          #if NUM_SERIAL > 1
-            , i
-          #endif
-        );
+        if (!process_serial_line(serial_line_buffer[i], i)) return;
       }
       else if (serial_count[i] >= MAX_CMD_SIZE - 1) {
         // Keep fetching, but ignore normal characters beyond the max length
@@ -736,71 +1018,47 @@ inline void get_serial_commands() {
 
     if (commands_in_queue == 0) stop_buffering = false;
 
+    LULZBOT_SDCARD_CHECK_INIT
+
     uint16_t sd_count = 0;
-    bool card_eof = card.eof();
+    bool card_eof = false;
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      uint32_t line_sdpos = card.getIndex(); // Buffering always starts on a new line
+    #endif
     while (commands_in_queue < BUFSIZE && !card_eof && !stop_buffering) {
-      const int16_t n = card.get();
-      char sd_char = (char)n;
-      card_eof = card.eof();
-      LULZBOT_SDCARD_CHECK_BYTE(n)
-      if (card_eof || n == -1
-          || sd_char == '\n' || sd_char == '\r'
-          || ((sd_char == '#' || sd_char == ':') && !sd_comment_mode
-            #if ENABLED(PAREN_COMMENTS)
-              && !sd_comment_paren_mode
-            #endif
-          )
-      ) {
-        if (card_eof) {
-
-          card.printingHasFinished();
-
-          if (IS_SD_PRINTING())
-            sd_count = 0; // If a sub-file was printing, continue from call point
-          else {
-            SERIAL_ECHOLNPGM(MSG_FILE_PRINTED);
-            #if ENABLED(PRINTER_EVENT_LEDS)
-              printerEventLEDs.onPrintCompleted();
-              #if HAS_RESUME_CONTINUE
-                enqueue_and_echo_commands_P(PSTR("M0 S"
-                  #if HAS_LCD_MENU
-                    "1800"
-                  #else
-                    "60"
-                  #endif
-                ));
-              #endif
-            #endif // PRINTER_EVENT_LEDS
-          }
-        }
-        else if (n == -1)
-          SERIAL_ERROR_MSG(MSG_SD_ERR_READ);
-
-        if (sd_char == '#') stop_buffering = true;
-
-        sd_comment_mode = false; // for new command
-        #if ENABLED(PAREN_COMMENTS)
-          sd_comment_paren_mode = false;
-        #endif
-
-        // Skip empty lines and comments
-        if (!sd_count) { thermalManager.manage_heater(); continue; }
 
-        command_queue[cmd_queue_index_w][sd_count] = '\0'; // terminate string
-        sd_count = 0; // clear sd line buffer
-
-        LULZBOT_SDCARD_COMMAND_DONE(command_queue[cmd_queue_index_w])
-
-        _commit_command(false);
+      // Scan the bytes read from the file for the end of the line,
+      // copying everything outside of comments into the queue.
+      const char *span;
+      const int16_t n = card.get_span(span);
+      if (n < 0) {
+        SERIAL_ERROR_MSG(MSG_SD_ERR_READ);
+        break;
       }
-      else if (sd_count >= MAX_CMD_SIZE - 1) {
-        /**
-         * Keep fetching, but ignore normal characters beyond the max length
-         * The command will be injected when EOL is reached
-         */
-      }
-      else {
-        if (sd_char == ';') sd_comment_mode = true;
+
+      char sd_char = '\0';
+      bool eol = false;
+      int16_t i = 0;
+      for (; i < n; i++) {
+        sd_char = span[i];
+        LULZBOT_SDCARD_CHECK_BYTE(uint8_t(sd_char))
+        if (sd_char == '\n' || sd_char == '\r'
+            || ((sd_char == '#' || sd_char == ':') && !sd_comment_mode
+              #if ENABLED(PAREN_COMMENTS)
+                && !sd_comment_paren_mode
+              #endif
+            )
+        ) {
+          eol = true;
+          break;
+        }
+        else if (sd_count >= MAX_CMD_SIZE - 1) {
+          /**
+           * Keep fetching, but ignore normal characters beyond the max length
+           * The command will be injected when EOL is reached
+           */
+        }
+        else if (sd_char == ';') sd_comment_mode = true;
         #if ENABLED(PAREN_COMMENTS)
           else if (sd_char == '(') sd_comment_paren_mode = true;
           else if (sd_char == ')') sd_comment_paren_mode = false;
@@ -811,11 +1069,87 @@ inline void get_serial_commands() {
           #endif
         ) command_queue[cmd_queue_index_w][sd_count++] = sd_char;
       }
+
+      card.consume(i + eol);                    // The line so far, with its terminator
+
+      if (n && !eol) continue;                  // The line goes on in the next span
+
+      #if ENABLED(POWER_LOSS_JOURNAL)
+        const uint32_t command_sdpos = line_sdpos;
+        line_sdpos = card.getIndex();
+      #endif
+
+      if (!n) {                                 // End of the file
+        card_eof = true;
+
+        card.printingHasFinished();
+
+        if (IS_SD_PRINTING())
+          sd_count = 0; // If a sub-file was printing, continue from call point
+        else {
+          SERIAL_ECHOLNPGM(MSG_FILE_PRINTED);
+          #if ENABLED(PRINTER_EVENT_LEDS)
+            printerEventLEDs.onPrintCompleted();
+            #if HAS_RESUME_CONTINUE
+              enqueue_and_echo_commands_P(PSTR("M0 S"
+                #if HAS_LCD_MENU
+                  "1800"
+                #else
+                  "60"
+                #endif
+              ));
+            #endif
+          #endif // PRINTER_EVENT_LEDS
+        }
+      }
+
+      if (sd_char == '#') stop_buffering = true;
+
+      sd_comment_mode = false; // for new command
+      #if ENABLED(PAREN_COMMENTS)
+        sd_comment_paren_mode = false;
+      #endif
+
+      // Skip empty lines and comments
+      if (!sd_count) { thermalManager.manage_heater(); continue; }
+
+      command_queue[cmd_queue_index_w][sd_count] = '\0'; // terminate string
+      sd_count = 0; // clear sd line buffer
+
+      LULZBOT_SDCARD_COMMAND_DONE(command_queue[cmd_queue_index_w])
+
+      #if ENABLED(POWER_LOSS_JOURNAL)
+        commit_sdpos = command_sdpos;
+      #endif
+      _commit_command(false);
     }
+
+    #if ENABLED(SD_STREAMING_READS)
+      card.prefetch(); // Read ahead while the queue is busy
+    #endif
   }
 
 #endif // SDSUPPORT
 
+#if ENABLED(PRIORITY_COMMANDS)
+
+  /**
+   * Read serial input while a command is in progress. Called from idle().
+   */
+  void get_priority_commands() {
+    if (priority_command_busy) return;
+    #if ENABLED(SDSUPPORT)
+      if (card.flag.saving) return;
+    #endif
+
+    // Keep serial commands behind any pending injected commands
+    if (drain_injected_commands_P()) return;
+
+    get_serial_commands();
+  }
+
+#endif
+
 /**
  * Add to the circular command queue the next command from:
  *  - The command-injection queue (injected_commands_P)
@@ -56,6 +56,14 @@ extern char command_queue[BUFSIZE][MAX_CMD_SIZE];
   extern int16_t command_queue_port[BUFSIZE];
 #endif
 
+/*
+ * The SD file position of each command, or NO_SDPOS if it wasn't read from the SD card
+ */
+#if ENABLED(POWER_LOSS_JOURNAL)
+  #define NO_SDPOS 0xFFFFFFFFUL
+  extern uint32_t command_queue_sdpos[BUFSIZE];
+#endif
+
 /**
  * Initialization of queue for setup()
  */
@@ -119,6 +127,14 @@ bool enqueue_and_echo_command(const char* cmd);
  */
 void get_available_commands();
 
+#if ENABLED(PRIORITY_COMMANDS)
+  /**
+   * Read serial input while a command is in progress, running
+   * priority commands immediately and queueing or holding the rest
+   */
+  void get_priority_commands();
+#endif
+
 /**
  * Get the next command in the queue, optionally log it to SD, then dispatch it
  */
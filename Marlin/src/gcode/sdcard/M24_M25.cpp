@@ -44,7 +44,10 @@
 void GcodeSuite::M24() {
 
   #if ENABLED(POWER_LOSS_RECOVERY)
-    if (parser.seenval('S')) card.setIndex(parser.value_long());
+    if (parser.seenval('S') && !card.setIndex(parser.value_long())) {
+      SERIAL_ERROR_MSG(MSG_SD_ERR_SEEK);
+      return;
+    }
     if (parser.seenval('T')) print_job_timer.resume(parser.value_long());
   #endif
 
@@ -31,8 +31,8 @@
  * M26: Set SD Card file index
  */
 void GcodeSuite::M26() {
-  if (card.isDetected() && parser.seenval('S'))
-    card.setIndex(parser.value_long());
+  if (card.isDetected() && parser.seenval('S') && !card.setIndex(parser.value_long()))
+    SERIAL_ERROR_MSG(MSG_SD_ERR_SEEK);
 }
 
 #endif // SDSUPPORT
@@ -47,7 +47,10 @@ void GcodeSuite::M32() {
 
     card.openFile(parser.string_arg, true, call_procedure);
 
-    if (parser.seenval('S')) card.setIndex(parser.value_long());
+    if (parser.seenval('S') && !card.setIndex(parser.value_long())) {
+      SERIAL_ERROR_MSG(MSG_SD_ERR_SEEK);
+      return;
+    }
 
     card.startFileprint();
 
@@ -84,6 +84,7 @@ void GcodeSuite::M104() {
 /**
  * M109: Sxxx Wait for extruder(s) to reach temperature. Waits only when heating.
  *       Rxxx Wait for extruder(s) to reach temperature. Waits when heating and cooling.
+ *       D    Defer the wait to the next extruding move. (Requires TEMPERATURE_BARRIERS)
  */
 void GcodeSuite::M109() {
 
@@ -135,6 +136,10 @@ void GcodeSuite::M109() {
     planner.autotemp_M104_M109();
   #endif
 
-  if (set_temp)
+  if (set_temp) {
+    #if ENABLED(TEMPERATURE_BARRIERS)
+      if (parser.seen('D')) return thermalManager.set_barrier(target_extruder, no_wait_for_cooling);
+    #endif
     (void)thermalManager.wait_for_hotend(target_extruder, no_wait_for_cooling);
+  }
 }
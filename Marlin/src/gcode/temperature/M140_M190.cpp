@@ -50,6 +50,7 @@ void GcodeSuite::M140() {
 /**
  * M190: Sxxx Wait for bed current temp to reach target temp. Waits only when heating
  *       Rxxx Wait for bed current temp to reach target temp. Waits when heating and cooling
+ *       D    Defer the wait to the next extruding move. (Requires TEMPERATURE_BARRIERS)
  */
 void GcodeSuite::M190() {
   if (DEBUGGING(DRYRUN)) return;
@@ -64,6 +65,10 @@ void GcodeSuite::M190() {
   }
   else return;
 
+  #if ENABLED(TEMPERATURE_BARRIERS)
+    if (parser.seen('D')) return thermalManager.set_barrier(-1, no_wait_for_cooling);
+  #endif
+
   ui.set_status_P(thermalManager.isHeatingBed() ? PSTR(MSG_BED_HEATING) : PSTR(MSG_BED_COOLING));
 
   thermalManager.wait_for_bed(no_wait_for_cooling);
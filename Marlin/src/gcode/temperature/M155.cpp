@@ -29,9 +29,20 @@
 
 /**
  * M155: Set temperature auto-report interval. M155 S<seconds>
+ *
+ * With AUTO_REPORT_TEMPERATURE_CHANGES, reports are sent when temperatures
+ * change and S sets the longest time between reports.
+ *
+ *  D<degrees> Smallest temperature change to report
+ *  C<bool>    Use the compact report format
  */
 void GcodeSuite::M155() {
 
+  #if ENABLED(AUTO_REPORT_TEMPERATURE_CHANGES)
+    if (parser.seenval('D')) thermalManager.auto_report_delta = MAX(parser.value_celsius_diff(), 0);
+    if (parser.seen('C')) thermalManager.auto_report_compact = parser.value_bool();
+  #endif
+
   if (parser.seenval('S'))
     thermalManager.set_auto_report_interval(parser.value_byte());
 
@@ -0,0 +1,49 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../inc/MarlinConfig.h"
+
+#if ENABLED(THERMAL_HISTORY)
+
+#include "../gcode.h"
+#include "../../feature/thermal_history.h"
+
+/**
+ * M157: Report or configure the thermal history
+ *
+ *  S<ms> - Set the sample interval and clear the history. S0 stops sampling.
+ *  C     - Clear the history
+ *
+ * With no parameters report every sample, oldest first. Each line has the
+ * time in ms relative to the newest sample, then each heater's temperature,
+ * target and power, as in M105.
+ */
+void GcodeSuite::M157() {
+  if (parser.seenval('S'))
+    thermal_history.set_interval(parser.value_ushort());
+  else if (parser.seen('C'))
+    thermal_history.clear();
+  else
+    thermal_history.report();
+}
+
+#endif // THERMAL_HISTORY
@@ -34,6 +34,7 @@
  *       E<extruder> (-1 for the bed) (default 0)
  *       C<cycles> Minimum 3. Default 5.
  *       U<bool> with a non-zero value will apply the result to current settings
+ *       F       Tune from a single step response instead. (Requires PID_AUTOTUNE_FOPDT)
  */
 void GcodeSuite::M303() {
 
@@ -61,7 +62,12 @@ void GcodeSuite::M303() {
     KEEPALIVE_STATE(NOT_BUSY);
   #endif
 
-  thermalManager.PID_autotune(temp, e, c, u);
+  #if ENABLED(PID_AUTOTUNE_FOPDT)
+    if (parser.seen('F'))
+      thermalManager.PID_autotune_fopdt(temp, e, u);
+    else
+  #endif
+      thermalManager.PID_autotune(temp, e, c, u);
 
   #if DISABLED(BUSY_WHILE_HEATING)
     KEEPALIVE_STATE(IN_HANDLER);
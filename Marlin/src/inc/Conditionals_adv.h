@@ -26,6 +26,11 @@
  * Defines that depend on advanced configuration.
  */
 
+// The Linux HAL backs the USB flash drive with a disk image instead of a USB host
+#if ENABLED(USB_FLASH_DRIVE_SUPPORT) && !defined(__PLAT_LINUX__)
+  #define USB_HOST_SUPPORT
+#endif
+
 #if !defined(__AVR__) || !defined(USBCON)
   // Define constants and variables for buffering serial data.
   // Use only 0 or powers of 2 greater than 1
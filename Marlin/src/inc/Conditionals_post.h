@@ -1071,8 +1071,11 @@
 #if !HAS_TEMP_SENSOR
   #undef AUTO_REPORT_TEMPERATURES
 #endif
+#if DISABLED(AUTO_REPORT_TEMPERATURES)
+  #undef AUTO_REPORT_TEMPERATURE_CHANGES
+#endif
 
-#define HAS_AUTO_REPORTING (ENABLED(AUTO_REPORT_TEMPERATURES) || ENABLED(AUTO_REPORT_SD_STATUS))
+#define HAS_AUTO_REPORTING (ENABLED(AUTO_REPORT_TEMPERATURES) || ENABLED(AUTO_REPORT_SD_STATUS) || ENABLED(BINARY_TELEMETRY))
 
 /**
  * This setting is also used by M109 when trying to calculate
@@ -1145,6 +1148,41 @@
   #define WRITE_HEATER_BED(v) WRITE(HEATER_BED_PIN, (v) ^ HEATER_BED_INVERTING)
 #endif
 
+/**
+ * Heaters on hardware PWM are also switched fully on and off
+ * through analogWrite, so the timer doesn't override the pin.
+ */
+#define HAS_HARDWARE_PWM_HEATER (ENABLED(HEATER_0_HARDWARE_PWM) || ENABLED(HEATER_1_HARDWARE_PWM) || ENABLED(HEATER_2_HARDWARE_PWM) || ENABLED(HEATER_3_HARDWARE_PWM) || ENABLED(HEATER_4_HARDWARE_PWM) || ENABLED(HEATER_5_HARDWARE_PWM) || ENABLED(HEATER_BED_HARDWARE_PWM))
+#define WRITE_HEATER_PWM(N,v) analogWrite(HEATER_##N##_PIN, ((v) ^ HEATER_##N##_INVERTING) ? 255 : 0)
+#if ENABLED(HEATER_0_HARDWARE_PWM)
+  #undef WRITE_HEATER_0
+  #define WRITE_HEATER_0(v) WRITE_HEATER_PWM(0,v)
+#endif
+#if ENABLED(HEATER_1_HARDWARE_PWM)
+  #undef WRITE_HEATER_1
+  #define WRITE_HEATER_1(v) WRITE_HEATER_PWM(1,v)
+#endif
+#if ENABLED(HEATER_2_HARDWARE_PWM)
+  #undef WRITE_HEATER_2
+  #define WRITE_HEATER_2(v) WRITE_HEATER_PWM(2,v)
+#endif
+#if ENABLED(HEATER_3_HARDWARE_PWM)
+  #undef WRITE_HEATER_3
+  #define WRITE_HEATER_3(v) WRITE_HEATER_PWM(3,v)
+#endif
+#if ENABLED(HEATER_4_HARDWARE_PWM)
+  #undef WRITE_HEATER_4
+  #define WRITE_HEATER_4(v) WRITE_HEATER_PWM(4,v)
+#endif
+#if ENABLED(HEATER_5_HARDWARE_PWM)
+  #undef WRITE_HEATER_5
+  #define WRITE_HEATER_5(v) WRITE_HEATER_PWM(5,v)
+#endif
+#if ENABLED(HEATER_BED_HARDWARE_PWM)
+  #undef WRITE_HEATER_BED
+  #define WRITE_HEATER_BED(v) WRITE_HEATER_PWM(BED,v)
+#endif
+
 /**
  * Up to 3 PWM fans
  */
@@ -1652,6 +1690,18 @@
   #define HAS_FOLDER_SORTING (FOLDER_SORTING || ENABLED(SDSORT_GCODE))
 #endif
 
+#define HAS_SD_STREAMING (ENABLED(SD_STREAMING_READS) || ENABLED(SD_STREAMING_WRITES))
+
+// Blocks per USB bulk transfer
+#if ENABLED(USB_FLASH_DRIVE_SUPPORT) && !defined(USB_BULK_BLOCKS)
+  #define USB_BULK_BLOCKS 1
+#endif
+
+// Buffer for reading the file being printed, unless it's streamed
+#if ENABLED(SDSUPPORT) && DISABLED(SD_STREAMING_READS) && !defined(SD_READ_BUFFER_SIZE)
+  #define SD_READ_BUFFER_SIZE 64
+#endif
+
 // If platform requires early initialization of watchdog to properly boot
 #define EARLY_WATCHDOG (ENABLED(USE_WATCHDOG) && defined(ARDUINO_ARCH_SAM))
 
@@ -397,6 +397,20 @@
   #error "SERIAL_XON_XOFF and SERIAL_STATS_* features not supported on USB-native AVR devices."
 #endif
 
+#if ENABLED(BINARY_TELEMETRY) && ENABLED(SERIAL_XON_XOFF)
+  #error "BINARY_TELEMETRY is incompatible with SERIAL_XON_XOFF."
+#endif
+
+#if ENABLED(DEFERRED_SERIAL_OUTPUT)
+  #if !((defined(__AVR__) && !defined(USBCON)) || defined(ARDUINO_ARCH_SAM) || defined(__PLAT_LINUX__))
+    #error "DEFERRED_SERIAL_OUTPUT is only supported on AVR (not USBCON), DUE and LINUX."
+  #elif !defined(__PLAT_LINUX__) && TX_BUFFER_SIZE == 0
+    #error "DEFERRED_SERIAL_OUTPUT requires TX_BUFFER_SIZE > 0."
+  #elif !defined(DEFERRED_SERIAL_BUFFER_SIZE) || DEFERRED_SERIAL_BUFFER_SIZE < 16 || DEFERRED_SERIAL_BUFFER_SIZE > 4096 || !IS_POWER_OF_2(DEFERRED_SERIAL_BUFFER_SIZE)
+    #error "DEFERRED_SERIAL_BUFFER_SIZE must be a power of 2 from 16 to 4096."
+  #endif
+#endif
+
 #if SERIAL_PORT > 7
   #error "Set SERIAL_PORT to the port on your board. Usually this is 0."
 #endif
@@ -1306,6 +1320,14 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #error "You cannot set CONTROLLER_FAN_PIN equal to FAN_PIN."
 #endif
 
+#ifdef FAN_LEAD_TIME
+  #if FAN_COUNT == 0
+    #error "FAN_LEAD_TIME requires a part-cooling fan."
+  #elif !WITHIN(FAN_LEAD_TIME, 200, 10000)
+    #error "FAN_LEAD_TIME must be from 200 to 10000ms."
+  #endif
+#endif
+
 #if ENABLED(USE_CONTROLLER_FAN)
   #if !HAS_CONTROLLER_FAN
     #error "USE_CONTROLLER_FAN requires a CONTROLLER_FAN_PIN. Define in Configuration_adv.h."
@@ -2033,10 +2055,95 @@ static_assert(   _ARR_TEST(3,0) && _ARR_TEST(3,1) && _ARR_TEST(3,2)
   #error "PRINTCOUNTER requires EEPROM_SETTINGS. Please update your Configuration."
 #endif
 
-#if ENABLED(USB_FLASH_DRIVE_SUPPORT) && !(PIN_EXISTS(USB_CS) && PIN_EXISTS(USB_INTR))
+#if ENABLED(FLASH_EEPROM_LOG)
+  #if !defined(ARDUINO_ARCH_SAM) && !defined(__PLAT_LINUX__)
+    #error "FLASH_EEPROM_LOG is only supported on DUE and LINUX."
+  #elif DISABLED(EEPROM_SETTINGS)
+    #error "FLASH_EEPROM_LOG requires EEPROM_SETTINGS."
+  #elif ENABLED(I2C_EEPROM) || ENABLED(SPI_EEPROM)
+    #error "FLASH_EEPROM_LOG is incompatible with I2C_EEPROM and SPI_EEPROM."
+  #endif
+#endif
+
+#if ENABLED(CONTINUOUS_ADC) && !(defined(ARDUINO_ARCH_SAM) || defined(TARGET_LPC1768) || (defined(ARDUINO_ARCH_STM32) && !defined(STM32GENERIC)) || defined(__PLAT_LINUX__))
+  #error "CONTINUOUS_ADC is only supported on DUE, LPC1768, STM32 and LINUX."
+#endif
+
+#if ENABLED(EXTRUSION_FEEDFORWARD)
+  static_assert(DEFAULT_FEEDFORWARD_FLOW >= 0 && DEFAULT_FEEDFORWARD_FAN >= 0, "DEFAULT_FEEDFORWARD_FLOW and DEFAULT_FEEDFORWARD_FAN must not be negative.");
+#endif
+
+#if ENABLED(PID_AUTOTUNE_FOPDT) && !HAS_PID_HEATING
+  #error "PID_AUTOTUNE_FOPDT requires PIDTEMP or PIDTEMPBED."
+#endif
+
+#if HAS_HARDWARE_PWM_HEATER
+  #if ENABLED(SLOW_PWM_HEATERS)
+    #error "HEATER_*_HARDWARE_PWM is incompatible with SLOW_PWM_HEATERS."
+  #elif ENABLED(HEATER_POWER_BUDGET)
+    #error "HEATER_*_HARDWARE_PWM is incompatible with HEATER_POWER_BUDGET."
+  #elif ENABLED(HEATER_0_HARDWARE_PWM) && ENABLED(HEATERS_PARALLEL)
+    #error "HEATER_0_HARDWARE_PWM is incompatible with HEATERS_PARALLEL."
+  #endif
+#endif
+
+#if ENABLED(SOFT_PWM_PHASE_SPREAD) && ENABLED(SLOW_PWM_HEATERS)
+  #error "SOFT_PWM_PHASE_SPREAD is incompatible with SLOW_PWM_HEATERS."
+#endif
+
+#if ENABLED(THERMAL_HISTORY)
+  #if !WITHIN(THERMAL_HISTORY_SIZE, 256, 16384)
+    #error "THERMAL_HISTORY_SIZE must be from 256 to 16384 bytes."
+  #elif THERMAL_HISTORY_INTERVAL < 200
+    #error "THERMAL_HISTORY_INTERVAL must be at least 200ms."
+  #endif
+#endif
+
+#if ENABLED(TEMPERATURE_BARRIERS) && !HAS_TEMP_HOTEND
+  #error "TEMPERATURE_BARRIERS requires a hotend temperature sensor."
+#endif
+
+#if ENABLED(HEATER_POWER_BUDGET)
+  #if !HAS_HEATED_BED
+    #error "HEATER_POWER_BUDGET requires a heated bed."
+  #elif ENABLED(SLOW_PWM_HEATERS)
+    #error "HEATER_POWER_BUDGET is incompatible with SLOW_PWM_HEATERS."
+  #elif BED_HEATER_WATTS > HEATER_BUDGET_WATTS
+    #error "BED_HEATER_WATTS must not exceed HEATER_BUDGET_WATTS."
+  #endif
+#endif
+
+#if ENABLED(USB_HOST_SUPPORT) && !(PIN_EXISTS(USB_CS) && PIN_EXISTS(USB_INTR))
   #error "USB_CS_PIN and USB_INTR_PIN are required for USB_FLASH_DRIVE_SUPPORT."
 #endif
 
+#if ENABLED(USB_FLASH_DRIVE_SUPPORT) && !WITHIN(USB_BULK_BLOCKS, 1, 127)
+  #error "USB_BULK_BLOCKS must be from 1 to 127."
+#endif
+
+#if ENABLED(SDSUPPORT) && DISABLED(SD_STREAMING_READS) && !WITHIN(SD_READ_BUFFER_SIZE, 1, 255)
+  #error "SD_READ_BUFFER_SIZE must be from 1 to 255."
+#endif
+
+#if ENABLED(SD_STREAMING_READS) && ENABLED(SDIO_SUPPORT)
+  #error "SD_STREAMING_READS is not compatible with SDIO_SUPPORT."
+#endif
+#if ENABLED(SD_STREAMING_WRITES) && ENABLED(SDIO_SUPPORT)
+  #error "SD_STREAMING_WRITES is not compatible with SDIO_SUPPORT."
+#endif
+
+#if ENABLED(POWER_LOSS_JOURNAL) && !WITHIN(POWER_LOSS_JOURNAL_SIZE, 1, 255)
+  #error "POWER_LOSS_JOURNAL_SIZE must be from 1 to 255."
+#endif
+
+#if ENABLED(SD_EXTENT_MAP) && !WITHIN(SD_EXTENT_MAP_SIZE, 1, 255)
+  #error "SD_EXTENT_MAP_SIZE must be from 1 to 255."
+#endif
+
+#if ENABLED(SDCARD_DIR_INDEX) && SDCARD_DIR_INDEX_SIZE < 1
+  #error "SDCARD_DIR_INDEX_SIZE must be 1 or more."
+#endif
+
 #if ENABLED(SD_FIRMWARE_UPDATE) && !defined(__AVR_ATmega2560__)
   #error "SD_FIRMWARE_UPDATE requires an ATmega2560-based (Arduino Mega) board."
 #endif
@@ -29,10 +29,13 @@
 #include "media_file_reader.h"
 #include "flash_storage.h"
 
+#include "../../../../core/utility.h"
+
 using namespace FTDI::SPI;
 using namespace FTDI::SPI::most_significant_byte_first;
 
 bool UIFlashStorage::is_present = false;
+bool SPIFlash::erase_pending = false;
 
 #ifdef SPI_FLASH_SS
 /************************** SPI Flash Chip Interface **************************/
@@ -49,7 +52,19 @@ bool UIFlashStorage::is_present = false;
     } while(status & 1);
   }
 
-  void SPIFlash::erase_sector_4k(uint32_t addr) {
+  /* An erase started by erase_sector_4k_async() runs on its own inside
+   * the chip. Every other command first waits for it to complete.
+   */
+  void SPIFlash::wait_for_erase() {
+    if(erase_pending) {
+      wait_while_busy();
+      erase_pending = false;
+    }
+  }
+
+  void SPIFlash::erase_sector_4k_async(uint32_t addr) {
+    wait_for_erase();
+
     spi_flash_select();
     spi_write_8(WRITE_ENABLE);
     spi_flash_deselect();
@@ -59,10 +74,17 @@ bool UIFlashStorage::is_present = false;
     spi_write_24(addr);
     spi_flash_deselect();
 
-    wait_while_busy();
+    erase_pending = true;
+  }
+
+  void SPIFlash::erase_sector_4k(uint32_t addr) {
+    erase_sector_4k_async(addr);
+    wait_for_erase();
   }
 
   void SPIFlash::erase_sector_64k(uint32_t addr) {
+    wait_for_erase();
+
     spi_flash_select();
     spi_write_8(WRITE_ENABLE);
     spi_flash_deselect();
@@ -76,6 +98,8 @@ bool UIFlashStorage::is_present = false;
   }
 
   void SPIFlash::spi_write_begin(uint32_t addr) {
+    wait_for_erase();
+
     spi_flash_select();
     spi_write_8(WRITE_ENABLE);
     spi_flash_deselect();
@@ -91,6 +115,8 @@ bool UIFlashStorage::is_present = false;
   }
 
   void SPIFlash::spi_read_begin(uint32_t addr) {
+    wait_for_erase();
+
     spi_flash_select();
     spi_write_8(READ_DATA);
     spi_write_24(addr);
@@ -101,6 +127,8 @@ bool UIFlashStorage::is_present = false;
   }
 
   void SPIFlash::erase_chip() {
+    wait_for_erase();
+
     spi_flash_select();
     spi_write_8(WRITE_ENABLE);
     spi_flash_deselect();
@@ -112,6 +140,8 @@ bool UIFlashStorage::is_present = false;
   }
 
   void SPIFlash::read_jedec_id(uint8_t &manufacturer_id, uint8_t &device_type, uint8_t &capacity) {
+    wait_for_erase();
+
     spi_flash_select();
     spi_write_8(READ_JEDEC_ID);
     manufacturer_id = spi_recv();
@@ -147,6 +177,122 @@ bool UIFlashStorage::is_present = false;
     return addr + size;
   }
 
+  bool SPIFlash::verify(uint32_t addr, const void *data, size_t size) {
+    spi_read_begin(addr);
+    const bool ok = spi_verify_bulk(data, size);
+    spi_read_end();
+    return ok;
+  }
+
+#elif defined(__PLAT_LINUX__)
+/*********************** Simulated SPI Flash Chip (Linux) *********************/
+
+  /* A file-backed stand-in for the SPI Flash chip, so that the UI storage
+   * can be tested on the Linux target. As on the real chip, programming can
+   * only clear bits and erasing sets them. Setting SPIFLASH_POWER_CUT=<n>
+   * in the environment ends the simulator after <n> more bytes have been
+   * programmed, leaving the write cut short as a power loss would.
+   */
+
+  #include <stdio.h>
+  #include <stdlib.h>
+
+  static FILE    *flash_file;
+  static int32_t  power_cut_after = -1;
+
+  static void sim_open() {
+    if(flash_file) return;
+    flash_file = fopen("spiflash.dat", "r+b");
+    if(!flash_file) {
+      flash_file = fopen("spiflash.dat", "w+b");
+      uint8_t blank[SPIFlash::write_page_size];
+      memset(blank, 0xFF, sizeof(blank));
+      for(uint32_t addr = 0; addr < SPIFlash::flash_size; addr += sizeof(blank))
+        fwrite(blank, 1, sizeof(blank), flash_file);
+    }
+    const char *cut = getenv("SPIFLASH_POWER_CUT");
+    if(cut) power_cut_after = atol(cut);
+  }
+
+  static void sim_erase(uint32_t addr, uint32_t size) {
+    sim_open();
+    uint8_t blank[SPIFlash::write_page_size];
+    memset(blank, 0xFF, sizeof(blank));
+    fseek(flash_file, addr & ~(size - 1), SEEK_SET);
+    for(uint32_t i = 0; i < size; i += sizeof(blank))
+      fwrite(blank, 1, sizeof(blank), flash_file);
+    fflush(flash_file);
+  }
+
+  void SPIFlash::wait_while_busy()                {}
+  void SPIFlash::wait_for_erase()                 {}
+  void SPIFlash::erase_sector_4k(uint32_t addr)   {sim_erase(addr, 4 * 1024);}
+  void SPIFlash::erase_sector_64k(uint32_t addr)  {sim_erase(addr, 64 * 1024);}
+  void SPIFlash::erase_chip()                     {sim_erase(0, flash_size);}
+
+  void SPIFlash::erase_sector_4k_async(uint32_t addr) {
+    erase_sector_4k(addr);
+  }
+
+  void SPIFlash::read_jedec_id(uint8_t &manufacturer_id, uint8_t &device_type, uint8_t &capacity) {
+    // Winbond W25Q16JV
+    manufacturer_id = 0xEF;
+    device_type     = 0x14;
+    capacity        = 0x15;
+  }
+
+  uint32_t SPIFlash::write(uint32_t addr, const void *_data, size_t size) {
+    const uint8_t *data = (const uint8_t*) _data;
+    uint8_t page[write_page_size];
+    sim_open();
+    while(size) {
+      const uint32_t write_size = min(write_page_size - (addr & 0xFFul), size);
+      fseek(flash_file, addr, SEEK_SET);
+      fread(page, 1, write_size, flash_file);
+      for(uint32_t i = 0; i < write_size; i++) {
+        if(power_cut_after == 0) {
+          fseek(flash_file, addr, SEEK_SET);
+          fwrite(page, 1, i, flash_file);
+          fclose(flash_file);
+          SERIAL_ECHO_START(); SERIAL_ECHOLNPGM("Simulated SPI Flash power cut.");
+          exit(1);
+        }
+        if(power_cut_after > 0) power_cut_after--;
+        page[i] &= data[i];
+      }
+      fseek(flash_file, addr, SEEK_SET);
+      fwrite(page, 1, write_size, flash_file);
+      addr += write_size;
+      size -= write_size;
+      data += write_size;
+    }
+    fflush(flash_file);
+    return addr;
+  }
+
+  uint32_t SPIFlash::read(uint32_t addr, void *data, size_t size) {
+    sim_open();
+    fseek(flash_file, addr, SEEK_SET);
+    fread(data, 1, size, flash_file);
+    return addr + size;
+  }
+
+  bool SPIFlash::verify(uint32_t addr, const void *_data, size_t size) {
+    const uint8_t *data = (const uint8_t*) _data;
+    uint8_t buff[write_page_size];
+    while(size) {
+      const uint32_t n = min(sizeof(buff), size);
+      addr = read(addr, buff, n);
+      if(memcmp(buff, data, n)) return false;
+      size -= n;
+      data += n;
+    }
+    return true;
+  }
+
+#endif
+
+#if defined(SPI_FLASH_SS) || defined(__PLAT_LINUX__)
   /******************************* UI STORAGE ROUTINES ******************************/
 
   bool UIFlashStorage::check_known_device() {
@@ -189,7 +335,10 @@ bool UIFlashStorage::is_present = false;
 
   constexpr uint32_t data_addr = 0;
 
-  /* In order to provide some degree of wear leveling, each data write to the
+  /* Earlier firmware kept the UI settings here. They are still read until
+   * the UI settings journal (below) holds a record.
+   *
+   * In order to provide some degree of wear leveling, each data write to the
    * SPI Flash chip is appended to data that was already written before, until
    * the data storage area is completely filled. New data is written preceeded
    * with a 32-bit delimiter 'LULZ', so that we can distinguish written and
@@ -225,9 +374,7 @@ bool UIFlashStorage::is_present = false;
 
     for(uint32_t offset = 0; offset < (data_storage_area_size - stride); offset += stride) {
       uint32_t delim;
-      spi_read_begin(offset);
-      spi_read_bulk (&delim, sizeof(delim));
-      spi_read_end();
+      read(offset, &delim, sizeof(delim));
       switch(delim) {
         case 0xFFFFFFFFul: return read_offset;
         case delimiter:    read_offset = offset; break;
@@ -254,32 +401,169 @@ bool UIFlashStorage::is_present = false;
     return write_offset;
   }
 
+  void UIFlashStorage::write_config_data_area(const void *data, size_t size) {
+    int32_t write_addr = get_config_write_offset(size);
+    if(write_addr == -1) {
+      SERIAL_ECHO_START();
+      SERIAL_ECHOPGM("Erasing UI settings from SPI Flash... ");
+      #if defined(DATA_STORAGE_SIZE_64K)
+        erase_sector_64k(0);
+      #else
+        erase_sector_4k(0);
+      #endif
+      write_addr = 0;
+      SERIAL_ECHOLNPGM("DONE");
+    }
+
+    SERIAL_ECHO_START();
+    SERIAL_ECHOPAIR("Writing UI settings to SPI Flash (offset ", write_addr);
+    SERIAL_ECHOPGM(")...");
+
+    const uint32_t delim = delimiter;
+    write_addr = write(write_addr, &delim, sizeof(delim));
+    write_addr = write(write_addr, data, size);
+
+    SERIAL_ECHOLNPGM("DONE");
+  }
+
+  /**************************** UI SETTINGS JOURNAL (last 64k) *****************/
+
+  /* UI settings are kept in a journal of 4k sectors at the top of the chip,
+   * clear of the media files. Each write appends a record to the current
+   * sector:
+   *
+   *        'LULZ'         <--- record delimiter
+   *        <sequence>     <--- one more than the previous record
+   *        <size>         <--- data size, records of another size are ignored
+   *        <crc>          <--- CRC-16 of sequence, size and data
+   *        <data_byte>
+   *           ...
+   *
+   * Records never span sectors. When one does not fit, writing moves on to
+   * the next sector, round-robin. That sector was erased ahead of time, in
+   * the background right after the previous write, and the newest record is
+   * never in the sector being erased. A record cut short by a power loss
+   * fails its CRC, so the record before it is read instead.
+   *
+   * Media files written by earlier firmware may reach into the journal,
+   * and erasing a journal sector would corrupt them. Until the journal
+   * holds a record, the media index is checked first. If the media is in
+   * the way, the UI settings stay in the data storage area until the chip
+   * is erased.
+   */
+
+  constexpr uint8_t  journal_sectors = 16;
+  constexpr uint32_t journal_addr    = SPIFlash::flash_size - journal_sectors * SPIFlash::erase_unit_size;
+
+  struct journal_header_t {
+    uint32_t delimiter;
+    uint32_t sequence;
+    uint16_t size;
+    uint16_t crc;
+  };
+
+  bool     UIFlashStorage::journal_erased_ahead = false;
+  uint8_t  UIFlashStorage::journal_sector       = 0;
+  uint16_t UIFlashStorage::journal_size         = 0;
+  uint32_t UIFlashStorage::journal_sequence     = 0;
+  uint32_t UIFlashStorage::journal_read_addr    = 0;
+  uint32_t UIFlashStorage::journal_write_addr   = 0;
+
+  bool UIFlashStorage::check_journal_record(uint32_t addr, uint32_t size) {
+    journal_header_t hdr;
+    addr = read(addr, &hdr, sizeof(hdr));
+    if(hdr.delimiter != delimiter || hdr.size != size) return false;
+
+    uint16_t crc = 0;
+    crc16(&crc, &hdr.sequence, sizeof(hdr.sequence) + sizeof(hdr.size));
+    uint8_t buff[32];
+    while(size) {
+      const uint32_t n = min(sizeof(buff), size);
+      addr = read(addr, buff, n);
+      crc16(&crc, buff, n);
+      size -= n;
+    }
+    return crc == hdr.crc;
+  }
+
+  /* This function walks every sector of the journal. It finds the newest
+   * record, valid or not, to continue writing after it, and the newest
+   * valid record of the given size to read from.
+   */
+  void UIFlashStorage::scan_journal(uint32_t size) {
+    bool     found        = false;
+    uint32_t newest_valid = 0;
+
+    journal_size         = size;
+    journal_read_addr    = 0;
+    journal_sequence     = 0;
+    journal_erased_ahead = false;
+
+    // With an empty journal, the first write erases and uses sector 0
+    journal_sector     = journal_sectors - 1;
+    journal_write_addr = journal_addr + journal_sectors * erase_unit_size;
+
+    for(uint8_t sector = 0; sector < journal_sectors; sector++) {
+      const uint32_t sector_end = journal_addr + (sector + 1) * erase_unit_size;
+      uint32_t addr = sector_end - erase_unit_size;
+      journal_header_t hdr;
+
+      for(;;) {
+        if(addr + sizeof(hdr) > sector_end) break;
+        read(addr, &hdr, sizeof(hdr));
+        if(hdr.delimiter != delimiter) {
+          // Unless this is erased space, treat the sector as full
+          if(hdr.delimiter != 0xFFFFFFFFul || hdr.sequence != 0xFFFFFFFFul || hdr.size != 0xFFFF || hdr.crc != 0xFFFF)
+            addr = sector_end;
+          break;
+        }
+        const uint32_t next = addr + sizeof(hdr) + hdr.size;
+        if(next > sector_end) {
+          addr = sector_end;
+          break;
+        }
+        if(!found || hdr.sequence > journal_sequence) {
+          found            = true;
+          journal_sequence = hdr.sequence;
+          journal_sector   = sector;
+        }
+        if((!journal_read_addr || hdr.sequence > newest_valid) && check_journal_record(addr, size)) {
+          journal_read_addr = addr;
+          newest_valid      = hdr.sequence;
+        }
+        addr = next;
+      }
+
+      if(found && journal_sector == sector)
+        journal_write_addr = addr;
+    }
+  }
+
+  /* This function returns the address of the most recently written
+   * data, or -1 if no UI settings of this size have been written */
+  int32_t UIFlashStorage::get_config_read_addr(uint32_t size) {
+    if(journal_size != size) scan_journal(size);
+    if(journal_read_addr) return journal_read_addr + sizeof(journal_header_t);
+
+    const int32_t read_offset = get_config_read_offset(size);
+    return read_offset == -1 ? -1 : read_offset + 4;
+  }
+
   bool UIFlashStorage::verify_config_data(const void *data, size_t size) {
     if(!is_present) return false;
 
-    int32_t read_addr = get_config_read_offset(size);
-    if(read_addr == -1) return false;
-
-    uint32_t delim;
-    spi_read_begin(read_addr);
-    spi_read_bulk (&delim, sizeof(delim));
-    bool ok = spi_verify_bulk(data,size);
-    spi_read_end();
-    return ok && delim == delimiter;
+    const int32_t read_addr = get_config_read_addr(size);
+    return read_addr != -1 && verify(read_addr, data, size);
   }
 
   bool UIFlashStorage::read_config_data(void *data, size_t size) {
     if(!is_present) return false;
 
-    int32_t read_addr = get_config_read_offset(size);
+    const int32_t read_addr = get_config_read_addr(size);
     if(read_addr == -1) return false;
 
-    uint32_t delim;
-    spi_read_begin(read_addr);
-    spi_read_bulk (&delim, sizeof(delim));
-    spi_read_bulk (data, size);
-    spi_read_end();
-    return delim == delimiter;
+    read(read_addr, data, size);
+    return true;
   }
 
   void UIFlashStorage::write_config_data(const void *data, size_t size) {
@@ -296,26 +580,49 @@ bool UIFlashStorage::is_present = false;
       return;
     }
 
-    int16_t write_addr = get_config_write_offset(size);
-    if(write_addr == -1) {
-      SERIAL_ECHO_START();
-      SERIAL_ECHOPGM("Erasing UI settings from SPI Flash... ");
-      #if defined(DATA_STORAGE_SIZE_64K)
-        erase_sector_64k(0);
-      #else
-        erase_sector_4k(0);
-      #endif
-      write_addr = 0;
-      SERIAL_ECHOLNPGM("DONE");
+    if(!journal_sequence && media_reaches_journal()) {
+      write_config_data_area(data, size);
+      return;
+    }
+
+    journal_header_t hdr;
+    if(sizeof(hdr) + size > erase_unit_size) {
+      SERIAL_ECHO_START(); SERIAL_ECHOLNPGM("UI settings are too large for SPI Flash.");
+      return;
+    }
+
+    const uint32_t sector_end = journal_addr + (journal_sector + 1) * erase_unit_size;
+    if(journal_write_addr + sizeof(hdr) + size > sector_end) {
+      journal_sector     = (journal_sector + 1) % journal_sectors;
+      journal_write_addr = journal_addr + journal_sector * erase_unit_size;
+      if(!journal_erased_ahead) {
+        SERIAL_ECHO_START(); SERIAL_ECHOLNPGM("Erasing UI settings sector in SPI Flash.");
+        erase_sector_4k(journal_write_addr);
+      }
+      journal_erased_ahead = false;
     }
 
     SERIAL_ECHO_START();
-    SERIAL_ECHOPAIR("Writing UI settings to SPI Flash (offset ", write_addr);
+    SERIAL_ECHOPAIR("Writing UI settings to SPI Flash (offset ", journal_write_addr);
     SERIAL_ECHOPGM(")...");
 
-    const uint32_t delim = delimiter;
-    write_addr = write(write_addr, &delim, sizeof(delim));
-    write_addr = write(write_addr, data, size);
+    hdr.delimiter = delimiter;
+    hdr.sequence  = ++journal_sequence;
+    hdr.size      = size;
+    hdr.crc       = 0;
+    crc16(&hdr.crc, &hdr.sequence, sizeof(hdr.sequence) + sizeof(hdr.size));
+    crc16(&hdr.crc, data, size);
+
+    journal_read_addr  = journal_write_addr;
+    journal_write_addr = write(journal_write_addr, &hdr, sizeof(hdr));
+    journal_write_addr = write(journal_write_addr, data, size);
+
+    // Start erasing the next sector now, so that moving on to
+    // it later won't have to wait for the erase to finish.
+    if(!journal_erased_ahead) {
+      erase_sector_4k_async(journal_addr + ((journal_sector + 1) % journal_sectors) * erase_unit_size);
+      journal_erased_ahead = true;
+    }
 
     SERIAL_ECHOLNPGM("DONE");
   }
@@ -335,30 +642,42 @@ bool UIFlashStorage::is_present = false;
   void UIFlashStorage::erase_chip() {
     SERIAL_ECHO_START(); SERIAL_ECHOPGM("Erasing SPI Flash...");
     SPIFlash::erase_chip();
+    journal_size = 0; // Scan the now empty journal again
     SERIAL_ECHOLNPGM("DONE");
   }
 
+  // The file index is stored most significant byte first
+  uint32_t UIFlashStorage::read_32(uint32_t addr) {
+    uint8_t b[4];
+    read(addr, b, sizeof(b));
+    return (uint32_t(b[0]) << 24) | (uint32_t(b[1]) << 16) | (uint32_t(b[2]) << 8) | uint32_t(b[3]);
+  }
+
   uint32_t UIFlashStorage::get_media_file_start(uint8_t slot) {
     uint32_t addr = media_storage_addr + sizeof(uint32_t) * media_storage_slots;
-    spi_read_begin(media_storage_addr);
     for(uint8_t i = 0; i < slot; i++) {
-      addr += spi_read_32();
+      addr += get_media_file_size(i);
     }
-    spi_read_end();
     return addr;
   }
 
+  // Media files are written to the slots in order, so the first empty slot
+  // starts where the media ends
+  bool UIFlashStorage::media_reaches_journal() {
+    uint8_t slot = 0;
+    while(slot < media_storage_slots && get_media_file_size(slot) != 0xFFFFFFFFUL) slot++;
+    if(get_media_file_start(slot) <= journal_addr) return false;
+    SERIAL_ECHO_START(); SERIAL_ECHOLNPGM("Media files reach into the UI settings journal.");
+    return true;
+  }
+
   void UIFlashStorage::set_media_file_size(uint8_t slot, uint32_t size) {
-    spi_write_begin(media_storage_addr + sizeof(uint32_t) * slot);
-    spi_write_32(size);
-    spi_write_end();
+    const uint8_t b[4] = {uint8_t(size >> 24), uint8_t(size >> 16), uint8_t(size >> 8), uint8_t(size)};
+    write(media_storage_addr + sizeof(uint32_t) * slot, b, sizeof(b));
   }
 
   uint32_t UIFlashStorage::get_media_file_size(uint8_t slot) {
-    spi_read_begin(media_storage_addr + sizeof(uint32_t) * slot);
-    uint32_t size = spi_read_32();
-    spi_read_end();
-    return size;
+    return read_32(media_storage_addr + sizeof(uint32_t) * slot);
   }
 
   /* Writes a media file from the SD card/USB flash drive into a slot on the SPI Flash. Media
@@ -382,6 +701,11 @@ bool UIFlashStorage::is_present = false;
         return WOULD_OVERWRITE;
       }
 
+      if(get_media_file_start(slot) + reader.size() > journal_addr) {
+        SERIAL_ECHO_START(); SERIAL_ECHOLNPGM("Media file is too large");
+        return FILE_TOO_LARGE;
+      }
+
       SERIAL_ECHO_START(); SERIAL_ECHOPGM("Writing SPI Flash...");
 
       set_media_file_size(slot, reader.size());
@@ -429,13 +753,10 @@ bool UIFlashStorage::is_present = false;
           break;
         }
 
-        spi_read_begin(addr);
-        if(!spi_verify_bulk(buff, nBytes)) {
+        if(!verify(addr, buff, nBytes)) {
           verifyOk = false;
-          spi_read_end();
           break;
         }
-        spi_read_end();
 
         addr += nBytes;
         if(nBytes != write_page_size) break;
@@ -474,10 +795,7 @@ bool UIFlashStorage::is_present = false;
       return read(data, bytes_remaining);
 
     if(size > 0) {
-      spi_read_begin(addr);
-      spi_read_bulk(data, size);
-      spi_read_end();
-      addr += size;
+      addr = SPIFlash::read(addr, data, size);
       bytes_remaining -= size;
     }
 
@@ -499,5 +817,5 @@ bool UIFlashStorage::is_present = false;
   bool UIFlashStorage::BootMediaReader::isAvailable(uint32_t slot)            {return false;}
   int16_t UIFlashStorage::BootMediaReader::read(void *, const size_t)         {return -1;}
   int16_t UIFlashStorage::BootMediaReader::read(void *, void *, const size_t) {return -1;}
-#endif // SPI_FLASH_SS
+#endif // SPI_FLASH_SS || __PLAT_LINUX__
 #endif // EXTENSIBLE_UI
\ No newline at end of file
@@ -25,6 +25,7 @@ class SPIFlash {
   public:
     static constexpr uint32_t erase_unit_size = 4 * 1024; // Minimum erase unit
     static constexpr uint32_t write_page_size = 256;      // Minimum page write unit
+    static constexpr uint32_t flash_size      = 2ul * 1024 * 1024; // All supported chips are 16 Mbit
 
     enum {
       READ_STATUS_1 = 0x05,
@@ -41,8 +42,12 @@ class SPIFlash {
       ERASE_CHIP    = 0xC7
     };
 
+    static bool erase_pending;
+
     static void wait_while_busy();
+    static void wait_for_erase();
     static void erase_sector_4k(uint32_t addr);
+    static void erase_sector_4k_async(uint32_t addr); // Returns while the chip is still erasing
     static void erase_sector_64k(uint32_t addr);
     static void erase_chip  ();
 
@@ -56,6 +61,7 @@ class SPIFlash {
 
     static uint32_t write(uint32_t addr, const void *data, size_t size);
     static uint32_t read(uint32_t addr, void *data, size_t size);
+    static bool     verify(uint32_t addr, const void *data, size_t size);
 };
 
 class UIFlashStorage : private SPIFlash {
@@ -64,8 +70,20 @@ class UIFlashStorage : private SPIFlash {
     static bool is_present;
     static int32_t  get_config_read_offset(uint32_t block_size);
     static int32_t  get_config_write_offset(uint32_t block_size);
+    static void     write_config_data_area(const void *data, size_t size);
+
+    static bool     journal_erased_ahead;
+    static uint8_t  journal_sector;
+    static uint16_t journal_size;
+    static uint32_t journal_sequence, journal_read_addr, journal_write_addr;
+    static bool     check_journal_record(uint32_t addr, uint32_t size);
+    static void     scan_journal(uint32_t size);
+    static int32_t  get_config_read_addr(uint32_t size);
+
+    static uint32_t read_32(uint32_t addr);
 
     static uint32_t get_media_file_start(uint8_t slot);
+    static bool     media_reaches_journal();
     static void     set_media_file_size(uint8_t slot, uint32_t size);
     static uint32_t get_media_file_size(uint8_t slot);
 
@@ -76,7 +94,8 @@ class UIFlashStorage : private SPIFlash {
       FILE_NOT_FOUND,
       READ_ERROR,
       VERIFY_ERROR,
-      WOULD_OVERWRITE
+      WOULD_OVERWRITE,
+      FILE_TOO_LARGE
     };
 
     static void    initialize  ();
@@ -129,6 +129,10 @@ bool DeveloperMenu::onTouchEnd(uint8_t tag) {
           case UIFlashStorage::WOULD_OVERWRITE:
             AlertDialogBox::showError(F("Cannot overwrite existing media."));
             break;
+
+          case UIFlashStorage::FILE_TOO_LARGE:
+            AlertDialogBox::showError(F("STARTUP.AVI is too large."));
+            break;
         }
         break;
       }
@@ -88,11 +88,12 @@ bool MediaPlayerScreen::playBootMedia() {
 void MediaPlayerScreen::playStream(void *obj, media_streamer_func_t *data_stream) {
   #if defined(USE_FTDI_FT810)
     // Set up the media FIFO on the end of RAMG, as the top of RAMG
-    // will be used as the framebuffer.
+    // will be used as the framebuffer. The FIFO holds several blocks,
+    // so reading the next block overlaps with playing the queued ones.
 
     uint8_t        buf[512];
     const uint32_t block_size = 512;
-    const uint32_t fifo_size  = block_size * 2;
+    const uint32_t fifo_size  = block_size * 16;
     const uint32_t fifo_start = RAM_G + RAM_G_SIZE - fifo_size;
 
     CommandProcessor cmd;
@@ -118,7 +119,7 @@ void MediaPlayerScreen::playStream(void *obj, media_streamer_func_t *data_stream
     spiInit(SPI_HALF_SPEED); // Boost SPI speed for video playback
 
     do {
-      // Write block n
+      // Read block n
       nBytes = (*data_stream)(obj, buf, block_size);
       if(nBytes == -1) break;
 
@@ -128,11 +129,9 @@ void MediaPlayerScreen::playStream(void *obj, media_streamer_func_t *data_stream
         t = millis();
       }
 
-      CLCD::mem_write_bulk (fifo_start + writePtr, buf, nBytes);
-
-      // Wait for FTDI810 to finish playing block n-1
+      // Wait for the FTDI810 to free up room for block n
       timeouts = 20;
-      do {
+      while((writePtr - CLCD::mem_read_32(REG_MEDIAFIFO_READ) + fifo_size) % fifo_size + block_size >= fifo_size) {
         if(millis() - t > 10) {
           ExtUI::yield();
           watchdog_reset();
@@ -145,13 +144,25 @@ void MediaPlayerScreen::playStream(void *obj, media_streamer_func_t *data_stream
             goto exit;
           }
         }
-      } while(CLCD::mem_read_32(REG_MEDIAFIFO_READ) != writePtr);
+      }
 
-      // Start playing block n
+      // Queue block n for playing
+      CLCD::mem_write_bulk (fifo_start + writePtr, buf, nBytes);
       writePtr = (writePtr + nBytes) % fifo_size;
       CLCD::mem_write_32(REG_MEDIAFIFO_WRITE, writePtr);
     } while(nBytes == block_size);
 
+    // Let the FTDI810 play out the queued blocks
+    timeouts = 20;
+    while(CLCD::mem_read_32(REG_MEDIAFIFO_READ) != writePtr && timeouts) {
+      if(millis() - t > 10) {
+        ExtUI::yield();
+        watchdog_reset();
+        t = millis();
+        timeouts--;
+      }
+    }
+
     SERIAL_ECHO_START();
     SERIAL_ECHOLNPGM("Done playing video");
 
@@ -37,7 +37,7 @@
  */
 
 // Change EEPROM version if the structure changes
-#define EEPROM_VERSION "V64"
+#define EEPROM_VERSION "V65"
 #define EEPROM_OFFSET 100
 
 // Check the integrity of data offsets.
@@ -281,6 +281,13 @@ typedef struct SettingsDataStruct {
     toolchange_settings_t toolchange_settings;          // M217 S P R
   #endif
 
+  //
+  // EXTRUSION_FEEDFORWARD
+  //
+  #if ENABLED(EXTRUSION_FEEDFORWARD)
+    feedforward_t hotend_feedforward[HOTENDS];          // M309 En V F
+  #endif
+
 } SettingsData;
 
 MarlinSettings settings;
@@ -406,7 +413,7 @@ void MarlinSettings::postprocess() {
   #define EEPROM_START() int eeprom_index = EEPROM_OFFSET; persistentStore.access_start()
   #define EEPROM_FINISH() persistentStore.access_finish()
   #define EEPROM_SKIP(VAR) eeprom_index += sizeof(VAR)
-  #define EEPROM_WRITE(VAR) persistentStore.write_data(eeprom_index, (uint8_t*)&VAR, sizeof(VAR), &working_crc)
+  #define EEPROM_WRITE(VAR) do{ if (comparing) compare_data(eeprom_index, (uint8_t*)&VAR, sizeof(VAR), &working_crc); else persistentStore.write_data(eeprom_index, (uint8_t*)&VAR, sizeof(VAR), &working_crc); }while(0)
   #define EEPROM_READ(VAR) persistentStore.read_data(eeprom_index, (uint8_t*)&VAR, sizeof(VAR), &working_crc, !validating)
   #define EEPROM_READ_ALWAYS(VAR) persistentStore.read_data(eeprom_index, (uint8_t*)&VAR, sizeof(VAR), &working_crc)
   #define EEPROM_ASSERT(TST,ERR) do{ if (!(TST)) { SERIAL_ERROR_MSG(ERR); eeprom_error = true; } }while(0)
@@ -423,7 +430,7 @@ void MarlinSettings::postprocess() {
 
   const char version[4] = EEPROM_VERSION;
 
-  bool MarlinSettings::eeprom_error, MarlinSettings::validating;
+  bool MarlinSettings::eeprom_error, MarlinSettings::validating, MarlinSettings::comparing;
 
   bool MarlinSettings::size_error(const uint16_t size) {
     if (size != datasize()) {
@@ -433,12 +440,49 @@ void MarlinSettings::postprocess() {
     return false;
   }
 
+  /**
+   * Compare data with the stored bytes, adding it to the CRC.
+   * Any difference is flagged as an eeprom_error.
+   */
+  void MarlinSettings::compare_data(int &pos, const uint8_t *value, size_t size, uint16_t *crc) {
+    uint16_t stored_crc = 0;
+    while (size) {
+      uint8_t stored[16];
+      const uint8_t n = MIN(size, sizeof(stored));
+      persistentStore.read_data(pos, stored, n, &stored_crc);
+      if (memcmp(stored, value, n)) eeprom_error = true;
+      crc16(crc, value, n);
+      value += n;
+      size -= n;
+    }
+  }
+
   LULZBOT_SAVE_ZOFFSET_TO_EEPROM_IMPL
 
   /**
    * M500 - Store Configuration
+   *
+   * First stream through the stored settings comparing without writing,
+   * so saving unchanged settings writes nothing at all.
    */
   bool MarlinSettings::save() {
+    comparing = true;
+    const bool unchanged = _save();
+    comparing = false;
+    const bool success = unchanged || _save();
+
+    //
+    // UBL Mesh
+    //
+    #if ENABLED(UBL_SAVE_ACTIVE_ON_M500)
+      if (ubl.storage_slot >= 0)
+        store_mesh(ubl.storage_slot);
+    #endif
+
+    return success;
+  }
+
+  bool MarlinSettings::_save() {
     float dummy = 0;
     char ver[4] = "ERR";
 
@@ -450,7 +494,10 @@ void MarlinSettings::postprocess() {
     #if ENABLED(FLASH_EEPROM_EMULATION)
       EEPROM_SKIP(ver);   // Flash doesn't allow rewriting without erase
     #else
-      EEPROM_WRITE(ver);  // invalidate data first
+      if (comparing)
+        EEPROM_SKIP(ver); // The version is compared with the header last
+      else
+        EEPROM_WRITE(ver);  // invalidate data first
     #endif
     EEPROM_SKIP(working_crc); // Skip the checksum slot
 
@@ -1093,6 +1140,15 @@ void MarlinSettings::postprocess() {
       EEPROM_WRITE(toolchange_settings);
     #endif
 
+    //
+    // Extrusion Feedforward
+    //
+
+    #if ENABLED(EXTRUSION_FEEDFORWARD)
+      _FIELD_TEST(hotend_feedforward);
+      EEPROM_WRITE(thermalManager.feedforward);
+    #endif
+
     //
     // Validate CRC and Data Size
     //
@@ -1106,24 +1162,18 @@ void MarlinSettings::postprocess() {
       EEPROM_WRITE(version);
       EEPROM_WRITE(final_crc);
 
-      // Report storage size
-      CHITCHAT_ECHO_START();
-      CHITCHAT_ECHOPAIR("Settings Stored (", eeprom_size);
-      CHITCHAT_ECHOPAIR(" bytes; crc ", (uint32_t)final_crc);
-      CHITCHAT_ECHOLNPGM(")");
+      // Report storage size, unless the comparison found a difference
+      if (!eeprom_error) {
+        CHITCHAT_ECHO_START();
+        CHITCHAT_ECHOPAIR("Settings Stored (", eeprom_size);
+        CHITCHAT_ECHOPAIR(" bytes; crc ", (uint32_t)final_crc);
+        CHITCHAT_ECHOLNPGM(")");
+      }
 
-      eeprom_error |= size_error(eeprom_size);
+      eeprom_error |= comparing ? eeprom_size != datasize() : size_error(eeprom_size);
     }
     EEPROM_FINISH();
 
-    //
-    // UBL Mesh
-    //
-    #if ENABLED(UBL_SAVE_ACTIVE_ON_M500)
-      if (ubl.storage_slot >= 0)
-        store_mesh(ubl.storage_slot);
-    #endif
-
     return !eeprom_error;
   }
 
@@ -1815,6 +1865,14 @@ void MarlinSettings::postprocess() {
         EEPROM_READ(toolchange_settings);
       #endif
 
+      //
+      // Extrusion Feedforward
+      //
+      #if ENABLED(EXTRUSION_FEEDFORWARD)
+        _FIELD_TEST(hotend_feedforward);
+        EEPROM_READ(thermalManager.feedforward);
+      #endif
+
       eeprom_error = size_error(eeprom_index - (EEPROM_OFFSET));
       if (eeprom_error) {
         CHITCHAT_ECHO_START();
@@ -2196,6 +2254,17 @@ void MarlinSettings::reset() {
     thermalManager.lpq_len = 20;  // Default last-position-queue size
   #endif
 
+  //
+  // Extrusion Feedforward
+  //
+
+  #if ENABLED(EXTRUSION_FEEDFORWARD)
+    HOTEND_LOOP() {
+      thermalManager.feedforward[e].flow = DEFAULT_FEEDFORWARD_FLOW;
+      thermalManager.feedforward[e].fan = DEFAULT_FEEDFORWARD_FAN;
+    }
+  #endif
+
   //
   // Heated Bed PID
   //
@@ -2745,6 +2814,16 @@ void MarlinSettings::reset() {
 
     #endif // PIDTEMP || PIDTEMPBED
 
+    #if ENABLED(EXTRUSION_FEEDFORWARD)
+      CONFIG_ECHO_HEADING("Extrusion feedforward:");
+      HOTEND_LOOP() {
+        CONFIG_ECHO_START();
+        SERIAL_ECHOPAIR("  M309 E", e);
+        SERIAL_ECHOPAIR(" V", thermalManager.feedforward[e].flow);
+        SERIAL_ECHOLNPAIR(" F", thermalManager.feedforward[e].fan);
+      }
+    #endif
+
     #if HAS_LCD_CONTRAST
       CONFIG_ECHO_HEADING("LCD Contrast:");
       CONFIG_ECHO_START();
@@ -89,7 +89,7 @@ class MarlinSettings {
 
     #if ENABLED(EEPROM_SETTINGS)
 
-      static bool eeprom_error, validating;
+      static bool eeprom_error, validating, comparing;
 
       #if ENABLED(AUTO_BED_LEVELING_UBL)  // Eventually make these available if any leveling system
                                           // That can store is enabled
@@ -98,6 +98,8 @@ class MarlinSettings {
       #endif
 
       static bool _load();
+      static bool _save();
+      static void compare_data(int &pos, const uint8_t *value, size_t size, uint16_t *crc);
       static bool size_error(const uint16_t size);
     #endif
 };
@@ -1168,6 +1168,11 @@ void Planner::check_axes_activity() {
   uint8_t axis_active[NUM_AXIS] = { 0 },
           tail_fan_speed[FAN_COUNT];
 
+  #if FAN_COUNT > 0 && FAN_LEAD_TIME > 0
+    static uint8_t fan_lead_tail = BLOCK_BUFFER_SIZE;
+    static millis_t fan_lead_tail_ms;
+  #endif
+
   #if ENABLED(BARICUDA)
     #if HAS_HEATER_1
       uint8_t tail_valve_pressure;
@@ -1179,8 +1184,19 @@ void Planner::check_axes_activity() {
 
   if (has_blocks_queued()) {
     #if FAN_COUNT > 0
-      FANS_LOOP(i)
-        tail_fan_speed[i] = (block_buffer[block_buffer_tail].fan_speed[i] * uint16_t(thermalManager.fan_speed_scaler[i])) >> 7;
+      #if FAN_LEAD_TIME > 0
+        // Time until each block starts, judged from when the running block became the tail
+        const millis_t ms = millis();
+        if (block_buffer_tail != fan_lead_tail) {
+          fan_lead_tail = block_buffer_tail;
+          fan_lead_tail_ms = ms;
+        }
+        int32_t lead_ms = -int32_t(ms - fan_lead_tail_ms);
+        uint8_t lead_fan_speed[FAN_COUNT] = { 0 };
+      #else
+        FANS_LOOP(i)
+          tail_fan_speed[i] = (block_buffer[block_buffer_tail].fan_speed[i] * uint16_t(thermalManager.fan_speed_scaler[i])) >> 7;
+      #endif
     #endif
 
     block_t* block;
@@ -1198,12 +1214,27 @@ void Planner::check_axes_activity() {
     for (uint8_t b = block_buffer_tail; b != block_buffer_head; b = next_block_index(b)) {
       block = &block_buffer[b];
       LOOP_XYZE(i) if (block->steps[i]) axis_active[i]++;
+      #if FAN_COUNT > 0 && FAN_LEAD_TIME > 0
+        // Blocks starting within the lead time can already raise the fan speeds
+        if (lead_ms <= FAN_LEAD_TIME) {
+          FANS_LOOP(i) NOLESS(lead_fan_speed[i], block->fan_speed[i]);
+          lead_ms += block->duration_ms;
+        }
+      #endif
     }
+
+    #if FAN_COUNT > 0 && FAN_LEAD_TIME > 0
+      FANS_LOOP(i)
+        tail_fan_speed[i] = (lead_fan_speed[i] * uint16_t(thermalManager.fan_speed_scaler[i])) >> 7;
+    #endif
   }
   else {
     #if FAN_COUNT > 0
       FANS_LOOP(i)
         tail_fan_speed[i] = (thermalManager.fan_speed[i] * uint16_t(thermalManager.fan_speed_scaler[i])) >> 7;
+      #if FAN_LEAD_TIME > 0
+        fan_lead_tail = BLOCK_BUFFER_SIZE;
+      #endif
     #endif
 
     #if ENABLED(BARICUDA)
@@ -2220,6 +2251,11 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     block->nominal_speed_sqr = block->nominal_speed_sqr * sq(speed_factor);
   }
 
+  #if FAN_COUNT > 0 && FAN_LEAD_TIME > 0
+    // Nominal duration of the move, to look ahead for fan speed changes
+    block->duration_ms = MIN(1000.0f / (inverse_secs * speed_factor), 65535.0f);
+  #endif
+
   // Compute and limit the acceleration rate for the trapezoid generator.
   const float steps_per_mm = block->step_event_count * inverse_millimeters;
   uint32_t accel;
@@ -2677,6 +2713,14 @@ bool Planner::buffer_segment(const float &a, const float &b, const float &c, con
     #endif
   }
 
+  #if ENABLED(TEMPERATURE_BARRIERS)
+    // Any move that extrudes or retracts waits for deferred heater targets
+    if (thermalManager.barriers && target[E_AXIS] != position[E_AXIS]) {
+      thermalManager.wait_for_barriers();
+      if (cleaning_buffer_counter) return false;
+    }
+  #endif
+
   /* <-- add a slash to enable
     SERIAL_ECHOPAIR("  buffer_segment FR:", fr_mm_s);
     #if IS_KINEMATIC
@@ -149,6 +149,9 @@ typedef struct block_t {
 
   #if FAN_COUNT > 0
     uint8_t fan_speed[FAN_COUNT];
+    #if FAN_LEAD_TIME > 0
+      uint16_t duration_ms;                 // Nominal time of the move, to look ahead for fan changes
+    #endif
   #endif
 
   #if ENABLED(BARICUDA)
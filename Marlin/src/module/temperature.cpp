@@ -68,16 +68,71 @@
   #include "tool_change.h"
 #endif
 
+#if ENABLED(THERMAL_HISTORY)
+  #include "../feature/thermal_history.h"
+#endif
+
 #if HOTEND_USES_THERMISTOR
+
+  // Lookup tables built from the thermistor tables. Hotends sharing heater 0's thermistor share its table.
+  #if THERMISTORHEATER_0
+    static constexpr int16_t heater_0_lut[] PROGMEM = TT_LUT(HEATER_0_TEMPTABLE);
+    #define HEATER_0_LUT heater_0_lut
+  #else
+    #define HEATER_0_LUT NULL
+  #endif
+  #if THERMISTORHEATER_1 && THERMISTORHEATER_1 == THERMISTORHEATER_0
+    #define HEATER_1_LUT heater_0_lut
+  #elif THERMISTORHEATER_1
+    static constexpr int16_t heater_1_lut[] PROGMEM = TT_LUT(HEATER_1_TEMPTABLE);
+    #define HEATER_1_LUT heater_1_lut
+  #else
+    #define HEATER_1_LUT NULL
+  #endif
+  #if THERMISTORHEATER_2 && THERMISTORHEATER_2 == THERMISTORHEATER_0
+    #define HEATER_2_LUT heater_0_lut
+  #elif THERMISTORHEATER_2
+    static constexpr int16_t heater_2_lut[] PROGMEM = TT_LUT(HEATER_2_TEMPTABLE);
+    #define HEATER_2_LUT heater_2_lut
+  #else
+    #define HEATER_2_LUT NULL
+  #endif
+  #if THERMISTORHEATER_3 && THERMISTORHEATER_3 == THERMISTORHEATER_0
+    #define HEATER_3_LUT heater_0_lut
+  #elif THERMISTORHEATER_3
+    static constexpr int16_t heater_3_lut[] PROGMEM = TT_LUT(HEATER_3_TEMPTABLE);
+    #define HEATER_3_LUT heater_3_lut
+  #else
+    #define HEATER_3_LUT NULL
+  #endif
+  #if THERMISTORHEATER_4 && THERMISTORHEATER_4 == THERMISTORHEATER_0
+    #define HEATER_4_LUT heater_0_lut
+  #elif THERMISTORHEATER_4
+    static constexpr int16_t heater_4_lut[] PROGMEM = TT_LUT(HEATER_4_TEMPTABLE);
+    #define HEATER_4_LUT heater_4_lut
+  #else
+    #define HEATER_4_LUT NULL
+  #endif
+
   #if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
     static void* heater_ttbl_map[2] = { (void*)HEATER_0_TEMPTABLE, (void*)HEATER_1_TEMPTABLE };
     static constexpr uint8_t heater_ttbllen_map[2] = { HEATER_0_TEMPTABLE_LEN, HEATER_1_TEMPTABLE_LEN };
+    static const int16_t * const heater_lut_map[2] = { HEATER_0_LUT, HEATER_1_LUT };
   #else
     static void* heater_ttbl_map[HOTENDS] = ARRAY_BY_HOTENDS((void*)HEATER_0_TEMPTABLE, (void*)HEATER_1_TEMPTABLE, (void*)HEATER_2_TEMPTABLE, (void*)HEATER_3_TEMPTABLE, (void*)HEATER_4_TEMPTABLE);
     static constexpr uint8_t heater_ttbllen_map[HOTENDS] = ARRAY_BY_HOTENDS(HEATER_0_TEMPTABLE_LEN, HEATER_1_TEMPTABLE_LEN, HEATER_2_TEMPTABLE_LEN, HEATER_3_TEMPTABLE_LEN, HEATER_4_TEMPTABLE_LEN);
+    static const int16_t * const heater_lut_map[HOTENDS] = ARRAY_BY_HOTENDS(HEATER_0_LUT, HEATER_1_LUT, HEATER_2_LUT, HEATER_3_LUT, HEATER_4_LUT);
   #endif
 #endif
 
+#if ENABLED(HEATER_BED_USES_THERMISTOR)
+  static constexpr int16_t bed_lut[] PROGMEM = TT_LUT(BEDTEMPTABLE);
+#endif
+
+#if ENABLED(HEATER_CHAMBER_USES_THERMISTOR)
+  static constexpr int16_t chamber_lut[] PROGMEM = TT_LUT(CHAMBERTEMPTABLE);
+#endif
+
 Temperature thermalManager;
 
 /**
@@ -207,6 +262,9 @@ int16_t Temperature::current_temperature_raw[HOTENDS], // = { 0 }
   int16_t Temperature::current_temperature_bed_raw = 0,
           Temperature::target_temperature_bed = 0;
   uint8_t Temperature::soft_pwm_amount_bed;
+  #if ENABLED(HEATER_POWER_BUDGET)
+    uint8_t Temperature::soft_pwm_limit_bed = 127;
+  #endif
   #ifdef BED_MINTEMP
     int16_t Temperature::bed_minttemp_raw = HEATER_BED_RAW_LO_TEMP;
   #endif
@@ -249,6 +307,11 @@ int16_t Temperature::current_temperature_raw[HOTENDS], // = { 0 }
   millis_t Temperature::watch_heater_next_ms[HOTENDS] = { 0 };
 #endif
 
+#if ENABLED(TEMPERATURE_BARRIERS)
+  uint8_t Temperature::barriers = 0,
+          Temperature::barriers_cooling = 0;
+#endif
+
 #if ENABLED(PREVENT_COLD_EXTRUSION)
   bool Temperature::allow_cold_extrude = false;
   int16_t Temperature::extrude_min_temp = EXTRUDE_MINTEMP;
@@ -324,10 +387,83 @@ uint8_t Temperature::soft_pwm_amount[HOTENDS];
   uint8_t Temperature::ADCKey_count = 0;
 #endif
 
+#if ENABLED(CONTINUOUS_ADC)
+
+  static_assert(HAL_ADC_SCAN_SAMPLES == OVERSAMPLENR, "CONTINUOUS_ADC requires HAL_ADC_SCAN_SAMPLES to equal OVERSAMPLENR.");
+
+  // Scanned by the HAL in ADCScanIndex order
+  static const pin_t adc_scan_pins[] = {
+    #if HAS_TEMP_ADC_0
+      TEMP_0_PIN,
+    #endif
+    #if HAS_TEMP_ADC_1
+      TEMP_1_PIN,
+    #endif
+    #if HAS_TEMP_ADC_2
+      TEMP_2_PIN,
+    #endif
+    #if HAS_TEMP_ADC_3
+      TEMP_3_PIN,
+    #endif
+    #if HAS_TEMP_ADC_4
+      TEMP_4_PIN,
+    #endif
+    #if HAS_TEMP_ADC_5
+      TEMP_5_PIN,
+    #endif
+    #if HAS_HEATED_BED
+      TEMP_BED_PIN,
+    #endif
+    #if HAS_TEMP_CHAMBER
+      TEMP_CHAMBER_PIN,
+    #endif
+    #if ENABLED(FILAMENT_WIDTH_SENSOR)
+      FILWIDTH_PIN,
+    #endif
+    #if HAS_ADC_BUTTONS
+      ADC_KEYPAD_PIN,
+    #endif
+  };
+
+#endif
+
 #if ENABLED(PID_EXTRUSION_SCALING)
   int16_t Temperature::lpq_len; // Initialized in configuration_store
 #endif
 
+#if ENABLED(EXTRUSION_FEEDFORWARD)
+  feedforward_t Temperature::feedforward[HOTENDS]; // Initialized in configuration_store
+#endif
+
+#if ENABLED(HEATER_POWER_BUDGET)
+  static constexpr uint16_t hotend_heater_watts[] = HOTEND_HEATER_WATTS;
+  static_assert(COUNT(hotend_heater_watts) >= HOTENDS, "HOTEND_HEATER_WATTS must have a value for each hotend.");
+  constexpr uint16_t hotend_watts_sum(const uint8_t e) { return e ? hotend_heater_watts[e - 1] + hotend_watts_sum(e - 1) : 0; }
+  static_assert(hotend_watts_sum(HOTENDS) <= HEATER_BUDGET_WATTS, "HOTEND_HEATER_WATTS must not add up to more than HEATER_BUDGET_WATTS.");
+
+  /**
+   * Hotends come first. In each PWM cycle they are on from the start,
+   * and the bed is on at the end. Find how early the bed can come on
+   * without the hotends still on at that time exceeding the budget.
+   * The ISR calls this at the start of each cycle with the hotends'
+   * on-times for that cycle, so the bed's limit always matches them.
+   */
+  static uint8_t bed_power_limit(const uint8_t (&hotend_on)[HOTENDS]) {
+    uint8_t bed_start = 0;
+    while (bed_start < 127) {
+      uint16_t watts = BED_HEATER_WATTS;
+      uint8_t next_off = 127;
+      HOTEND_LOOP() if (hotend_on[e] > bed_start) {
+        watts += hotend_heater_watts[e];
+        NOMORE(next_off, hotend_on[e]);
+      }
+      if (watts <= HEATER_BUDGET_WATTS) break;
+      bed_start = next_off; // Wait for the next hotend to go off
+    }
+    return 127 - bed_start;
+  }
+#endif
+
 #if HAS_PID_HEATING
 
   inline void say_default_() { SERIAL_ECHOPGM("#define DEFAULT_"); }
@@ -550,45 +686,7 @@ uint8_t Temperature::soft_pwm_amount[HOTENDS];
       }
 
       if (cycles > ncycles && cycles > 2) {
-        SERIAL_ECHOLNPGM(MSG_PID_AUTOTUNE_FINISHED);
-
-        #if HAS_PID_FOR_BOTH
-          const char * const estring = GHV(PSTR("bed"), PSTR(""));
-          say_default_(); serialprintPGM(estring); SERIAL_ECHOLNPAIR("Kp ", tune_pid.Kp);
-          say_default_(); serialprintPGM(estring); SERIAL_ECHOLNPAIR("Ki ", tune_pid.Ki);
-          say_default_(); serialprintPGM(estring); SERIAL_ECHOLNPAIR("Kd ", tune_pid.Kd);
-        #elif ENABLED(PIDTEMP)
-          say_default_(); SERIAL_ECHOLNPAIR("Kp ", tune_pid.Kp);
-          say_default_(); SERIAL_ECHOLNPAIR("Ki ", tune_pid.Ki);
-          say_default_(); SERIAL_ECHOLNPAIR("Kd ", tune_pid.Kd);
-        #else
-          say_default_(); SERIAL_ECHOLNPAIR("bedKp ", tune_pid.Kp);
-          say_default_(); SERIAL_ECHOLNPAIR("bedKi ", tune_pid.Ki);
-          say_default_(); SERIAL_ECHOLNPAIR("bedKd ", tune_pid.Kd);
-        #endif
-
-        #define _SET_BED_PID() do { \
-          bed_pid.Kp = tune_pid.Kp; \
-          bed_pid.Ki = scalePID_i(tune_pid.Ki); \
-          bed_pid.Kd = scalePID_d(tune_pid.Kd); \
-        }while(0)
-
-        #define _SET_EXTRUDER_PID() do { \
-          PID_PARAM(Kp, heater) = tune_pid.Kp; \
-          PID_PARAM(Ki, heater) = scalePID_i(tune_pid.Ki); \
-          PID_PARAM(Kd, heater) = scalePID_d(tune_pid.Kd); \
-          updatePID(); }while(0)
-
-        // Use the result? (As with "M303 U1")
-        if (set_result) {
-          #if HAS_PID_FOR_BOTH
-            if (heater < 0) _SET_BED_PID(); else _SET_EXTRUDER_PID();
-          #elif ENABLED(PIDTEMP)
-            _SET_EXTRUDER_PID();
-          #else
-            _SET_BED_PID();
-          #endif
-        }
+        PID_autotune_finished(heater, tune_pid, set_result);
 
         #if ENABLED(PRINTER_EVENT_LEDS)
           printerEventLEDs.onPidTuningDone(color);
@@ -612,6 +710,270 @@ uint8_t Temperature::soft_pwm_amount[HOTENDS];
       return;
   }
 
+  /**
+   * Report the result of PID autotuning, applying it if requested
+   */
+  void Temperature::PID_autotune_finished(const int8_t heater, const PID_t &tune_pid, const bool set_result) {
+    SERIAL_ECHOLNPGM(MSG_PID_AUTOTUNE_FINISHED);
+
+    #if HAS_PID_FOR_BOTH
+      const char * const estring = GHV(PSTR("bed"), PSTR(""));
+      say_default_(); serialprintPGM(estring); SERIAL_ECHOLNPAIR("Kp ", tune_pid.Kp);
+      say_default_(); serialprintPGM(estring); SERIAL_ECHOLNPAIR("Ki ", tune_pid.Ki);
+      say_default_(); serialprintPGM(estring); SERIAL_ECHOLNPAIR("Kd ", tune_pid.Kd);
+    #elif ENABLED(PIDTEMP)
+      say_default_(); SERIAL_ECHOLNPAIR("Kp ", tune_pid.Kp);
+      say_default_(); SERIAL_ECHOLNPAIR("Ki ", tune_pid.Ki);
+      say_default_(); SERIAL_ECHOLNPAIR("Kd ", tune_pid.Kd);
+    #else
+      say_default_(); SERIAL_ECHOLNPAIR("bedKp ", tune_pid.Kp);
+      say_default_(); SERIAL_ECHOLNPAIR("bedKi ", tune_pid.Ki);
+      say_default_(); SERIAL_ECHOLNPAIR("bedKd ", tune_pid.Kd);
+    #endif
+
+    #define _SET_BED_PID() do { \
+      bed_pid.Kp = tune_pid.Kp; \
+      bed_pid.Ki = scalePID_i(tune_pid.Ki); \
+      bed_pid.Kd = scalePID_d(tune_pid.Kd); \
+    }while(0)
+
+    #define _SET_EXTRUDER_PID() do { \
+      PID_PARAM(Kp, heater) = tune_pid.Kp; \
+      PID_PARAM(Ki, heater) = scalePID_i(tune_pid.Ki); \
+      PID_PARAM(Kd, heater) = scalePID_d(tune_pid.Kd); \
+      updatePID(); }while(0)
+
+    // Use the result? (As with "M303 U1")
+    if (set_result) {
+      #if HAS_PID_FOR_BOTH
+        if (heater < 0) _SET_BED_PID(); else _SET_EXTRUDER_PID();
+      #elif ENABLED(PIDTEMP)
+        _SET_EXTRUDER_PID();
+      #else
+        _SET_BED_PID();
+      #endif
+    }
+  }
+
+  #if ENABLED(PID_AUTOTUNE_FOPDT)
+
+    /**
+     * Step Response PID Autotuning (M303 F)
+     *
+     * Heat at full power from room temperature T0 to the target, once.
+     * Past 20% of the rise, fit a first-order-plus-dead-time model,
+     *
+     *   dT/dt = (K * power - (T - T0)) / tau, delayed by L seconds,
+     *
+     * by least squares on its integral form, which needs no noisy slopes:
+     *
+     *   T(t) - T(t1) = a * (t - t1) - b * integral[t1..t](T - T0)
+     *
+     * where b = 1 / tau and a = K * power / tau. The PID values follow
+     * from the model by the IMC-PID rules (Rivera, Morari and Skogestad)
+     * with a closed-loop time constant of half the dead time. The integral
+     * time is capped at 8 L, as in SIMC, so slow heaters still settle.
+     */
+    void Temperature::PID_autotune_fopdt(const float &target, const int8_t heater, const bool set_result/*=false*/) {
+
+      if (target > GHV(BED_MAXTEMP, maxttemp[heater]) - 15) {
+        SERIAL_ECHOLNPGM(MSG_PID_TEMP_TOO_HIGH);
+        return;
+      }
+
+      const float start_temp = GHV(current_temperature_bed, current_temperature[heater]),
+                  rise = target - start_temp;
+
+      if (rise < 20) {
+        SERIAL_ECHOLNPGM(MSG_PID_TEMP_TOO_LOW);
+        return;
+      }
+
+      #if ENABLED(EXTRUSION_FEEDFORWARD)
+        // Filament enters at room temperature. Read it from the chamber, or
+        // else take the coolest sensor, as the heater may not start cold.
+        #if HAS_TEMP_CHAMBER
+          const float ambient = current_temperature_chamber;
+        #else
+          float ambient = start_temp;
+          HOTEND_LOOP() NOMORE(ambient, current_temperature[e]);
+          #if HAS_HEATED_BED
+            NOMORE(ambient, current_temperature_bed);
+          #endif
+        #endif
+      #endif
+
+      SERIAL_ECHOLNPGM(MSG_PID_AUTOTUNE_START);
+
+      disable_all_heaters();
+
+      SHV(soft_pwm_amount, (MAX_BED_POWER) >> 1, (PID_MAX) >> 1);
+
+      const millis_t start_ms = millis();
+      millis_t next_temp_ms = start_ms, fit_ms = 0, last_ms = 0;
+      float current = start_temp, fit_temp = 0, last_temp = 0, integral = 0,
+            s_tt = 0, s_ti = 0, s_ii = 0, s_ty = 0, s_iy = 0;
+      bool reached = false;
+
+      #if WATCH_THE_BED || WATCH_HOTENDS
+        const uint16_t watch_temp_period = GTV(WATCH_BED_TEMP_PERIOD, WATCH_TEMP_PERIOD);
+        const uint8_t watch_temp_increase = GTV(WATCH_BED_TEMP_INCREASE, WATCH_TEMP_INCREASE);
+        millis_t temp_change_ms = start_ms + watch_temp_period * 1000UL;
+        float next_watch_temp = start_temp + watch_temp_increase;
+      #endif
+
+      #if HAS_AUTO_FAN
+        next_auto_fan_check_ms = start_ms + 2500UL;
+      #endif
+
+      wait_for_heatup = true; // Can be interrupted with M108
+      #if ENABLED(PRINTER_EVENT_LEDS)
+        LEDColor color = ONHEATINGSTART();
+      #endif
+
+      #if ENABLED(NO_FAN_SLOWING_IN_PID_TUNING)
+        adaptive_fan_slowing = false;
+      #endif
+
+      while (wait_for_heatup) {
+
+        const millis_t ms = millis();
+
+        if (temp_meas_ready) { // temp sample ready
+          updateTemperaturesFromRawValues();
+
+          current = GHV(current_temperature_bed, current_temperature[heater]);
+
+          #if ENABLED(PRINTER_EVENT_LEDS)
+            ONHEATING(start_temp, current, target);
+          #endif
+
+          #if HAS_AUTO_FAN
+            if (ELAPSED(ms, next_auto_fan_check_ms)) {
+              checkExtruderAutoFans();
+              next_auto_fan_check_ms = ms + 2500UL;
+            }
+          #endif
+
+          if (fit_ms) {
+            // Add the sample to the least squares sums
+            const float t = (ms - fit_ms) * 0.001f, y = current - fit_temp;
+            integral += ((last_temp + current) * 0.5f - start_temp) * (ms - last_ms) * 0.001f;
+            s_tt += sq(t);
+            s_ti += t * integral;
+            s_ii += sq(integral);
+            s_ty += t * y;
+            s_iy += integral * y;
+          }
+          else if (current - start_temp > rise * 0.2f) {
+            // Past the dead time. Start fitting here.
+            fit_ms = ms;
+            fit_temp = current;
+          }
+          last_ms = ms;
+          last_temp = current;
+
+          if (current >= target) {
+            reached = true;
+            break;
+          }
+        }
+
+        // Report heater states every 2 seconds
+        if (ELAPSED(ms, next_temp_ms)) {
+          #if HAS_TEMP_SENSOR
+            print_heater_states(heater >= 0 ? heater : active_extruder);
+            SERIAL_EOL();
+          #endif
+          next_temp_ms = ms + 2000UL;
+
+          // Make sure heating is actually working
+          #if WATCH_THE_BED || WATCH_HOTENDS
+            if (
+              #if WATCH_THE_BED && WATCH_HOTENDS
+                true
+              #elif WATCH_HOTENDS
+                heater >= 0
+              #else
+                heater < 0
+              #endif
+            ) {
+              if (current > next_watch_temp) {
+                next_watch_temp = current + watch_temp_increase;
+                temp_change_ms = ms + watch_temp_period * 1000UL;
+              }
+              else if (ELAPSED(ms, temp_change_ms))
+                _temp_error(heater, PSTR(MSG_T_HEATING_FAILED), TEMP_ERR_PSTR(MSG_HEATING_FAILED_LCD, heater));
+            }
+          #endif
+        } // every 2 seconds
+
+        if (ELAPSED(ms, start_ms + MAX_CYCLE_TIME_PID_AUTOTUNE * 60L * 1000L)) {
+          SERIAL_ECHOLNPGM(MSG_PID_TIMEOUT);
+          break;
+        }
+
+        ui.update();
+      }
+
+      disable_all_heaters();
+
+      if (reached) {
+        // Solve the normal equations for a and b
+        const float det = sq(s_ti) - s_tt * s_ii,
+                    a = (s_ti * s_iy - s_ty * s_ii) / det,
+                    b = (s_tt * s_iy - s_ti * s_ty) / det,
+                    rise_fit = fit_temp - start_temp,
+                    rise_end = last_temp - start_temp;
+
+        // The dead time puts each point of the rise later than the model
+        if (fit_ms && last_ms > fit_ms && a > 0 && b > 0 && b * rise_end < a) {
+          const float tau = 1.0f / b,
+                      gain = a * tau / GHV(MAX_BED_POWER, PID_MAX),
+                      t_fit = (fit_ms - start_ms) * 0.001f,
+                      t_end = (last_ms - start_ms) * 0.001f,
+                      dead_time = MAX(1.0f, (t_fit + t_end + tau * (logf(1 - b * rise_fit / a) + logf(1 - b * rise_end / a))) * 0.5f);
+
+          SERIAL_ECHOPAIR(MSG_MODEL_K, gain);
+          SERIAL_ECHOPAIR(MSG_MODEL_TAU, tau);
+          SERIAL_ECHOLNPAIR(MSG_MODEL_L, dead_time);
+
+          // IMC-PID tuning with the closed-loop time constant equal to L / 2
+          PID_t tune_pid = { 0, 0, 0 };
+          tune_pid.Kp = (2 * tau + dead_time) / (3 * gain * dead_time);
+          tune_pid.Ki = tune_pid.Kp / MIN(tau + dead_time * 0.5f, 8 * dead_time);
+          tune_pid.Kd = tune_pid.Kp * tau * dead_time / (2 * tau + dead_time);
+          SERIAL_ECHOPAIR(MSG_KP, tune_pid.Kp);
+          SERIAL_ECHOPAIR(MSG_KI, tune_pid.Ki);
+          SERIAL_ECHOLNPAIR(MSG_KD, tune_pid.Kd);
+
+          PID_autotune_finished(heater, tune_pid, set_result);
+
+          #if ENABLED(EXTRUSION_FEEDFORWARD)
+            if (heater >= 0) {
+              // Power to heat the filament from room temperature to the target
+              const float flow = (FOPDT_FILAMENT_HEAT) * (target - ambient) * (PID_MAX) / (FOPDT_HEATER_POWER);
+              SERIAL_ECHOPAIR("M309 E", int(heater));
+              SERIAL_ECHOLNPAIR(" V", flow);
+              if (set_result) feedforward[heater].flow = flow;
+            }
+          #endif
+        }
+        else
+          SERIAL_ECHOLNPGM(MSG_PID_NO_MODEL);
+      }
+
+      #if ENABLED(PRINTER_EVENT_LEDS)
+        printerEventLEDs.onPidTuningDone(color);
+      #endif
+
+      #if ENABLED(NO_FAN_SLOWING_IN_PID_TUNING)
+        adaptive_fan_slowing = true;
+      #endif
+    }
+
+  #endif // PID_AUTOTUNE_FOPDT
+
 #endif // HAS_PID_HEATING
 
 /**
@@ -623,7 +985,13 @@ Temperature::Temperature() { }
 int Temperature::getHeaterPower(const int heater) {
   return (
     #if HAS_HEATED_BED
-      heater < 0 ? soft_pwm_amount_bed :
+      heater < 0 ? (
+        #if ENABLED(HEATER_POWER_BUDGET)
+          MIN(soft_pwm_amount_bed, soft_pwm_limit_bed)
+        #else
+          soft_pwm_amount_bed
+        #endif
+      ) :
     #endif
     soft_pwm_amount[heater]
   );
@@ -708,6 +1076,70 @@ void Temperature::min_temp_error(const int8_t heater) {
   _temp_error(heater, PSTR(MSG_T_MINTEMP), TEMP_ERR_PSTR(MSG_ERR_MINTEMP, heater));
 }
 
+#if ENABLED(EXTRUSION_FEEDFORWARD)
+
+  /**
+   * Heater power for the cooling that extrusion and the part-cooling fan
+   * are about to cause, so the control loop doesn't have to wait for the
+   * temperature to drop. Uses the volumetric rate of the move now being
+   * printed. Travel, retract and E-only moves add nothing.
+   */
+  float Temperature::get_feedforward(const int8_t e) {
+    #if HOTENDS == 1
+      UNUSED(e);
+    #endif
+    float output = 0;
+
+    // The stepper ISR can finish the block and advance the tail at any
+    // time, so copy what's needed from the block with it held off.
+    bool extruding = false;
+    uint8_t extruder = 0;
+    uint32_t nominal_rate = 0, e_steps = 0, step_event_count = 1;
+
+    const bool was_enabled = STEPPER_ISR_ENABLED();
+    if (was_enabled) DISABLE_STEPPER_DRIVER_INTERRUPT();
+
+    if (planner.has_blocks_queued()) {
+      const block_t * const block = &planner.block_buffer[planner.block_buffer_tail];
+      extruding = !TEST(block->flag, BLOCK_BIT_SYNC_POSITION)
+        && block->steps[E_AXIS] && (block->steps[X_AXIS] || block->steps[Y_AXIS])
+        && !TEST(block->direction_bits, E_AXIS)
+        #if HOTENDS > 1
+          && block->extruder == e
+        #endif
+      ;
+      if (extruding) {
+        extruder         = block->extruder;
+        nominal_rate     = block->nominal_rate;
+        e_steps          = block->steps[E_AXIS];
+        step_event_count = block->step_event_count;
+      }
+    }
+
+    if (was_enabled) ENABLE_STEPPER_DRIVER_INTERRUPT();
+
+    if (extruding) {
+      // Filament speed at the nominal rate of the block
+      const float e_mm_s = float(nominal_rate) * e_steps / step_event_count
+                         * planner.steps_to_mm[E_AXIS_N(extruder)];
+      #if DISABLED(NO_VOLUMETRICS)
+        const float diameter = planner.filament_size[extruder];
+        const float area = CIRCLE_AREA((diameter ? diameter : float(DEFAULT_NOMINAL_FILAMENT_DIA)) * 0.5f);
+      #else
+        constexpr float area = CIRCLE_AREA(float(DEFAULT_NOMINAL_FILAMENT_DIA) * 0.5f);
+      #endif
+      output += feedforward[HOTEND_INDEX].flow * e_mm_s * area;
+    }
+
+    #if FAN_COUNT > 0
+      output += feedforward[HOTEND_INDEX].fan * lcd_fanSpeedActual(0) * (1.0f / 255.0f);
+    #endif
+
+    return output;
+  }
+
+#endif // EXTRUSION_FEEDFORWARD
+
 float Temperature::get_pid_output(const int8_t e) {
   #if HOTENDS == 1
     UNUSED(e);
@@ -767,6 +1199,10 @@ float Temperature::get_pid_output(const int8_t e) {
           }
         #endif // PID_EXTRUSION_SCALING
 
+        #if ENABLED(EXTRUSION_FEEDFORWARD)
+          pid_output += get_feedforward(HOTEND_INDEX);
+        #endif
+
         if (pid_output > PID_MAX) {
           if (pid_error > 0) temp_iState[HOTEND_INDEX] -= pid_error; // conditional un-integration
           pid_output = PID_MAX;
@@ -806,6 +1242,11 @@ float Temperature::get_pid_output(const int8_t e) {
       #define _TIMED_OUT_TEST false
     #endif
     pid_output = (!_TIMED_OUT_TEST && current_temperature[HOTEND_INDEX] < target_temperature[HOTEND_INDEX]) ? BANG_MAX : 0;
+    #if ENABLED(EXTRUSION_FEEDFORWARD)
+      // Between "on" pulses keep supplying the power the load is taking
+      if (!pid_output && !_TIMED_OUT_TEST && target_temperature[HOTEND_INDEX])
+        pid_output = constrain(get_feedforward(HOTEND_INDEX), 0, BANG_MAX);
+    #endif
     #undef _TIMED_OUT_TEST
   #endif
 
@@ -829,10 +1270,17 @@ float Temperature::get_pid_output(const int8_t e) {
 
       temp_dState = current_temperature_bed;
 
+      #if ENABLED(HEATER_POWER_BUDGET)
+        // Don't wind up on power the budget won't give the bed
+        const float max_power = MIN(MAX_BED_POWER, (soft_pwm_limit_bed << 1) | 1);
+      #else
+        constexpr float max_power = MAX_BED_POWER;
+      #endif
+
       float pid_output = work_pid.Kp + work_pid.Ki - work_pid.Kd;
-      if (pid_output > MAX_BED_POWER) {
+      if (pid_output > max_power) {
         if (pid_error > 0) temp_iState -= pid_error; // conditional un-integration
-        pid_output = MAX_BED_POWER;
+        pid_output = max_power;
       }
       else if (pid_output < 0) {
         if (pid_error < 0) temp_iState -= pid_error; // conditional un-integration
@@ -942,6 +1390,14 @@ void Temperature::manage_heater() {
 
   } // HOTEND_LOOP
 
+  #if ENABLED(THERMAL_HISTORY)
+    thermal_history.update();
+  #endif
+
+  #if ENABLED(AUTO_REPORT_TEMPERATURE_CHANGES)
+    auto_report_readings_ready = true;
+  #endif
+
   #if HAS_AUTO_FAN
     if (ELAPSED(ms, next_auto_fan_check_ms)) { // only need to check fan state very infrequently
       checkExtruderAutoFans();
@@ -1032,24 +1488,17 @@ void Temperature::manage_heater() {
 #define TEMP_AD8495(RAW) ((RAW) * 6.6 * 100.0 / 1024.0 / (OVERSAMPLENR) * (TEMP_SENSOR_AD8495_GAIN) + TEMP_SENSOR_AD8495_OFFSET)
 
 /**
- * Bisect search for the range of the 'raw' value, then interpolate
- * proportionally between the under and over values.
+ * Look up the 'raw' value in a table made by TT_LUT, then interpolate
+ * between its neighbors. Values outside the thermistor table give the
+ * temperature of its last entry, as the old bisect search did.
  */
-#define SCAN_THERMISTOR_TABLE(TBL,LEN) do{                             \
-  uint8_t l = 0, r = LEN, m;                                           \
-  for (;;) {                                                           \
-    m = (l + r) >> 1;                                                  \
-    if (m == l || m == r) return (short)pgm_read_word(&TBL[LEN-1][1]); \
-    short v00 = pgm_read_word(&TBL[m-1][0]),                           \
-          v10 = pgm_read_word(&TBL[m-0][0]);                           \
-         if (raw < v00) r = m;                                         \
-    else if (raw > v10) l = m;                                         \
-    else {                                                             \
-      const short v01 = (short)pgm_read_word(&TBL[m-1][1]),            \
-                  v11 = (short)pgm_read_word(&TBL[m-0][1]);            \
-      return v01 + (raw - v00) * float(v11 - v01) / float(v10 - v00);  \
-    }                                                                  \
-  }                                                                    \
+#define LOOKUP_THERMISTOR_LUT(TBL,LEN,LUT) do{                                                       \
+  if (raw < (short)pgm_read_word(&TBL[0][0]) || raw > (short)pgm_read_word(&TBL[LEN-1][0]))          \
+    return (short)pgm_read_word(&TBL[LEN-1][1]);                                                     \
+  const uint16_t i = raw >> (THERMISTOR_LUT_SHIFT);                                                  \
+  const int16_t t0 = pgm_read_word(&LUT[i]), t1 = pgm_read_word(&LUT[i + 1]);                        \
+  return (t0 + ((int32_t(t1 - t0) * (raw & ((THERMISTOR_LUT_STEP) - 1))) >> (THERMISTOR_LUT_SHIFT))) \
+         * (1.0f / (THERMISTOR_LUT_SCALE));                                                          \
 }while(0)
 
 // Derived from RepRap FiveD extruder::getTemperature()
@@ -1119,7 +1568,7 @@ float Temperature::analog_to_celsius_hotend(const int raw, const uint8_t e) {
   #if HOTEND_USES_THERMISTOR
     // Thermistor with conversion table?
     const short(*tt)[][2] = (short(*)[][2])(heater_ttbl_map[e]);
-    SCAN_THERMISTOR_TABLE((*tt), heater_ttbllen_map[e]);
+    LOOKUP_THERMISTOR_LUT((*tt), heater_ttbllen_map[e], heater_lut_map[e]);
   #endif
 
   return 0;
@@ -1130,7 +1579,7 @@ float Temperature::analog_to_celsius_hotend(const int raw, const uint8_t e) {
   // For bed temperature measurement.
   float Temperature::analog_to_celsius_bed(const int raw) {
     #if ENABLED(HEATER_BED_USES_THERMISTOR)
-      SCAN_THERMISTOR_TABLE(BEDTEMPTABLE, BEDTEMPTABLE_LEN);
+      LOOKUP_THERMISTOR_LUT(BEDTEMPTABLE, BEDTEMPTABLE_LEN, bed_lut);
     #elif ENABLED(HEATER_BED_USES_AD595)
       return TEMP_AD595(raw);
     #elif ENABLED(HEATER_BED_USES_AD8495)
@@ -1146,7 +1595,7 @@ float Temperature::analog_to_celsius_hotend(const int raw, const uint8_t e) {
   // For chamber temperature measurement.
   float Temperature::analog_to_celsiusChamber(const int raw) {
     #if ENABLED(HEATER_CHAMBER_USES_THERMISTOR)
-      SCAN_THERMISTOR_TABLE(CHAMBERTEMPTABLE, CHAMBERTEMPTABLE_LEN);
+      LOOKUP_THERMISTOR_LUT(CHAMBERTEMPTABLE, CHAMBERTEMPTABLE_LEN, chamber_lut);
     #elif ENABLED(HEATER_CHAMBER_USES_AD595)
       return TEMP_AD595(raw);
     #elif ENABLED(HEATER_CHAMBER_USES_AD8495)
@@ -1311,35 +1760,43 @@ void Temperature::init() {
     OUT_WRITE(MAX6675_SS2_PIN, HIGH);
   #endif
 
-  HAL_adc_init();
+  #if ENABLED(CONTINUOUS_ADC)
 
-  #if HAS_TEMP_ADC_0
-    HAL_ANALOG_SELECT(TEMP_0_PIN);
-  #endif
-  #if HAS_TEMP_ADC_1
-    HAL_ANALOG_SELECT(TEMP_1_PIN);
-  #endif
-  #if HAS_TEMP_ADC_2
-    HAL_ANALOG_SELECT(TEMP_2_PIN);
-  #endif
-  #if HAS_TEMP_ADC_3
-    HAL_ANALOG_SELECT(TEMP_3_PIN);
-  #endif
-  #if HAS_TEMP_ADC_4
-    HAL_ANALOG_SELECT(TEMP_4_PIN);
-  #endif
-  #if HAS_TEMP_ADC_5
-    HAL_ANALOG_SELECT(TEMP_5_PIN);
-  #endif
-  #if HAS_HEATED_BED
-    HAL_ANALOG_SELECT(TEMP_BED_PIN);
-  #endif
-  #if HAS_TEMP_CHAMBER
-    HAL_ANALOG_SELECT(TEMP_CHAMBER_PIN);
-  #endif
-  #if ENABLED(FILAMENT_WIDTH_SENSOR)
-    HAL_ANALOG_SELECT(FILWIDTH_PIN);
-  #endif
+    HAL_adc_scan_start(adc_scan_pins, ADCScan_COUNT);
+
+  #else
+
+    HAL_adc_init();
+
+    #if HAS_TEMP_ADC_0
+      HAL_ANALOG_SELECT(TEMP_0_PIN);
+    #endif
+    #if HAS_TEMP_ADC_1
+      HAL_ANALOG_SELECT(TEMP_1_PIN);
+    #endif
+    #if HAS_TEMP_ADC_2
+      HAL_ANALOG_SELECT(TEMP_2_PIN);
+    #endif
+    #if HAS_TEMP_ADC_3
+      HAL_ANALOG_SELECT(TEMP_3_PIN);
+    #endif
+    #if HAS_TEMP_ADC_4
+      HAL_ANALOG_SELECT(TEMP_4_PIN);
+    #endif
+    #if HAS_TEMP_ADC_5
+      HAL_ANALOG_SELECT(TEMP_5_PIN);
+    #endif
+    #if HAS_HEATED_BED
+      HAL_ANALOG_SELECT(TEMP_BED_PIN);
+    #endif
+    #if HAS_TEMP_CHAMBER
+      HAL_ANALOG_SELECT(TEMP_CHAMBER_PIN);
+    #endif
+    #if ENABLED(FILAMENT_WIDTH_SENSOR)
+      HAL_ANALOG_SELECT(FILWIDTH_PIN);
+    #endif
+
+  #endif // !CONTINUOUS_ADC
 
   HAL_timer_start(TEMP_TIMER_NUM, TEMP_TIMER_FREQUENCY);
   ENABLE_TEMPERATURE_INTERRUPT();
@@ -1691,6 +2148,10 @@ void Temperature::disable_all_heaters() {
     setTargetBed(0);
   #endif
 
+  #if ENABLED(TEMPERATURE_BARRIERS)
+    barriers = barriers_cooling = 0;
+  #endif
+
   // Unpause and reset everything
   #if ENABLED(PROBING_HEATERS_OFF)
     pause(false);
@@ -2019,10 +2480,34 @@ HAL_TEMP_TIMER_ISR {
   HAL_timer_isr_epilogue(TEMP_TIMER_NUM);
 }
 
+#if ENABLED(SOFT_PWM_PHASE_SPREAD)
+  // Soft PWM channels get evenly spaced phases: hotends, then the bed, then the fans
+  #if HAS_HEATED_BED
+    #define _PWM_BED_CHANNELS 1
+  #else
+    #define _PWM_BED_CHANNELS 0
+  #endif
+  #if ENABLED(FAN_SOFT_PWM)
+    #define _PWM_FAN_CHANNELS FAN_COUNT
+  #else
+    #define _PWM_FAN_CHANNELS 0
+  #endif
+  #define PWM_PHASE(I) ((I) * 127 / (HOTENDS + _PWM_BED_CHANNELS + _PWM_FAN_CHANNELS))
+  #if ENABLED(HEATER_POWER_BUDGET)
+    #define PWM_PHASE_E(N) 0 // The power budget has the hotends on from the start of the cycle
+  #else
+    #define PWM_PHASE_E(N) PWM_PHASE(N)
+  #endif
+  #define PWM_PHASE_BED PWM_PHASE(HOTENDS)
+  #define PWM_PHASE_FAN(F) PWM_PHASE(HOTENDS + _PWM_BED_CHANNELS + (F))
+#endif
+
 void Temperature::isr() {
 
   static int8_t temp_count = -1;
-  static ADCSensorState adc_sensor_state = StartupDelay;
+  #if DISABLED(CONTINUOUS_ADC)
+    static ADCSensorState adc_sensor_state = StartupDelay;
+  #endif
   static uint8_t pwm_count = _BV(SOFT_PWM_SCALE);
   // avoid multiple loads of pwm_count
   uint8_t pwm_count_tmp = pwm_count;
@@ -2074,26 +2559,79 @@ void Temperature::isr() {
 
     /**
      * Standard heater PWM modulation
+     *
+     * With SOFT_PWM_PHASE_SPREAD each channel's on-time starts at its own
+     * phase in the cycle, instead of all switching on together. A channel
+     * is on while its position past that phase is below its count.
      */
+    #if ENABLED(SOFT_PWM_PHASE_SPREAD)
+      #define _PWM_POS(P) (pwm_count_tmp >= (P) ? pwm_count_tmp - (P) : pwm_count_tmp + 127 - (P))
+      #define _PWM_ON(W,S,P) W(S > _PWM_POS(P) ? HIGH : LOW)
+      #define _PWM_LOW(W,S,P) _PWM_ON(W,S,P)
+    #else
+      #define _PWM_ON(W,S,P) W(S > pwm_mask ? HIGH : LOW)
+      #define _PWM_LOW(W,S,P) do{ if (S <= pwm_count_tmp) W(LOW); }while(0)
+    #endif
+    #define _PWM_MOD(W,S,A,P) do{ S = (S & pwm_mask) + (A); _PWM_ON(W,S,P); }while(0)
+    // Hardware PWM heaters only pass a new amount to the timer
+    #define _PWM_HW(N,S,A) do{ if (S != (A)) { S = (A); analogWrite(HEATER_##N##_PIN, ((S << 1) + (S >> 6)) ^ (HEATER_##N##_INVERTING ? 0xFF : 0)); } }while(0)
+
+    #if ENABLED(HEATER_0_HARDWARE_PWM)
+      #define PWM_MOD_E0() _PWM_HW(0, soft_pwm_count_0, soft_pwm_amount[0])
+      #define PWM_LOW_E0() NOOP
+    #else
+      #define PWM_MOD_E0() _PWM_MOD(WRITE_HEATER_0, soft_pwm_count_0, soft_pwm_amount[0], PWM_PHASE_E(0))
+      #define PWM_LOW_E0() _PWM_LOW(WRITE_HEATER_0, soft_pwm_count_0, PWM_PHASE_E(0))
+    #endif
+    #if ENABLED(HEATER_1_HARDWARE_PWM)
+      #define PWM_MOD_E1() _PWM_HW(1, soft_pwm_count_1, soft_pwm_amount[1])
+      #define PWM_LOW_E1() NOOP
+    #else
+      #define PWM_MOD_E1() _PWM_MOD(WRITE_HEATER_1, soft_pwm_count_1, soft_pwm_amount[1], PWM_PHASE_E(1))
+      #define PWM_LOW_E1() _PWM_LOW(WRITE_HEATER_1, soft_pwm_count_1, PWM_PHASE_E(1))
+    #endif
+    #if ENABLED(HEATER_2_HARDWARE_PWM)
+      #define PWM_MOD_E2() _PWM_HW(2, soft_pwm_count_2, soft_pwm_amount[2])
+      #define PWM_LOW_E2() NOOP
+    #else
+      #define PWM_MOD_E2() _PWM_MOD(WRITE_HEATER_2, soft_pwm_count_2, soft_pwm_amount[2], PWM_PHASE_E(2))
+      #define PWM_LOW_E2() _PWM_LOW(WRITE_HEATER_2, soft_pwm_count_2, PWM_PHASE_E(2))
+    #endif
+    #if ENABLED(HEATER_3_HARDWARE_PWM)
+      #define PWM_MOD_E3() _PWM_HW(3, soft_pwm_count_3, soft_pwm_amount[3])
+      #define PWM_LOW_E3() NOOP
+    #else
+      #define PWM_MOD_E3() _PWM_MOD(WRITE_HEATER_3, soft_pwm_count_3, soft_pwm_amount[3], PWM_PHASE_E(3))
+      #define PWM_LOW_E3() _PWM_LOW(WRITE_HEATER_3, soft_pwm_count_3, PWM_PHASE_E(3))
+    #endif
+    #if ENABLED(HEATER_4_HARDWARE_PWM)
+      #define PWM_MOD_E4() _PWM_HW(4, soft_pwm_count_4, soft_pwm_amount[4])
+      #define PWM_LOW_E4() NOOP
+    #else
+      #define PWM_MOD_E4() _PWM_MOD(WRITE_HEATER_4, soft_pwm_count_4, soft_pwm_amount[4], PWM_PHASE_E(4))
+      #define PWM_LOW_E4() _PWM_LOW(WRITE_HEATER_4, soft_pwm_count_4, PWM_PHASE_E(4))
+    #endif
+    #if ENABLED(HEATER_5_HARDWARE_PWM)
+      #define PWM_MOD_E5() _PWM_HW(5, soft_pwm_count_5, soft_pwm_amount[5])
+      #define PWM_LOW_E5() NOOP
+    #else
+      #define PWM_MOD_E5() _PWM_MOD(WRITE_HEATER_5, soft_pwm_count_5, soft_pwm_amount[5], PWM_PHASE_E(5))
+      #define PWM_LOW_E5() _PWM_LOW(WRITE_HEATER_5, soft_pwm_count_5, PWM_PHASE_E(5))
+    #endif
+
     if (pwm_count_tmp >= 127) {
       pwm_count_tmp -= 127;
-      soft_pwm_count_0 = (soft_pwm_count_0 & pwm_mask) + soft_pwm_amount[0];
-      WRITE_HEATER_0(soft_pwm_count_0 > pwm_mask ? HIGH : LOW);
+      PWM_MOD_E0();
       #if HOTENDS > 1
-        soft_pwm_count_1 = (soft_pwm_count_1 & pwm_mask) + soft_pwm_amount[1];
-        WRITE_HEATER_1(soft_pwm_count_1 > pwm_mask ? HIGH : LOW);
+        PWM_MOD_E1();
         #if HOTENDS > 2
-          soft_pwm_count_2 = (soft_pwm_count_2 & pwm_mask) + soft_pwm_amount[2];
-          WRITE_HEATER_2(soft_pwm_count_2 > pwm_mask ? HIGH : LOW);
+          PWM_MOD_E2();
           #if HOTENDS > 3
-            soft_pwm_count_3 = (soft_pwm_count_3 & pwm_mask) + soft_pwm_amount[3];
-            WRITE_HEATER_3(soft_pwm_count_3 > pwm_mask ? HIGH : LOW);
+            PWM_MOD_E3();
             #if HOTENDS > 4
-              soft_pwm_count_4 = (soft_pwm_count_4 & pwm_mask) + soft_pwm_amount[4];
-              WRITE_HEATER_4(soft_pwm_count_4 > pwm_mask ? HIGH : LOW);
+              PWM_MOD_E4();
               #if HOTENDS > 5
-                soft_pwm_count_5 = (soft_pwm_count_5 & pwm_mask) + soft_pwm_amount[5];
-                WRITE_HEATER_5(soft_pwm_count_5 > pwm_mask ? HIGH : LOW);
+                PWM_MOD_E5();
               #endif // HOTENDS > 5
             #endif // HOTENDS > 4
           #endif // HOTENDS > 3
@@ -2101,56 +2639,69 @@ void Temperature::isr() {
       #endif // HOTENDS > 1
 
       #if HAS_HEATED_BED
-        soft_pwm_count_BED = (soft_pwm_count_BED & pwm_mask) + soft_pwm_amount_bed;
-        WRITE_HEATER_BED(soft_pwm_count_BED > pwm_mask ? HIGH : LOW);
+        #if ENABLED(HEATER_BED_HARDWARE_PWM)
+          _PWM_HW(BED, soft_pwm_count_BED, soft_pwm_amount_bed);
+        #elif ENABLED(HEATER_POWER_BUDGET)
+          // The bed is on at the end of the cycle, after the hotends
+          {
+            const uint8_t hotend_on[] = ARRAY_BY_HOTENDS(soft_pwm_count_0, soft_pwm_count_1, soft_pwm_count_2, soft_pwm_count_3, soft_pwm_count_4, soft_pwm_count_5);
+            soft_pwm_limit_bed = bed_power_limit(hotend_on);
+          }
+          soft_pwm_count_BED = (soft_pwm_count_BED & pwm_mask) + soft_pwm_amount_bed;
+          NOMORE(soft_pwm_count_BED, soft_pwm_limit_bed);
+          WRITE_HEATER_BED(pwm_count_tmp + soft_pwm_count_BED >= 127 ? HIGH : LOW);
+        #else
+          _PWM_MOD(WRITE_HEATER_BED, soft_pwm_count_BED, soft_pwm_amount_bed, PWM_PHASE_BED);
+        #endif
       #endif
 
       #if ENABLED(FAN_SOFT_PWM)
         #if HAS_FAN0
-          soft_pwm_count_fan[0] = (soft_pwm_count_fan[0] & pwm_mask) + (soft_pwm_amount_fan[0] >> 1);
-          WRITE_FAN(soft_pwm_count_fan[0] > pwm_mask ? HIGH : LOW);
+          _PWM_MOD(WRITE_FAN, soft_pwm_count_fan[0], soft_pwm_amount_fan[0] >> 1, PWM_PHASE_FAN(0));
         #endif
         #if HAS_FAN1
-          soft_pwm_count_fan[1] = (soft_pwm_count_fan[1] & pwm_mask) + (soft_pwm_amount_fan[1] >> 1);
-          WRITE_FAN1(soft_pwm_count_fan[1] > pwm_mask ? HIGH : LOW);
+          _PWM_MOD(WRITE_FAN1, soft_pwm_count_fan[1], soft_pwm_amount_fan[1] >> 1, PWM_PHASE_FAN(1));
         #endif
         #if HAS_FAN2
-          soft_pwm_count_fan[2] = (soft_pwm_count_fan[2] & pwm_mask) + (soft_pwm_amount_fan[2] >> 1);
-          WRITE_FAN2(soft_pwm_count_fan[2] > pwm_mask ? HIGH : LOW);
+          _PWM_MOD(WRITE_FAN2, soft_pwm_count_fan[2], soft_pwm_amount_fan[2] >> 1, PWM_PHASE_FAN(2));
         #endif
       #endif
     }
     else {
-      if (soft_pwm_count_0 <= pwm_count_tmp) WRITE_HEATER_0(LOW);
+      PWM_LOW_E0();
       #if HOTENDS > 1
-        if (soft_pwm_count_1 <= pwm_count_tmp) WRITE_HEATER_1(LOW);
+        PWM_LOW_E1();
         #if HOTENDS > 2
-          if (soft_pwm_count_2 <= pwm_count_tmp) WRITE_HEATER_2(LOW);
+          PWM_LOW_E2();
           #if HOTENDS > 3
-            if (soft_pwm_count_3 <= pwm_count_tmp) WRITE_HEATER_3(LOW);
+            PWM_LOW_E3();
             #if HOTENDS > 4
-              if (soft_pwm_count_4 <= pwm_count_tmp) WRITE_HEATER_4(LOW);
+              PWM_LOW_E4();
               #if HOTENDS > 5
-                if (soft_pwm_count_5 <= pwm_count_tmp) WRITE_HEATER_5(LOW);
+                PWM_LOW_E5();
               #endif // HOTENDS > 5
             #endif // HOTENDS > 4
           #endif // HOTENDS > 3
         #endif // HOTENDS > 2
       #endif // HOTENDS > 1
 
-      #if HAS_HEATED_BED
-        if (soft_pwm_count_BED <= pwm_count_tmp) WRITE_HEATER_BED(LOW);
+      #if HAS_HEATED_BED && DISABLED(HEATER_BED_HARDWARE_PWM)
+        #if ENABLED(HEATER_POWER_BUDGET)
+          WRITE_HEATER_BED(pwm_count_tmp + soft_pwm_count_BED >= 127 ? HIGH : LOW);
+        #else
+          _PWM_LOW(WRITE_HEATER_BED, soft_pwm_count_BED, PWM_PHASE_BED);
+        #endif
       #endif
 
       #if ENABLED(FAN_SOFT_PWM)
         #if HAS_FAN0
-          if (soft_pwm_count_fan[0] <= pwm_count_tmp) WRITE_FAN(LOW);
+          _PWM_LOW(WRITE_FAN, soft_pwm_count_fan[0], PWM_PHASE_FAN(0));
         #endif
         #if HAS_FAN1
-          if (soft_pwm_count_fan[1] <= pwm_count_tmp) WRITE_FAN1(LOW);
+          _PWM_LOW(WRITE_FAN1, soft_pwm_count_fan[1], PWM_PHASE_FAN(1));
         #endif
         #if HAS_FAN2
-          if (soft_pwm_count_fan[2] <= pwm_count_tmp) WRITE_FAN2(LOW);
+          _PWM_LOW(WRITE_FAN2, soft_pwm_count_fan[2], PWM_PHASE_FAN(2));
         #endif
       #endif
     }
@@ -2320,162 +2871,230 @@ void Temperature::isr() {
   static bool do_buttons;
   if ((do_buttons ^= true)) ui.update_buttons();
 
-  /**
-   * One sensor is sampled on every other call of the ISR.
-   * Each sensor is read 16 (OVERSAMPLENR) times, taking the average.
-   *
-   * On each Prepare pass, ADC is started for a sensor pin.
-   * On the next pass, the ADC value is read and accumulated.
-   *
-   * This gives each ADC 0.9765ms to charge up.
-   */
-  #define ACCUMULATE_ADC(var) do{ \
-    if (!HAL_ADC_READY()) next_sensor_state = adc_sensor_state; \
-    else var += HAL_READ_ADC(); \
-  }while(0)
-
-  ADCSensorState next_sensor_state = adc_sensor_state < SensorsReady ? (ADCSensorState)(int(adc_sensor_state) + 1) : StartSampling;
-
-  switch (adc_sensor_state) {
-
-    case SensorsReady: {
-      // All sensors have been read. Stay in this state for a few
-      // ISRs to save on calls to temp update/checking code below.
-      constexpr int8_t extra_loops = MIN_ADC_ISR_LOOPS - (int8_t)SensorsReady;
-      static uint8_t delay_count = 0;
-      if (extra_loops > 0) {
-        if (delay_count == 0) delay_count = extra_loops;  // Init this delay
-        if (--delay_count)                                // While delaying...
-          next_sensor_state = SensorsReady;               // retain this state (else, next state will be 0)
-        break;
-      }
-      else {
-        adc_sensor_state = StartSampling;                 // Fall-through to start sampling
-        next_sensor_state = (ADCSensorState)(int(StartSampling) + 1);
-      }
-    }
+  #if ENABLED(CONTINUOUS_ADC)
+
+    /**
+     * The HAL scans all sensors continuously, keeping the last OVERSAMPLENR
+     * readings of each. Sum them only when the readings are due, at the same
+     * rate as the state machine below, so PID_dT stays the same.
+     */
+    static uint8_t adc_loops = 0;
+    if (++adc_loops >= ACTUAL_ADC_SAMPLES) {
+      adc_loops = 0;
+
+      #if ENABLED(FILAMENT_WIDTH_SENSOR)
+        const uint32_t filwidth = HAL_adc_scan_sum(ADCScan_FILWIDTH) / (OVERSAMPLENR);
+        if (filwidth > 102) { // Make sure ADC is reading > 0.5 volts, otherwise don't read.
+          raw_filwidth_value -= raw_filwidth_value >> 7; // Subtract 1/128th of the raw_filwidth_value
+          raw_filwidth_value += filwidth << 7; // Add new ADC reading, scaled by 128
+        }
+      #endif
+
+      #if HAS_ADC_BUTTONS
+        if (ADCKey_count < 16) {
+          raw_ADCKey_value = HAL_adc_scan_sum(ADCScan_ADC_KEY) / (OVERSAMPLENR);
+          if (raw_ADCKey_value > 900) {
+            //ADC Key release
+            ADCKey_count = 0;
+            current_ADCKey_raw = 0;
+          }
+          else {
+            current_ADCKey_raw += raw_ADCKey_value;
+            ADCKey_count++;
+          }
+        }
+      #endif
 
-    case StartSampling:                                   // Start of sampling loops. Do updates/checks.
-      if (++temp_count >= OVERSAMPLENR) {                 // 10 * 16 * 1/(16000000/64/256)  = 164ms.
+      if (++temp_count >= OVERSAMPLENR) {               // 10 * 16 * 1/(16000000/64/256)  = 164ms.
         temp_count = 0;
+        #if HAS_TEMP_ADC_0
+          raw_temp_value[0] = HAL_adc_scan_sum(ADCScan_0);
+        #endif
+        #if HAS_TEMP_ADC_1
+          raw_temp_value[1] = HAL_adc_scan_sum(ADCScan_1);
+        #endif
+        #if HAS_TEMP_ADC_2
+          raw_temp_value[2] = HAL_adc_scan_sum(ADCScan_2);
+        #endif
+        #if HAS_TEMP_ADC_3
+          raw_temp_value[3] = HAL_adc_scan_sum(ADCScan_3);
+        #endif
+        #if HAS_TEMP_ADC_4
+          raw_temp_value[4] = HAL_adc_scan_sum(ADCScan_4);
+        #endif
+        #if HAS_TEMP_ADC_5
+          raw_temp_value[5] = HAL_adc_scan_sum(ADCScan_5);
+        #endif
+        #if HAS_HEATED_BED
+          raw_temp_bed_value = HAL_adc_scan_sum(ADCScan_BED);
+        #endif
+        #if HAS_TEMP_CHAMBER
+          raw_temp_chamber_value = HAL_adc_scan_sum(ADCScan_CHAMBER);
+        #endif
         readings_ready();
       }
-      break;
+    }
 
-    #if HAS_TEMP_ADC_0
-      case PrepareTemp_0:
-        HAL_START_ADC(TEMP_0_PIN);
-        break;
-      case MeasureTemp_0:
-        ACCUMULATE_ADC(raw_temp_value[0]);
-        break;
-    #endif
+  #else // !CONTINUOUS_ADC
 
-    #if HAS_HEATED_BED
-      case PrepareTemp_BED:
-        HAL_START_ADC(TEMP_BED_PIN);
-        break;
-      case MeasureTemp_BED:
-        ACCUMULATE_ADC(raw_temp_bed_value);
-        break;
-    #endif
+    /**
+     * One sensor is sampled on every other call of the ISR.
+     * Each sensor is read 16 (OVERSAMPLENR) times, taking the average.
+     *
+     * On each Prepare pass, ADC is started for a sensor pin.
+     * On the next pass, the ADC value is read and accumulated.
+     *
+     * This gives each ADC 0.9765ms to charge up.
+     */
+    #define ACCUMULATE_ADC(var) do{ \
+      if (!HAL_ADC_READY()) next_sensor_state = adc_sensor_state; \
+      else var += HAL_READ_ADC(); \
+    }while(0)
+
+    ADCSensorState next_sensor_state = adc_sensor_state < SensorsReady ? (ADCSensorState)(int(adc_sensor_state) + 1) : StartSampling;
+
+    switch (adc_sensor_state) {
+
+      case SensorsReady: {
+        // All sensors have been read. Stay in this state for a few
+        // ISRs to save on calls to temp update/checking code below.
+        constexpr int8_t extra_loops = MIN_ADC_ISR_LOOPS - (int8_t)SensorsReady;
+        static uint8_t delay_count = 0;
+        if (extra_loops > 0) {
+          if (delay_count == 0) delay_count = extra_loops;  // Init this delay
+          if (--delay_count)                                // While delaying...
+            next_sensor_state = SensorsReady;               // retain this state (else, next state will be 0)
+          break;
+        }
+        else {
+          adc_sensor_state = StartSampling;                 // Fall-through to start sampling
+          next_sensor_state = (ADCSensorState)(int(StartSampling) + 1);
+        }
+      }
 
-    #if HAS_TEMP_CHAMBER
-      case PrepareTemp_CHAMBER:
-        HAL_START_ADC(TEMP_CHAMBER_PIN);
-        break;
-      case MeasureTemp_CHAMBER:
-        ACCUMULATE_ADC(raw_temp_chamber_value);
+      case StartSampling:                                   // Start of sampling loops. Do updates/checks.
+        if (++temp_count >= OVERSAMPLENR) {                 // 10 * 16 * 1/(16000000/64/256)  = 164ms.
+          temp_count = 0;
+          readings_ready();
+        }
         break;
-    #endif
 
-    #if HAS_TEMP_ADC_1
-      case PrepareTemp_1:
-        HAL_START_ADC(TEMP_1_PIN);
-        break;
-      case MeasureTemp_1:
-        ACCUMULATE_ADC(raw_temp_value[1]);
-        break;
-    #endif
+      #if HAS_TEMP_ADC_0
+        case PrepareTemp_0:
+          HAL_START_ADC(TEMP_0_PIN);
+          break;
+        case MeasureTemp_0:
+          ACCUMULATE_ADC(raw_temp_value[0]);
+          break;
+      #endif
 
-    #if HAS_TEMP_ADC_2
-      case PrepareTemp_2:
-        HAL_START_ADC(TEMP_2_PIN);
-        break;
-      case MeasureTemp_2:
-        ACCUMULATE_ADC(raw_temp_value[2]);
-        break;
-    #endif
+      #if HAS_HEATED_BED
+        case PrepareTemp_BED:
+          HAL_START_ADC(TEMP_BED_PIN);
+          break;
+        case MeasureTemp_BED:
+          ACCUMULATE_ADC(raw_temp_bed_value);
+          break;
+      #endif
 
-    #if HAS_TEMP_ADC_3
-      case PrepareTemp_3:
-        HAL_START_ADC(TEMP_3_PIN);
-        break;
-      case MeasureTemp_3:
-        ACCUMULATE_ADC(raw_temp_value[3]);
-        break;
-    #endif
+      #if HAS_TEMP_CHAMBER
+        case PrepareTemp_CHAMBER:
+          HAL_START_ADC(TEMP_CHAMBER_PIN);
+          break;
+        case MeasureTemp_CHAMBER:
+          ACCUMULATE_ADC(raw_temp_chamber_value);
+          break;
+      #endif
 
-    #if HAS_TEMP_ADC_4
-      case PrepareTemp_4:
-        HAL_START_ADC(TEMP_4_PIN);
-        break;
-      case MeasureTemp_4:
-        ACCUMULATE_ADC(raw_temp_value[4]);
-        break;
-    #endif
+      #if HAS_TEMP_ADC_1
+        case PrepareTemp_1:
+          HAL_START_ADC(TEMP_1_PIN);
+          break;
+        case MeasureTemp_1:
+          ACCUMULATE_ADC(raw_temp_value[1]);
+          break;
+      #endif
 
-    #if HAS_TEMP_ADC_5
-      case PrepareTemp_5:
-        HAL_START_ADC(TEMP_5_PIN);
-        break;
-      case MeasureTemp_5:
-        ACCUMULATE_ADC(raw_temp_value[5]);
-        break;
-    #endif
+      #if HAS_TEMP_ADC_2
+        case PrepareTemp_2:
+          HAL_START_ADC(TEMP_2_PIN);
+          break;
+        case MeasureTemp_2:
+          ACCUMULATE_ADC(raw_temp_value[2]);
+          break;
+      #endif
 
-    #if ENABLED(FILAMENT_WIDTH_SENSOR)
-      case Prepare_FILWIDTH:
-        HAL_START_ADC(FILWIDTH_PIN);
-      break;
-      case Measure_FILWIDTH:
-        if (!HAL_ADC_READY())
-          next_sensor_state = adc_sensor_state; // redo this state
-        else if (HAL_READ_ADC() > 102) { // Make sure ADC is reading > 0.5 volts, otherwise don't read.
-          raw_filwidth_value -= raw_filwidth_value >> 7; // Subtract 1/128th of the raw_filwidth_value
-          raw_filwidth_value += uint32_t(HAL_READ_ADC()) << 7; // Add new ADC reading, scaled by 128
-        }
-      break;
-    #endif
+      #if HAS_TEMP_ADC_3
+        case PrepareTemp_3:
+          HAL_START_ADC(TEMP_3_PIN);
+          break;
+        case MeasureTemp_3:
+          ACCUMULATE_ADC(raw_temp_value[3]);
+          break;
+      #endif
 
-    #if HAS_ADC_BUTTONS
-      case Prepare_ADC_KEY:
-        HAL_START_ADC(ADC_KEYPAD_PIN);
+      #if HAS_TEMP_ADC_4
+        case PrepareTemp_4:
+          HAL_START_ADC(TEMP_4_PIN);
+          break;
+        case MeasureTemp_4:
+          ACCUMULATE_ADC(raw_temp_value[4]);
+          break;
+      #endif
+
+      #if HAS_TEMP_ADC_5
+        case PrepareTemp_5:
+          HAL_START_ADC(TEMP_5_PIN);
+          break;
+        case MeasureTemp_5:
+          ACCUMULATE_ADC(raw_temp_value[5]);
+          break;
+      #endif
+
+      #if ENABLED(FILAMENT_WIDTH_SENSOR)
+        case Prepare_FILWIDTH:
+          HAL_START_ADC(FILWIDTH_PIN);
         break;
-      case Measure_ADC_KEY:
-        if (!HAL_ADC_READY())
-          next_sensor_state = adc_sensor_state; // redo this state
-        else if (ADCKey_count < 16) {
-          raw_ADCKey_value = HAL_READ_ADC();
-          if (raw_ADCKey_value > 900) {
-            //ADC Key release
-            ADCKey_count = 0;
-            current_ADCKey_raw = 0;
+        case Measure_FILWIDTH:
+          if (!HAL_ADC_READY())
+            next_sensor_state = adc_sensor_state; // redo this state
+          else if (HAL_READ_ADC() > 102) { // Make sure ADC is reading > 0.5 volts, otherwise don't read.
+            raw_filwidth_value -= raw_filwidth_value >> 7; // Subtract 1/128th of the raw_filwidth_value
+            raw_filwidth_value += uint32_t(HAL_READ_ADC()) << 7; // Add new ADC reading, scaled by 128
           }
-          else {
-            current_ADCKey_raw += raw_ADCKey_value;
-            ADCKey_count++;
-          }
-        }
         break;
-    #endif // ADC_KEYPAD
+      #endif
+
+      #if HAS_ADC_BUTTONS
+        case Prepare_ADC_KEY:
+          HAL_START_ADC(ADC_KEYPAD_PIN);
+          break;
+        case Measure_ADC_KEY:
+          if (!HAL_ADC_READY())
+            next_sensor_state = adc_sensor_state; // redo this state
+          else if (ADCKey_count < 16) {
+            raw_ADCKey_value = HAL_READ_ADC();
+            if (raw_ADCKey_value > 900) {
+              //ADC Key release
+              ADCKey_count = 0;
+              current_ADCKey_raw = 0;
+            }
+            else {
+              current_ADCKey_raw += raw_ADCKey_value;
+              ADCKey_count++;
+            }
+          }
+          break;
+      #endif // ADC_KEYPAD
 
-    case StartupDelay: break;
+      case StartupDelay: break;
 
-  } // switch(adc_sensor_state)
+    } // switch(adc_sensor_state)
 
-  // Go to the next state
-  adc_sensor_state = next_sensor_state;
+    // Go to the next state
+    adc_sensor_state = next_sensor_state;
+
+  #endif // !CONTINUOUS_ADC
 
   //
   // Additional ~1KHz Tasks
@@ -2661,13 +3280,114 @@ void Temperature::isr() {
     uint8_t Temperature::auto_report_temp_interval;
     millis_t Temperature::next_temp_report_ms;
 
-    void Temperature::auto_report_temperatures() {
-      if (auto_report_temp_interval && ELAPSED(millis(), next_temp_report_ms)) {
-        next_temp_report_ms = millis() + 1000UL * auto_report_temp_interval;
-        PORT_REDIRECT(SERIAL_BOTH);
-        print_heater_states(active_extruder);
-        SERIAL_EOL();
+    #if ENABLED(AUTO_REPORT_TEMPERATURE_CHANGES)
+
+      bool Temperature::auto_report_readings_ready, // = false
+           Temperature::auto_report_compact;        // = false
+      float Temperature::auto_report_delta = AUTO_REPORT_TEMPERATURE_DELTA;
+
+      // Values sent in the last report
+      #if HAS_TEMP_HOTEND
+        static float reported_temp[HOTENDS];
+        static int16_t reported_target[HOTENDS];
+      #endif
+      #if HAS_HEATED_BED
+        static float reported_temp_bed;
+        static int16_t reported_target_bed;
+      #endif
+      #if HAS_TEMP_CHAMBER
+        static float reported_temp_chamber;
+      #endif
+
+      /**
+       * Return true if a temperature moved more than the threshold since
+       * the last report, or a target changed. Remember the values to report.
+       */
+      static bool temperatures_changed() {
+        bool changed = false;
+        #define _CHANGED(V, R, D) do{ if (ABS((V) - (R)) > (D)) { R = V; changed = true; } }while(0)
+        #if HAS_TEMP_HOTEND
+          HOTEND_LOOP() {
+            _CHANGED(thermalManager.degHotend(e), reported_temp[e], thermalManager.auto_report_delta);
+            _CHANGED(thermalManager.degTargetHotend(e), reported_target[e], 0);
+          }
+        #endif
+        #if HAS_HEATED_BED
+          _CHANGED(thermalManager.degBed(), reported_temp_bed, thermalManager.auto_report_delta);
+          _CHANGED(thermalManager.degTargetBed(), reported_target_bed, 0);
+        #endif
+        #if HAS_TEMP_CHAMBER
+          _CHANGED(thermalManager.degChamber(), reported_temp_chamber, thermalManager.auto_report_delta);
+        #endif
+        #undef _CHANGED
+        return changed;
+      }
+
+      /**
+       * Compact report with one decimal and no duplicate entry for the
+       * active hotend, e.g. " T:210.3/210 B:60.1/60 @:74 B@:127"
+       */
+      static void print_heater_states_compact() {
+        #if HAS_TEMP_HOTEND
+          HOTEND_LOOP() {
+            SERIAL_ECHOPGM(" T");
+            #if HOTENDS > 1
+              SERIAL_CHAR('0' + e);
+            #endif
+            SERIAL_CHAR(':');
+            SERIAL_ECHO_F(thermalManager.degHotend(e), 1);
+            SERIAL_CHAR('/');
+            SERIAL_ECHO(thermalManager.degTargetHotend(e));
+          }
+        #endif
+        #if HAS_HEATED_BED
+          SERIAL_ECHOPGM(" B:");
+          SERIAL_ECHO_F(thermalManager.degBed(), 1);
+          SERIAL_CHAR('/');
+          SERIAL_ECHO(thermalManager.degTargetBed());
+        #endif
+        #if HAS_TEMP_CHAMBER
+          SERIAL_ECHOPGM(" C:");
+          SERIAL_ECHO_F(thermalManager.degChamber(), 1);
+        #endif
+        #if HAS_TEMP_HOTEND
+          HOTEND_LOOP() {
+            SERIAL_ECHOPGM(" @");
+            #if HOTENDS > 1
+              SERIAL_CHAR('0' + e);
+            #endif
+            SERIAL_CHAR(':');
+            SERIAL_ECHO(thermalManager.getHeaterPower(e));
+          }
+        #endif
+        #if HAS_HEATED_BED
+          SERIAL_ECHOPGM(" B@:");
+          SERIAL_ECHO(thermalManager.getHeaterPower(-1));
+        #endif
       }
+
+    #endif // AUTO_REPORT_TEMPERATURE_CHANGES
+
+    void Temperature::auto_report_temperatures() {
+      #if ENABLED(AUTO_REPORT_TEMPERATURE_CHANGES)
+        // Only look at new readings. Report when something changed, or
+        // when the interval has passed without a report.
+        if (!auto_report_temp_interval || !auto_report_readings_ready) return;
+        auto_report_readings_ready = false;
+        const bool changed = temperatures_changed();
+        if (!changed && PENDING(millis(), next_temp_report_ms)) return;
+      #else
+        if (!auto_report_temp_interval || PENDING(millis(), next_temp_report_ms)) return;
+      #endif
+      next_temp_report_ms = millis() + 1000UL * auto_report_temp_interval;
+      PORT_REDIRECT(SERIAL_BOTH);
+      #if ENABLED(AUTO_REPORT_TEMPERATURE_CHANGES)
+        if (auto_report_compact)
+          print_heater_states_compact();
+        else
+      #endif
+          print_heater_states(active_extruder);
+      SERIAL_EOL();
     }
 
   #endif // AUTO_REPORT_TEMPERATURES
@@ -2933,4 +3653,43 @@ void Temperature::isr() {
 
   #endif // HAS_HEATED_BED
 
+  #if ENABLED(TEMPERATURE_BARRIERS)
+
+    /**
+     * Instead of waiting now, as M109 and M190 do, wait for a heater
+     * before the next move that extrudes. Heater -1 is the bed.
+     */
+    void Temperature::set_barrier(const int8_t heater, const bool no_wait_for_cooling) {
+      const uint8_t bit = heater < 0 ? 7 : heater;
+      SBI(barriers, bit);
+      if (no_wait_for_cooling) CBI(barriers_cooling, bit); else SBI(barriers_cooling, bit);
+    }
+
+    /**
+     * Wait for the heaters with a barrier set. Each barrier is cleared as
+     * its wait starts, so M108 or a heater error abandons it for good.
+     */
+    void Temperature::wait_for_barriers() {
+      #if HAS_TEMP_HOTEND
+        HOTEND_LOOP() if (TEST(barriers, e)) {
+          CBI(barriers, e);
+          #if ENABLED(ULTRA_LCD) || ENABLED(EXTENSIBLE_UI)
+            if (isHeatingHotend(e)) set_heating_message(e);
+          #endif
+          (void)wait_for_hotend(e, !TEST(barriers_cooling, e));
+        }
+      #endif
+      #if HAS_HEATED_BED
+        if (TEST(barriers, 7)) {
+          CBI(barriers, 7);
+          #if ENABLED(ULTRA_LCD) || ENABLED(EXTENSIBLE_UI)
+            if (isHeatingBed()) ui.set_status_P(PSTR(MSG_BED_HEATING));
+          #endif
+          (void)wait_for_bed(!TEST(barriers_cooling, 7));
+        }
+      #endif
+    }
+
+  #endif // TEMPERATURE_BARRIERS
+
 #endif // HAS_TEMP_SENSOR
@@ -51,6 +51,14 @@ typedef struct { float Kp, Ki, Kd, Kc; } PIDC_t;
   typedef PID_t hotend_pid_t;
 #endif
 
+#if ENABLED(EXTRUSION_FEEDFORWARD)
+  // Feedforward coefficients, in heater PWM units
+  typedef struct {
+    float flow,   // Per mm³/s of extrusion
+          fan;    // At full part-cooling fan speed
+  } feedforward_t;
+#endif
+
 #define DUMMY_PID_VALUE 3000.0f
 
 #if ENABLED(PIDTEMP)
@@ -116,6 +124,45 @@ enum ADCSensorState : char {
   StartupDelay  // Startup, delay initial temp reading a tiny bit so the hardware can settle
 };
 
+#if ENABLED(CONTINUOUS_ADC)
+  /**
+   * Positions of the sensor pins in the continuous ADC scan
+   */
+  enum ADCScanIndex : uint8_t {
+    #if HAS_TEMP_ADC_0
+      ADCScan_0,
+    #endif
+    #if HAS_TEMP_ADC_1
+      ADCScan_1,
+    #endif
+    #if HAS_TEMP_ADC_2
+      ADCScan_2,
+    #endif
+    #if HAS_TEMP_ADC_3
+      ADCScan_3,
+    #endif
+    #if HAS_TEMP_ADC_4
+      ADCScan_4,
+    #endif
+    #if HAS_TEMP_ADC_5
+      ADCScan_5,
+    #endif
+    #if HAS_HEATED_BED
+      ADCScan_BED,
+    #endif
+    #if HAS_TEMP_CHAMBER
+      ADCScan_CHAMBER,
+    #endif
+    #if ENABLED(FILAMENT_WIDTH_SENSOR)
+      ADCScan_FILWIDTH,
+    #endif
+    #if HAS_ADC_BUTTONS
+      ADCScan_ADC_KEY,
+    #endif
+    ADCScan_COUNT
+  };
+#endif
+
 // Minimum number of Temperature::ISR loops between sensor readings.
 // Multiplied by 16 (OVERSAMPLENR) to obtain the total time to
 // get all oversampled sensor readings
@@ -164,6 +211,9 @@ class Temperature {
       static float current_temperature_bed;
       static int16_t current_temperature_bed_raw, target_temperature_bed;
       static uint8_t soft_pwm_amount_bed;
+      #if ENABLED(HEATER_POWER_BUDGET)
+        static uint8_t soft_pwm_limit_bed;
+      #endif
       #if ENABLED(PIDTEMPBED)
         static PID_t bed_pid;
       #endif
@@ -294,6 +344,10 @@ class Temperature {
       static int16_t lpq_len;
     #endif
 
+    #if ENABLED(EXTRUSION_FEEDFORWARD)
+      static feedforward_t feedforward[HOTENDS];
+    #endif
+
     /**
      * Instance Methods
      */
@@ -532,6 +586,13 @@ class Temperature {
 
     #endif // HAS_HEATED_BED
 
+    #if ENABLED(TEMPERATURE_BARRIERS)
+      // Heaters to reach their targets before the next extruding move. Bits 0-5 are hotends, bit 7 the bed.
+      static uint8_t barriers, barriers_cooling;
+      static void set_barrier(const int8_t heater, const bool no_wait_for_cooling);
+      static void wait_for_barriers();
+    #endif
+
     #if HAS_TEMP_CHAMBER
       #if ENABLED(SHOW_TEMP_ADC_VALUES)
         FORCE_INLINE static int16_t rawChamberTemp() { return current_temperature_chamber_raw; }
@@ -559,6 +620,10 @@ class Temperature {
     #if HAS_PID_HEATING
       static void PID_autotune(const float &target, const int8_t hotend, const int8_t ncycles, const bool set_result=false);
 
+      #if ENABLED(PID_AUTOTUNE_FOPDT)
+        static void PID_autotune_fopdt(const float &target, const int8_t hotend, const bool set_result=false);
+      #endif
+
       #if ENABLED(NO_FAN_SLOWING_IN_PID_TUNING)
         static bool adaptive_fan_slowing;
       #elif ENABLED(ADAPTIVE_FAN_SLOWING)
@@ -640,6 +705,10 @@ class Temperature {
         static uint8_t auto_report_temp_interval;
         static millis_t next_temp_report_ms;
         static void auto_report_temperatures(void);
+        #if ENABLED(AUTO_REPORT_TEMPERATURE_CHANGES)
+          static bool auto_report_readings_ready, auto_report_compact;
+          static float auto_report_delta;
+        #endif
         static inline void set_auto_report_interval(uint8_t v) {
           NOMORE(v, 60);
           auto_report_temp_interval = v;
@@ -683,8 +752,16 @@ class Temperature {
 
     static void checkExtruderAutoFans();
 
+    #if ENABLED(EXTRUSION_FEEDFORWARD)
+      static float get_feedforward(const int8_t e);
+    #endif
+
     static float get_pid_output(const int8_t e);
 
+    #if HAS_PID_HEATING
+      static void PID_autotune_finished(const int8_t heater, const PID_t &tune_pid, const bool set_result);
+    #endif
+
     #if ENABLED(PIDTEMPBED)
       static float get_pid_output_bed();
     #endif
@@ -21,7 +21,7 @@
  */
 
  // 100k bed thermistor in JGAurora A5. Calibrated by Sam Pinches 21st Jan 2018 using cheap k-type thermocouple inserted into heater block, using TM-902C meter.
-const short temptable_15[][2] PROGMEM = {
+constexpr short temptable_15[][2] PROGMEM = {
   { OV(  31), 275 },
   { OV(  33), 270 },
   { OV(  35), 260 },
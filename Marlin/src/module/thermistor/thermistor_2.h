@@ -25,7 +25,7 @@
 // Verified by linagee. Source: http://shop.arcol.hu/static/datasheets/thermistors.pdf
 // Calculated using 4.7kohm pullup, voltage divider math, and manufacturer provided temp/resistance
 //
-const short temptable_2[][2] PROGMEM = {
+constexpr short temptable_2[][2] PROGMEM = {
   { OV(   1), 848 },
   { OV(  30), 300 }, // top rating 300C
   { OV(  34), 290 },
@@ -51,7 +51,7 @@
   #define HEATER_CHAMBER_RAW_HI_TEMP 16383
   #define HEATER_CHAMBER_RAW_LO_TEMP 0
 #endif
-const short temptable_20[][2] PROGMEM = {
+constexpr short temptable_20[][2] PROGMEM = {
   { OV(  0),    0 },
   { OV(227),    1 },
   { OV(236),   10 },
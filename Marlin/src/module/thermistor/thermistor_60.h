@@ -30,7 +30,7 @@
 // beta: 3950
 // min adc: 1 at 0.0048828125 V
 // max adc: 1023 at 4.9951171875 V
-const short temptable_60[][2] PROGMEM = {
+constexpr short temptable_60[][2] PROGMEM = {
   { OV(  51), 272 },
   { OV(  61), 258 },
   { OV(  71), 247 },
@@ -29,7 +29,7 @@
 // Resistance Tolerance     + / -1%
 // B Value             3950K at 25/50 deg. C
 // B Value Tolerance         + / - 1%
-const short temptable_61[][2] PROGMEM = {
+constexpr short temptable_61[][2] PROGMEM = {
   { OV(   2.00), 420 }, // Guestimate to ensure we dont lose a reading and drop temps to -50 when over
   { OV(  12.07), 350 },
   { OV(  12.79), 345 },
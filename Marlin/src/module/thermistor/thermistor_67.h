@@ -21,7 +21,7 @@
  */
 
 // R25 = 500 KOhm, beta25 = 3800 K, 4.7 kOhm pull-up, SliceEngineering 450 °C Thermistor
-const short temptable_67[][2] PROGMEM = {
+constexpr short temptable_67[][2] PROGMEM = {
   { OV(  22 ),  500 },
   { OV(  23 ),  490 },
   { OV(  25 ),  480 },
@@ -33,7 +33,7 @@
 
 //#define HIGH_TEMP_RANGE_75
 
-const short temptable_75[][2] PROGMEM = { // Generic Silicon Heat Pad with NTC 100K MGB18-104F39050L32 thermistor
+constexpr short temptable_75[][2] PROGMEM = { // Generic Silicon Heat Pad with NTC 100K MGB18-104F39050L32 thermistor
   { OV(111.06), 200 }, // v=0.542 r=571.747 res=0.501 degC/count
 
   #ifdef HIGH_TEMP_RANGE_75
@@ -75,5 +75,5 @@ const short temptable_75[][2] PROGMEM = { // Generic Silicon Heat Pad with NTC 1
   { OV(986.70),  20 }, // v=4.818 r=124318.354 res=0.638 degC/count
   { OV(993.94),  15 }, // v=4.853 r=155431.302 res=0.768 degC/count
   { OV(999.96),  10 }, // v=4.883 r=195480.023 res=0.934 degC/count
-  { OV(008.95),   0 }  // v=4.926 r=314997.575 res=1.418 degC/count
+  { OV(1008.95),  0 }  // v=4.926 r=314997.575 res=1.418 degC/count
 };
@@ -21,7 +21,7 @@
  */
 
 // R25 = 100 kOhm, beta25 = 3950 K, 10 kOhm pull-up, NTCS0603E3104FHT
-const short temptable_8[][2] PROGMEM = {
+constexpr short temptable_8[][2] PROGMEM = {
   { OV(   1), 704 },
   { OV(  54), 216 },
   { OV( 107), 175 },
@@ -209,11 +209,53 @@
   #define CHAMBERTEMPTABLE_LEN 0
 #endif
 
-// The SCAN_THERMISTOR_TABLE macro needs alteration?
+// TT_LUT and LOOKUP_THERMISTOR_LUT need alteration?
 static_assert(HEATER_0_TEMPTABLE_LEN < 256 && HEATER_1_TEMPTABLE_LEN < 256 && HEATER_2_TEMPTABLE_LEN < 256 && HEATER_3_TEMPTABLE_LEN < 256 && HEATER_4_TEMPTABLE_LEN < 256 && BEDTEMPTABLE_LEN < 256 && CHAMBERTEMPTABLE_LEN < 256,
   "Temperature conversion tables over 255 entries need special consideration."
 );
 
+/**
+ * Uniformly indexed copies of the tables above, built by the compiler.
+ * Entry i is the temperature at raw value i * THERMISTOR_LUT_STEP (one
+ * ADC count) in 1/THERMISTOR_LUT_SCALE degrees, interpolated like the
+ * table scan does. Converting a reading is then a lookup by the top bits
+ * of the raw value and one multiply, instead of a binary search and a
+ * float division. Each table takes 2K of flash.
+ */
+#define THERMISTOR_LUT_SHIFT 4
+#define THERMISTOR_LUT_STEP  (1 << (THERMISTOR_LUT_SHIFT))
+#define THERMISTOR_LUT_SCALE 16
+
+constexpr int16_t _tt_lut_segment(const short (*tbl)[2], const int32_t raw, const uint8_t i) {
+  return tbl[i][1] * (THERMISTOR_LUT_SCALE)
+       + (raw - tbl[i][0]) * (tbl[i + 1][1] - tbl[i][1]) * (THERMISTOR_LUT_SCALE) / (tbl[i + 1][0] - tbl[i][0]);
+}
+constexpr int16_t _tt_lut_search(const short (*tbl)[2], const uint8_t len, const int32_t raw, const uint8_t i) {
+  return raw <= tbl[i + 1][0] ? _tt_lut_segment(tbl, raw, i) : _tt_lut_search(tbl, len, raw, i + 1);
+}
+// Outside the table, continue its first or last segment, for the lookup's edge intervals
+constexpr int16_t tt_lut_value(const short (*tbl)[2], const uint8_t len, const int32_t raw) {
+  return raw <= tbl[0][0] ? _tt_lut_segment(tbl, raw, 0)
+       : raw >= tbl[len - 1][0] ? _tt_lut_segment(tbl, raw, len - 2)
+       : _tt_lut_search(tbl, len, raw, 0);
+}
+
+#define _TT_LUT1(T,I)    tt_lut_value(T, COUNT(T), int32_t(I) << (THERMISTOR_LUT_SHIFT))
+#define _TT_LUT2(T,I)    _TT_LUT1(T,I), _TT_LUT1(T,(I)+1)
+#define _TT_LUT4(T,I)    _TT_LUT2(T,I), _TT_LUT2(T,(I)+2)
+#define _TT_LUT8(T,I)    _TT_LUT4(T,I), _TT_LUT4(T,(I)+4)
+#define _TT_LUT16(T,I)   _TT_LUT8(T,I), _TT_LUT8(T,(I)+8)
+#define _TT_LUT32(T,I)   _TT_LUT16(T,I), _TT_LUT16(T,(I)+16)
+#define _TT_LUT64(T,I)   _TT_LUT32(T,I), _TT_LUT32(T,(I)+32)
+#define _TT_LUT128(T,I)  _TT_LUT64(T,I), _TT_LUT64(T,(I)+64)
+#define _TT_LUT256(T,I)  _TT_LUT128(T,I), _TT_LUT128(T,(I)+128)
+#define _TT_LUT512(T,I)  _TT_LUT256(T,I), _TT_LUT256(T,(I)+256)
+#define _TT_LUT1024(T,I) _TT_LUT512(T,I), _TT_LUT512(T,(I)+512)
+
+// 1025 entries cover raw values 0-16384, the 10-bit ADC range oversampled
+#define TT_LUT(T) { _TT_LUT1024(T,0), _TT_LUT1(T,1024) }
+static_assert(THERMISTOR_LUT_STEP == OVERSAMPLENR, "TT_LUT needs one entry per ADC count.");
+
 // Set the high and low raw values for the heaters
 // For thermistors the highest temperature results in the lowest ADC value
 // For thermocouples the highest temperature results in the highest ADC value
@@ -40,6 +40,12 @@
 
 #include "../Marlin.h"
 
+#if HAS_SD_STREAMING
+  #define STOP_STREAM() stopStream()
+#else
+  #define STOP_STREAM() NOOP
+#endif
+
 #if ENABLED(SD_CHECK_AND_RETRY)
   static bool crcSupported = true;
 
@@ -229,6 +235,9 @@ bool Sd2Card::eraseSingleBlockEnable() {
  */
 bool Sd2Card::init(const uint8_t sckRateID/*=0*/, const pin_t chipSelectPin/*=SD_CHIP_SELECT_PIN*/) {
   errorCode_ = type_ = 0;
+  #if HAS_SD_STREAMING
+    streaming_ = STREAM_NONE;
+  #endif
   chipSelectPin_ = chipSelectPin;
   // 16-bit init start time allows over a minute
   const millis_t init_timeout = millis() + SD_INIT_TIMEOUT;
@@ -335,6 +344,7 @@ bool Sd2Card::init(const uint8_t sckRateID/*=0*/, const pin_t chipSelectPin/*=SD
  * \return true for success, false for failure.
  */
 bool Sd2Card::readBlock(uint32_t blockNumber, uint8_t* dst) {
+  STOP_STREAM();
   if (type() != SD_CARD_TYPE_SDHC) blockNumber <<= 9;   // Use address if not SDHC card
 
   #if ENABLED(SD_CHECK_AND_RETRY)
@@ -470,6 +480,7 @@ bool Sd2Card::readData(uint8_t* dst, const uint16_t count) {
 
 /** read CID or CSR register */
 bool Sd2Card::readRegister(const uint8_t cmd, void* buf) {
+  STOP_STREAM();
   uint8_t* dst = reinterpret_cast<uint8_t*>(buf);
   if (cardCommand(cmd, 0)) {
     error(SD_CARD_ERROR_READ_REG);
@@ -511,6 +522,82 @@ bool Sd2Card::readStop() {
   return success;
 }
 
+#if ENABLED(SD_STREAMING_READS)
+
+  /**
+   * Read a 512 byte block as part of a stream. The multiple block read
+   * (CMD18) is left open, so the following block can be read without
+   * sending another command. Reading any other block restarts the stream
+   * there, and any other card access ends it first.
+   *
+   * \param[in] blockNumber Logical block to be read.
+   * \param[out] dst Pointer to the location that will receive the data.
+   * \return true for success, false for failure.
+   */
+  bool Sd2Card::readStream(const uint32_t blockNumber, uint8_t* dst) {
+    if (streaming_ != STREAM_READ || blockNumber != streamBlock_) stopStream();
+    if (!streaming_) {
+      if (!readStart(blockNumber)) return false;
+      streaming_ = STREAM_READ;
+    }
+    if (readData(dst)) {
+      streamBlock_ = blockNumber + 1;
+      return true;
+    }
+    stopStream();                         // End the failed stream and
+    return readBlock(blockNumber, dst);   // fall back to a single block read
+  }
+
+#endif // SD_STREAMING_READS
+
+#if ENABLED(SD_STREAMING_WRITES)
+
+  /**
+   * Write a 512 byte block as part of a stream. The multiple block write
+   * (CMD25) is left open, so the following block can be written without
+   * sending another command. Writing any other block restarts the stream
+   * there, and any other card access ends it first.
+   *
+   * \param[in] blockNumber Logical block to be written.
+   * \param[in] src Pointer to the location of the data to be written.
+   * \param[in] eraseCount The number of blocks to pre-erase (ACMD23) when
+   * a new stream is started.
+   * \return true for success, false for failure.
+   */
+  bool Sd2Card::writeStream(const uint32_t blockNumber, const uint8_t* src, const uint32_t eraseCount) {
+    if (streaming_ != STREAM_WRITE || blockNumber != streamBlock_) stopStream();
+    if (!streaming_) {
+      if (!writeStart(blockNumber, eraseCount)) return writeBlock(blockNumber, src);
+      streaming_ = STREAM_WRITE;
+    }
+    if (writeData(src)) {
+      streamBlock_ = blockNumber + 1;
+      return true;
+    }
+    stopStream();                         // End the failed stream and
+    return writeBlock(blockNumber, src);  // fall back to a single block write
+  }
+
+#endif // SD_STREAMING_WRITES
+
+#if HAS_SD_STREAMING
+
+  /**
+   * End the stream, if one is open
+   */
+  void Sd2Card::stopStream() {
+    const StreamState s = streaming_;
+    streaming_ = STREAM_NONE;
+    #if ENABLED(SD_STREAMING_READS)
+      if (s == STREAM_READ) readStop();
+    #endif
+    #if ENABLED(SD_STREAMING_WRITES)
+      if (s == STREAM_WRITE) writeStop();
+    #endif
+  }
+
+#endif // HAS_SD_STREAMING
+
 /**
  * Set the SPI clock rate.
  *
@@ -548,6 +635,7 @@ bool Sd2Card::waitNotBusy(const millis_t timeout_ms) {
  * \return true for success, false for failure.
  */
 bool Sd2Card::writeBlock(uint32_t blockNumber, const uint8_t* src) {
+  STOP_STREAM();
   if (type() != SD_CARD_TYPE_SDHC) blockNumber <<= 9;   // Use address if not SDHC card
 
   bool success = false;
@@ -620,6 +708,7 @@ bool Sd2Card::writeData(const uint8_t token, const uint8_t* src) {
  * \return true for success, false for failure.
  */
 bool Sd2Card::writeStart(uint32_t blockNumber, const uint32_t eraseCount) {
+  STOP_STREAM();
   bool success = false;
   if (!cardAcmd(ACMD23, eraseCount)) {                    // Send pre-erase count
     if (type() != SD_CARD_TYPE_SDHC) blockNumber <<= 9;   // Use address if not SDHC card
@@ -114,7 +114,11 @@ uint8_t const SD_CARD_TYPE_SD1  = 1,                    // Standard capacity V1
 class Sd2Card {
 public:
 
-  Sd2Card() : errorCode_(SD_CARD_ERROR_INIT_NOT_CALLED), type_(0) {}
+  Sd2Card() : errorCode_(SD_CARD_ERROR_INIT_NOT_CALLED), type_(0)
+    #if HAS_SD_STREAMING
+      , streaming_(STREAM_NONE)
+    #endif
+  {}
 
   uint32_t cardSize();
   bool erase(uint32_t firstBlock, uint32_t lastBlock);
@@ -168,6 +172,17 @@ public:
   bool readData(uint8_t* dst);
   bool readStart(uint32_t blockNumber);
   bool readStop();
+
+  #if ENABLED(SD_STREAMING_READS)
+    bool readStream(const uint32_t blockNumber, uint8_t* dst);
+  #endif
+  #if ENABLED(SD_STREAMING_WRITES)
+    bool writeStream(const uint32_t blockNumber, const uint8_t* src, const uint32_t eraseCount);
+  #endif
+  #if HAS_SD_STREAMING
+    void stopStream();
+  #endif
+
   bool setSckRate(const uint8_t sckRateID);
 
   /**
@@ -187,6 +202,12 @@ private:
           status_,
           type_;
 
+  #if HAS_SD_STREAMING
+    enum StreamState : uint8_t { STREAM_NONE, STREAM_READ, STREAM_WRITE };
+    StreamState streaming_;     // The multiple block read or write left open
+    uint32_t streamBlock_;      // The next block in it
+  #endif
+
   // private functions
   inline uint8_t cardAcmd(const uint8_t cmd, const uint32_t arg) {
     cardCommand(CMD55, 0);
@@ -95,6 +95,9 @@ dir_t* SdBaseFile::cacheDirEntry(uint8_t action) {
 bool SdBaseFile::close() {
   bool rtn = sync();
   type_ = FAT_FILE_TYPE_CLOSED;
+  #if ENABLED(SD_EXTENT_MAP)
+    extents_ = NULL;
+  #endif
   return rtn;
 }
 
@@ -1011,7 +1014,7 @@ int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
         // start of new cluster
         if (curPosition_ == 0)
           curCluster_ = firstCluster_;                      // use first cluster in file
-        else if (!vol_->fatGet(curCluster_, &curCluster_))  // get next cluster from FAT
+        else if (!nextCluster())                            // get next cluster
           return -1;
       }
       block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
@@ -1038,6 +1041,54 @@ int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
   return nbyte;
 }
 
+#if ENABLED(SD_STREAMING_READS)
+
+  /**
+   * Read the next block of a file with a streaming read, which keeps
+   * the card's multiple block read open from one call to the next.
+   * The current position must be on a block boundary.
+   *
+   * \param[out] dst Pointer to a 512 byte buffer for the data.
+   *
+   * \return For success readStream() returns the number of bytes read,
+   * 512 except for the last block of the file. A value of zero is
+   * returned at the end of the file. If an error occurs, readStream()
+   * returns -1.
+   */
+  int16_t SdBaseFile::readStream(uint8_t* dst) {
+    uint32_t block;  // raw device block number
+
+    // error if not open, write only, or not on a block boundary
+    if (!isOpen() || !(flags_ & O_READ) || (curPosition_ & 0x1FF)) return -1;
+
+    const uint16_t n = MIN(fileSize_ - curPosition_, 512UL);
+    if (!n) return 0;
+
+    if (type_ == FAT_FILE_TYPE_ROOT_FIXED)
+      block = vol_->rootDirStart() + (curPosition_ >> 9);
+    else {
+      const uint8_t blockOfCluster = vol_->blockOfCluster(curPosition_);
+      if (blockOfCluster == 0) {
+        // start of new cluster
+        if (curPosition_ == 0)
+          curCluster_ = firstCluster_;                      // use first cluster in file
+        else if (!nextCluster())                            // get next cluster
+          return -1;
+      }
+      block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
+    }
+
+    if (block == vol_->cacheBlockNumber())                  // take the cached copy, which may be newer
+      memcpy(dst, vol_->cache()->data, n);
+    else if (!vol_->sdCard()->readStream(block, dst))
+      return -1;
+
+    curPosition_ += n;
+    return n;
+  }
+
+#endif // SD_STREAMING_READS
+
 /**
  * Read the next entry in a directory.
  *
@@ -1363,9 +1414,80 @@ bool SdBaseFile::rmRfStar() {
 SdBaseFile::SdBaseFile(const char* path, uint8_t oflag) {
   type_ = FAT_FILE_TYPE_CLOSED;
   writeError = false;
+  #if ENABLED(SD_EXTENT_MAP)
+    extents_ = NULL;
+  #endif
   open(path, oflag);
 }
 
+/**
+ * Move curCluster_ on to the cluster holding curPosition_, which is
+ * at the start of the next cluster of the file.
+ *
+ * \return true for success, false for failure.
+ */
+bool SdBaseFile::nextCluster() {
+  #if ENABLED(SD_EXTENT_MAP)
+    if (extents_) {
+      const uint32_t cluster = mapCluster(curPosition_ >> (vol_->clusterSizeShift_ + 9));
+      if (cluster) {
+        curCluster_ = cluster;
+        return true;
+      }
+    }
+  #endif
+  return vol_->fatGet(curCluster_, &curCluster_);
+}
+
+#if ENABLED(SD_EXTENT_MAP)
+
+  /**
+   * Find a cluster of the file in its extent map, following the chain on
+   * from the end of the map if the cluster has not been reached yet.
+   *
+   * \param[in] index The index of the cluster in the file.
+   *
+   * \return The cluster number, or 0 if the map can't give it, in which
+   * case the caller should follow the FAT itself.
+   */
+  uint32_t SdBaseFile::mapCluster(const uint32_t index) {
+    SdExtentMap &map = *extents_;
+    if (!map.count_) {
+      if (firstCluster_ < 2) return 0;
+      map.extent_[0].index = 0;
+      map.extent_[0].cluster = firstCluster_;
+      map.count_ = map.mapped_ = 1;
+    }
+
+    if (index >= map.mapped_) {
+      if (map.full_) return 0;
+      // Last known cluster, at the end of the last run
+      uint32_t cluster = map.extent_[map.count_ - 1].cluster + (map.mapped_ - 1 - map.extent_[map.count_ - 1].index);
+      while (index >= map.mapped_) {
+        uint32_t count, next;
+        if (!vol_->fatRun(cluster, &count, &next)) return 0;
+        map.mapped_ += count;                     // contiguous clusters extend the last run
+        cluster += count;
+        if (count && next == cluster) continue;   // the run goes on in the next FAT block
+        if (index < map.mapped_) break;
+        if (next < 2 || vol_->isEOC(next)) return 0;
+        if (map.count_ >= SD_EXTENT_MAP_SIZE) {
+          map.full_ = true;
+          return 0;
+        }
+        map.extent_[map.count_].index = map.mapped_++;
+        map.extent_[map.count_++].cluster = next;
+        cluster = next;
+      }
+    }
+
+    uint8_t i = map.count_;
+    while (map.extent_[--i].index > index) { /* nada */ }
+    return map.extent_[i].cluster + (index - map.extent_[i].index);
+  }
+
+#endif // SD_EXTENT_MAP
+
 /**
  * Sets a file's position.
  *
@@ -1391,6 +1513,17 @@ bool SdBaseFile::seekSet(const uint32_t pos) {
   nCur = (curPosition_ - 1) >> (vol_->clusterSizeShift_ + 9);
   nNew = (pos - 1) >> (vol_->clusterSizeShift_ + 9);
 
+  #if ENABLED(SD_EXTENT_MAP)
+    if (extents_) {
+      const uint32_t cluster = mapCluster(nNew);
+      if (cluster) {
+        curCluster_ = cluster;
+        curPosition_ = pos;
+        return true;
+      }
+    }
+  #endif
+
   if (nNew < nCur || curPosition_ == 0)
     curCluster_ = firstCluster_;      // must follow chain from first cluster
   else
@@ -1576,8 +1709,8 @@ bool SdBaseFile::truncate(uint32_t length) {
   // error if length is greater than current size
   if (length > fileSize_) return false;
 
-  // fileSize and length are zero - nothing to do
-  if (fileSize_ == 0) return true;
+  // fileSize and length are zero and no clusters are allocated - nothing to do
+  if (fileSize_ == 0 && firstCluster_ == 0) return true;
 
   // remember position for seek after truncation
   newPos = curPosition_ > length ? length : curPosition_;
@@ -1725,4 +1858,97 @@ int16_t SdBaseFile::write(const void* buf, uint16_t nbyte) {
   return -1;
 }
 
+#if ENABLED(SD_STREAMING_WRITES)
+
+  /**
+   * Write the next block of a file with a streaming write, which keeps
+   * the card's multiple block write open from one call to the next.
+   * The current position must be on a block boundary.
+   *
+   * \param[in] src Pointer to the 512 bytes of data to be written.
+   * \param[in] eraseCount The number of blocks the card may pre-erase if
+   * a new multiple block write has to be started, or 0 for the rest of
+   * the current cluster.
+   *
+   * \return true for success, false for failure.
+   */
+  bool SdBaseFile::writeStream(const uint8_t* src, const uint32_t eraseCount) {
+    uint32_t block;  // raw device block number
+
+    // error if not a normal file, read-only, or not on a block boundary
+    if (!isFile() || !(flags_ & O_WRITE) || (curPosition_ & 0x1FF)) goto FAIL;
+
+    // seek to end of file if append flag
+    if ((flags_ & O_APPEND) && curPosition_ != fileSize_) {
+      if (!seekEnd() || (curPosition_ & 0x1FF)) goto FAIL;
+    }
+
+    {
+      const uint8_t blockOfCluster = vol_->blockOfCluster(curPosition_);
+      if (blockOfCluster == 0) {
+        // start of new cluster
+        if (curCluster_ == 0) {
+          if (firstCluster_ == 0) {
+            // allocate first cluster of file
+            if (!addCluster()) goto FAIL;
+          }
+          else
+            curCluster_ = firstCluster_;
+        }
+        else {
+          uint32_t next;
+          if (!vol_->fatGet(curCluster_, &next)) goto FAIL;
+          if (vol_->isEOC(next)) {
+            // add cluster if at end of chain
+            if (!addCluster()) goto FAIL;
+          }
+          else
+            curCluster_ = next;
+        }
+      }
+      block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
+
+      // invalidate cache if block is in cache
+      if (vol_->cacheBlockNumber() == block) vol_->cacheSetBlockNumber(0xFFFFFFFF, false);
+
+      if (!vol_->sdCard()->writeStream(block, src, eraseCount ? eraseCount : vol_->blocksPerCluster() - blockOfCluster))
+        goto FAIL;
+    }
+
+    curPosition_ += 512;
+    if (curPosition_ > fileSize_) {
+      // update fileSize and insure sync will update dir entry
+      fileSize_ = curPosition_;
+      flags_ |= F_FILE_DIR_DIRTY;
+    }
+    return true;
+
+    FAIL:
+    writeError = true;
+    return false;
+  }
+
+  /**
+   * Allocate contiguous clusters for an empty file to be written into,
+   * so writing it needs no cluster allocation and its blocks follow one
+   * another on the card. Use truncate() when done to free any unused.
+   *
+   * \param[in] size The number of bytes the file is expected to hold.
+   *
+   * \return true for success, false for failure.
+   */
+  bool SdBaseFile::preAllocate(const uint32_t size) {
+    // error if not an empty, writable normal file
+    if (!isFile() || !(flags_ & O_WRITE) || firstCluster_ || !size) return false;
+
+    const uint32_t count = ((size - 1) >> (vol_->clusterSizeShift_ + 9)) + 1;
+    if (!vol_->allocContiguous(count, &firstCluster_)) return false;
+
+    // insure sync() will update dir entry
+    flags_ |= F_FILE_DIR_DIRTY;
+    return sync();
+  }
+
+#endif // SD_STREAMING_WRITES
+
 #endif // SDSUPPORT
@@ -159,13 +159,42 @@ uint16_t const FAT_DEFAULT_DATE = ((2000 - 1980) << 9) | (1 << 5) | 1;
 // Default time for file timestamp is 1 am
 uint16_t const FAT_DEFAULT_TIME = (1 << 11);
 
+#if ENABLED(SD_EXTENT_MAP)
+
+  /**
+   * \class SdExtentMap
+   * \brief The runs of contiguous clusters in a file's chain, recorded as the
+   * chain is followed so later seeks can find a cluster without the FAT.
+   */
+  class SdExtentMap {
+   public:
+    SdExtentMap() { clear(); }
+    void clear() { count_ = 0; mapped_ = 0; full_ = false; }
+
+   private:
+    friend class SdBaseFile;
+    struct {
+      uint32_t index;     // index in the file of the first cluster of the run
+      uint32_t cluster;   // first cluster of the run
+    } extent_[SD_EXTENT_MAP_SIZE];
+    uint8_t  count_;      // runs recorded
+    bool     full_;       // a run was left out, so nothing past mapped_ is known
+    uint32_t mapped_;     // clusters of the file covered by the runs
+  };
+
+#endif
+
 /**
  * \class SdBaseFile
  * \brief Base class for SdFile with Print and C++ streams.
  */
 class SdBaseFile {
  public:
-  SdBaseFile() : writeError(false), type_(FAT_FILE_TYPE_CLOSED) {}
+  SdBaseFile() : writeError(false), type_(FAT_FILE_TYPE_CLOSED)
+    #if ENABLED(SD_EXTENT_MAP)
+      , extents_(NULL)
+    #endif
+  {}
   SdBaseFile(const char* path, uint8_t oflag);
   ~SdBaseFile() { if (isOpen()) close(); }
 
@@ -296,11 +325,17 @@ class SdBaseFile {
   bool openNext(SdBaseFile* dirFile, uint8_t oflag);
   bool openRoot(SdVolume* vol);
   int peek();
+  #if ENABLED(SD_STREAMING_WRITES)
+    bool preAllocate(const uint32_t size);
+  #endif
   static void printFatDate(uint16_t fatDate);
   static void printFatTime(uint16_t fatTime);
   bool printName();
   int16_t read();
   int16_t read(void* buf, uint16_t nbyte);
+  #if ENABLED(SD_STREAMING_READS)
+    int16_t readStream(uint8_t* dst);
+  #endif
   int8_t readDir(dir_t* dir, char* longFilename);
   static bool remove(SdBaseFile* dirFile, const char* path);
   bool remove();
@@ -312,6 +347,13 @@ class SdBaseFile {
   bool rename(SdBaseFile* dirFile, const char* newPath);
   bool rmdir();
   bool rmRfStar();
+  #if ENABLED(SD_EXTENT_MAP)
+    /**
+     * Record the file's clusters in \a map as they are found. The map is
+     * only used until the file is closed.
+     */
+    void setExtentMap(SdExtentMap* map) { extents_ = map; if (map) map->clear(); }
+  #endif
 
   /**
    * Set the files position to current position + \a pos. See seekSet().
@@ -345,6 +387,9 @@ class SdBaseFile {
    */
   SdVolume* volume() const { return vol_; }
   int16_t write(const void* buf, uint16_t nbyte);
+  #if ENABLED(SD_STREAMING_WRITES)
+    bool writeStream(const uint8_t* src, const uint32_t eraseCount);
+  #endif
 
  private:
   friend class SdFat;           // allow SdFat to set cwd_
@@ -368,6 +413,9 @@ class SdBaseFile {
   uint32_t  fileSize_;      // file size in bytes
   uint32_t  firstCluster_;  // first cluster of file
   SdVolume* vol_;           // volume where file is located
+  #if ENABLED(SD_EXTENT_MAP)
+    SdExtentMap* extents_;  // cluster runs of an open file, or NULL
+  #endif
 
   /**
    * EXPERIMENTAL - Don't use!
@@ -377,6 +425,10 @@ class SdBaseFile {
   // private functions
   bool addCluster();
   bool addDirCluster();
+  bool nextCluster();
+  #if ENABLED(SD_EXTENT_MAP)
+    uint32_t mapCluster(const uint32_t index);
+  #endif
   dir_t* cacheDirEntry(uint8_t action);
   int8_t lsPrintNext(uint8_t flags, uint8_t indent);
   static bool make83Name(const char* str, uint8_t* name, const char** ptr);
@@ -188,6 +188,47 @@ bool SdVolume::fatGet(uint32_t cluster, uint32_t* value) {
   return true;
 }
 
+#if ENABLED(SD_EXTENT_MAP)
+
+  /**
+   * Follow a cluster chain for as long as it is contiguous, scanning the
+   * entries of one FAT block in place rather than calling fatGet() for each.
+   *
+   * \param[in] cluster The cluster to start from.
+   * \param[out] count The number of clusters that follow it contiguously.
+   * \param[out] next The FAT entry of the last cluster counted (or of
+   * the starting cluster, if none). It equals \a cluster + \a count when
+   * the run goes on into the next FAT block.
+   *
+   * \return true for success, false for failure.
+   */
+  bool SdVolume::fatRun(uint32_t cluster, uint32_t* count, uint32_t* next) {
+    *count = 0;
+    if (fatType_ != 16 && fatType_ != 32) {   // FAT12 entries may span two blocks
+      if (!fatGet(cluster, next)) return false;
+      if (*next == cluster + 1) *count = 1;
+      return true;
+    }
+    if (cluster > (clusterCount_ + 1)) return false;
+
+    const uint8_t shift = fatType_ == 16 ? 8 : 7;
+    const uint32_t lba = fatStartBlock_ + (cluster >> shift);
+    if (lba != cacheBlockNumber_ && !cacheRawBlock(lba, CACHE_FOR_READ))
+      return false;
+
+    const uint8_t last = _BV(shift) - 1;
+    for (uint8_t i = cluster & last;; i++) {
+      *next = (fatType_ == 16) ? cacheBuffer_.fat16[i] : (cacheBuffer_.fat32[i] & FAT32MASK);
+      if (*next != cluster + 1) break;
+      (*count)++;
+      cluster++;
+      if (i == last) break;
+    }
+    return true;
+  }
+
+#endif // SD_EXTENT_MAP
+
 // Store a FAT entry
 bool SdVolume::fatPut(uint32_t cluster, uint32_t value) {
   uint32_t lba;
@@ -185,6 +185,9 @@ class SdVolume {
   void cacheSetDirty() { cacheDirty_ |= CACHE_FOR_WRITE; }
   bool chainSize(uint32_t beginCluster, uint32_t* size);
   bool fatGet(uint32_t cluster, uint32_t* value);
+  #if ENABLED(SD_EXTENT_MAP)
+    bool fatRun(uint32_t cluster, uint32_t* count, uint32_t* next);
+  #endif
   bool fatPut(uint32_t cluster, uint32_t value);
   bool fatPutEOC(uint32_t cluster) { return fatPut(cluster, 0x0FFFFFFF); }
   bool freeChain(uint32_t cluster);
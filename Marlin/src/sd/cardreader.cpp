@@ -109,6 +109,30 @@ char CardReader::proc_filenames[SD_PROCEDURE_DEPTH][MAXPATHNAMELENGTH];
 
 uint32_t CardReader::filesize, CardReader::sdpos;
 
+#if ENABLED(SD_STREAMING_READS)
+  uint8_t CardReader::stream_buffer[2][512];
+  uint16_t CardReader::stream_count[2], CardReader::stream_index;
+  uint8_t CardReader::stream_front;
+  uint32_t CardReader::stream_base;
+#else
+  uint8_t CardReader::read_buffer[SD_READ_BUFFER_SIZE], CardReader::read_count, CardReader::read_index;
+#endif
+
+#if ENABLED(SD_EXTENT_MAP)
+  SdExtentMap CardReader::extent_map;
+#endif
+
+#if ENABLED(SD_STREAMING_WRITES)
+  uint8_t CardReader::write_buffer[512];
+  uint16_t CardReader::write_count;
+  uint32_t CardReader::write_blocks;
+#endif
+
+#if ENABLED(SDCARD_DIR_INDEX)
+  CardReader::dir_index_t CardReader::dir_index[SDCARD_DIR_INDEX_SIZE];
+  bool CardReader::dir_index_valid; // = false
+#endif
+
 LsAction CardReader::lsAction; //stored for recursion.
 uint16_t CardReader::nrFiles; //counter for the files in the current directory and recycled as position counter for getting the nrFiles'th name in the directory.
 char *CardReader::diveDirName;
@@ -158,9 +182,31 @@ char *createFilename(char *buffer, const dir_t &p) {
 
 uint16_t nrFile_index;
 
+#if ENABLED(SDCARD_DIR_INDEX)
+  /**
+   * The first two characters of an item's listed name, folded the
+   * way strcasecmp() folds them, so most sort compares need no names.
+   */
+  static uint16_t dir_index_key(const dir_t &p, const char * const longFilename) {
+    char c0, c1;
+    if (longFilename[0]) {
+      c0 = longFilename[0];
+      c1 = longFilename[1];
+    }
+    else {  // The 8.3 name as createFilename() makes it
+      c0 = p.name[0];
+      c1 = p.name[1] != ' ' ? p.name[1] : p.name[8] != ' ' ? '.' : '\0';
+    }
+    return uint16_t(uint8_t(tolower(c0))) << 8 | uint8_t(tolower(c1));
+  }
+#endif
+
 void CardReader::lsDive(const char *prepend, SdFile parent, const char * const match/*=NULL*/) {
   dir_t p;
   uint8_t cnt = 0;
+  #if ENABLED(SDCARD_DIR_INDEX)
+    uint32_t item_start = parent.curPosition();
+  #endif
 
   // Read the next entry from a directory
   while (parent.readDir(&p, longFilename) > 0) {
@@ -213,6 +259,15 @@ void CardReader::lsDive(const char *prepend, SdFile parent, const char * const m
 
       switch (lsAction) {  // 1 based file count
         case LS_Count:
+          #if ENABLED(SDCARD_DIR_INDEX)
+            if (nrFiles < SDCARD_DIR_INDEX_SIZE) {
+              dir_index_t &item = dir_index[nrFiles];
+              item.entry = item_start / sizeof(dir_t);
+              item.key = dir_index_key(p, longFilename);
+              item.dir = flag.filenameIsDir;
+            }
+            item_start = parent.curPosition();
+          #endif
           nrFiles++;
           break;
 
@@ -361,8 +416,106 @@ void CardReader::initsd() {
 void CardReader::release() {
   stopSDPrint();
   flag.detected = false;
+  flush_dir_index();
+}
+
+/**
+ * Drop any buffered data. The file must be positioned at pos,
+ * which must be on a block boundary when streaming.
+ */
+void CardReader::reset_read(const uint32_t pos) {
+  sdpos = pos;
+  #if ENABLED(SD_STREAMING_READS)
+    stream_count[0] = stream_count[1] = stream_index = 0;
+    stream_base = pos;
+  #else
+    read_count = read_index = 0;
+  #endif
+}
+
+bool CardReader::seek_read(const uint32_t index) {
+  #if ENABLED(SD_STREAMING_READS)
+    const uint32_t pos = index & ~0x1FFUL;
+    if (!file.seekSet(pos)) return false;
+    reset_read(pos);
+    stream_fill(stream_front);
+    consume(index - pos);
+  #else
+    if (!file.seekSet(index)) return false;
+    reset_read(index);
+  #endif
+  return true;
+}
+
+/**
+ * Move the read position to index. If the seek fails (past the end
+ * of the file, or a FAT read error) stay at the current position
+ * and return false.
+ */
+bool CardReader::setIndex(const uint32_t index) {
+  if (seek_read(index)) return true;
+  const uint32_t pos = sdpos;
+  file.seekSet(0);            // A failed seek can leave the cluster invalid
+  seek_read(pos);
+  return false;
+}
+
+/**
+ * Bulk reading. Point to the bytes buffered at the current position,
+ * reading more from the file if none are left, and return their count.
+ * Call consume() with the number of bytes used. Return 0 at the end of
+ * the file or -1 on error.
+ */
+int16_t CardReader::get_span(const char* &span) {
+  #if ENABLED(SD_STREAMING_READS)
+
+    if (stream_index >= stream_count[stream_front]) {
+      // The front buffer is used up. Swap in the block read ahead,
+      // reading it now if that didn't happen yet.
+      const uint8_t back = stream_front ^ 1;
+      if (!stream_count[back]) stream_fill(back);
+      stream_base += stream_count[stream_front];
+      stream_count[stream_front] = 0;
+      stream_front = back;
+      stream_index = 0;
+      if (!stream_count[back]) return eof() ? 0 : -1;
+    }
+    span = (const char*)&stream_buffer[stream_front][stream_index];
+    return stream_count[stream_front] - stream_index;
+
+  #else
+
+    if (read_index >= read_count) {
+      const int16_t n = file.read(read_buffer, SD_READ_BUFFER_SIZE);
+      read_index = 0;
+      read_count = n > 0 ? n : 0;
+      if (n <= 0) return n;
+    }
+    span = (const char*)&read_buffer[read_index];
+    return read_count - read_index;
+
+  #endif
 }
 
+#if ENABLED(SD_STREAMING_READS)
+
+  /**
+   * Read the next block of the file into a buffer
+   */
+  void CardReader::stream_fill(const uint8_t b) {
+    const int16_t n = file.readStream(stream_buffer[b]);
+    stream_count[b] = n > 0 ? n : 0;
+  }
+
+  /**
+   * Read the next block ahead, if not done yet
+   */
+  void CardReader::prefetch() {
+    if (isPrinting() && !stream_count[stream_front ^ 1]) stream_fill(stream_front ^ 1);
+  }
+
+#endif // SD_STREAMING_READS
+
 void CardReader::openAndPrintFile(const char *name) {
   char cmd[4 + strlen(name) + 1]; // Room for "M23 ", filename, and null
   sprintf_P(cmd, PSTR("M23 %s"), name);
@@ -390,6 +543,9 @@ void CardReader::stopSDPrint(
   #endif
   flag.sdprinting = flag.abort_sd_printing = false;
   if (isFileOpen()) file.close();
+  #if HAS_SD_STREAMING
+    sd2card.stopStream();
+  #endif
   #if SD_RESORT
     if (re_sort) presort();
   #endif
@@ -468,8 +624,11 @@ void CardReader::openFile(char * const path, const bool read, const bool subcall
 
   if (read) {
     if (file.open(curDir, fname, O_READ)) {
+      #if ENABLED(SD_EXTENT_MAP)
+        file.setExtentMap(&extent_map);
+      #endif
       filesize = file.fileSize();
-      sdpos = 0;
+      reset_read(0);
       SERIAL_ECHOPAIR(MSG_SD_FILE_OPENED, fname);
       SERIAL_ECHOLNPAIR(MSG_SD_SIZE, filesize);
       SERIAL_ECHOLNPGM(MSG_SD_FILE_SELECTED);
@@ -494,6 +653,11 @@ void CardReader::openFile(char * const path, const bool read, const bool subcall
     }
     else {
       flag.saving = true;
+      flush_dir_index();
+      #if ENABLED(SD_STREAMING_WRITES)
+        write_count = 0;
+        write_blocks = 0;
+      #endif
       getfilename(0, fname);
       #if ENABLED(EMERGENCY_PARSER)
         emergency_parser.disable();
@@ -516,6 +680,7 @@ void CardReader::removeFile(const char * const name) {
   if (file.remove(curDir, fname)) {
     SERIAL_ECHOLNPAIR("File deleted:", fname);
     sdpos = 0;
+    flush_dir_index();
     #if ENABLED(SDCARD_SORT_ALPHA)
       presort();
     #endif
@@ -550,7 +715,11 @@ void CardReader::write_command(char *buf) {
   end[1] = '\r';
   end[2] = '\n';
   end[3] = '\0';
-  file.write(begin);
+  #if ENABLED(SD_STREAMING_WRITES)
+    write(begin, end + 3 - begin);
+  #else
+    file.write(begin);
+  #endif
 
   if (file.writeError) SERIAL_ERROR_MSG(MSG_SD_ERR_WRITE_TO_FILE);
 }
@@ -594,9 +763,64 @@ void CardReader::beginautostart() {
   setroot();
 }
 
+#if ENABLED(SD_STREAMING_WRITES)
+
+  /**
+   * Fill the write buffer and send each full block to the card with a
+   * streaming write, so a file upload is one long multiple block write.
+   */
+  int16_t CardReader::write(void* buf, uint16_t nbyte) {
+    if (!file.isOpen()) return -1;
+    const uint8_t *src = (const uint8_t*)buf;
+    for (uint16_t n = nbyte; n;) {
+      const uint16_t len = MIN(n, 512 - write_count);
+      memcpy(&write_buffer[write_count], src, len);
+      write_count += len;
+      src += len;
+      n -= len;
+      if (write_count == 512) {
+        if (!file.writeStream(write_buffer, write_blocks)) return -1;
+        write_count = 0;
+        if (write_blocks) write_blocks--;
+      }
+    }
+    return nbyte;
+  }
+
+  /**
+   * Take the announced size of the file being written. Its clusters are
+   * allocated up front, in one contiguous run if possible, and the card
+   * is told how many blocks to pre-erase.
+   */
+  void CardReader::preallocate(const uint32_t size) {
+    if (!flag.saving || !file.isOpen()) return;
+    file.preAllocate(size);
+    write_blocks = (size + 511) >> 9;
+  }
+
+  /**
+   * Write out the last partial block, end the multiple block write,
+   * and give back any clusters allocated beyond the end of the file.
+   */
+  void CardReader::flush_write() {
+    if (write_count && file.write(write_buffer, write_count) < 0)
+      SERIAL_ERROR_MSG(MSG_SD_ERR_WRITE_TO_FILE);
+    write_count = 0;
+    sd2card.stopStream();
+    file.truncate(file.fileSize());
+  }
+
+#endif // SD_STREAMING_WRITES
+
 void CardReader::closefile(const bool store_location) {
+  #if ENABLED(SD_STREAMING_WRITES)
+    if (flag.saving) flush_write();
+  #endif
   file.sync();
   file.close();
+  #if HAS_SD_STREAMING
+    sd2card.stopStream();
+  #endif
   flag.saving = flag.logging = false;
   sdpos = 0;
   #if ENABLED(EMERGENCY_PARSER)
@@ -630,7 +854,16 @@ void CardReader::getfilename(uint16_t nr, const char * const match/*=NULL*/) {
   #endif // SDSORT_CACHE_NAMES
   lsAction = LS_GetFilename;
   nrFile_index = nr;
-  workDir.rewind();
+  #if ENABLED(SDCARD_DIR_INDEX)
+    // Start from the indexed item, or the last one indexed
+    if (dir_index_valid && !match && nrFiles) {
+      const uint16_t i = MIN(nr, MIN(nrFiles, uint16_t(SDCARD_DIR_INDEX_SIZE)) - 1);
+      nrFile_index -= i;
+      workDir.seekSet(uint32_t(dir_index[i].entry) * sizeof(dir_t));
+    }
+    else
+  #endif
+      workDir.rewind();
   lsDive(NULL, workDir, match);
 }
 
@@ -639,6 +872,9 @@ uint16_t CardReader::getnrfilenames() {
   nrFiles = 0;
   workDir.rewind();
   lsDive(NULL, workDir);
+  #if ENABLED(SDCARD_DIR_INDEX)
+    dir_index_valid = true;
+  #endif
   //SERIAL_ECHOLN(nrFiles);
   return nrFiles;
 }
@@ -686,6 +922,7 @@ void CardReader::chdir(const char * relpath) {
 
   if (newDir.open(parent, relpath, O_READ)) {
     workDir = newDir;
+    flush_dir_index();
     if (workDirDepth < MAX_DIR_DEPTH)
       workDirParents[workDirDepth++] = workDir;
     #if ENABLED(SDCARD_SORT_ALPHA)
@@ -701,6 +938,7 @@ void CardReader::chdir(const char * relpath) {
 int8_t CardReader::updir() {
   if (workDirDepth > 0) {                                               // At least 1 dir has been saved
     workDir = --workDirDepth ? workDirParents[workDirDepth - 1] : root; // Use parent, or root if none
+    flush_dir_index();
     #if ENABLED(SDCARD_SORT_ALPHA)
       presort();
     #endif
@@ -713,6 +951,7 @@ void CardReader::setroot() {
     SERIAL_ECHOLNPGM(MSG_SD_WORKDIR_FAIL);
   }*/
   workDir = root;
+  flush_dir_index();
   #if ENABLED(SDCARD_SORT_ALPHA)
     presort();
   #endif
@@ -852,6 +1091,8 @@ void CardReader::setroot() {
             // Compare names from the array or just the two buffered names
             #if ENABLED(SDSORT_USES_RAM)
               #define _SORT_CMP_NODIR() (strcasecmp(sortnames[o1], sortnames[o2]) > 0)
+            #elif ENABLED(SDCARD_DIR_INDEX)
+              #define _SORT_CMP_NODIR() (keyed ? dir_index[o1].key > dir_index[o2].key : strcasecmp(name1, name2) > 0)
             #else
               #define _SORT_CMP_NODIR() (strcasecmp(name1, name2) > 0)
             #endif
@@ -873,13 +1114,38 @@ void CardReader::setroot() {
             // The most economical method reads names as-needed
             // throughout the loop. Slow if there are many.
             #if DISABLED(SDSORT_USES_RAM)
-              getfilename(o1);
-              strcpy(name1, longest_filename()); // save (or getfilename below will trounce it)
-              #if HAS_FOLDER_SORTING
-                bool dir1 = flag.filenameIsDir;
+              #if ENABLED(SDCARD_DIR_INDEX)
+                // Items whose keys differ are ordered without reading their names
+                const bool keyed = o1 < SDCARD_DIR_INDEX_SIZE && o2 < SDCARD_DIR_INDEX_SIZE
+                                && dir_index[o1].key != dir_index[o2].key;
+                char *name2 = name1;
+                #if HAS_FOLDER_SORTING
+                  bool dir1;
+                #endif
+                if (keyed) {
+                  #if HAS_FOLDER_SORTING
+                    dir1 = dir_index[o1].dir;
+                    flag.filenameIsDir = dir_index[o2].dir;
+                  #endif
+                }
+                else {
+                  getfilename(o1);
+                  strcpy(name1, longest_filename());
+                  #if HAS_FOLDER_SORTING
+                    dir1 = flag.filenameIsDir;
+                  #endif
+                  getfilename(o2);
+                  name2 = longest_filename();
+                }
+              #else
+                getfilename(o1);
+                strcpy(name1, longest_filename()); // save (or getfilename below will trounce it)
+                #if HAS_FOLDER_SORTING
+                  bool dir1 = flag.filenameIsDir;
+                #endif
+                getfilename(o2);
+                char *name2 = longest_filename(); // use the string in-place
               #endif
-              getfilename(o2);
-              char *name2 = longest_filename(); // use the string in-place
             #endif // !SDSORT_USES_RAM
 
             // Sort the current pair according to settings.
@@ -955,6 +1221,8 @@ uint16_t CardReader::get_num_Files() {
   return
     #if ENABLED(SDCARD_SORT_ALPHA) && SDSORT_USES_RAM && SDSORT_CACHE_NAMES
       nrFiles // no need to access the SD card for filenames
+    #elif ENABLED(SDCARD_DIR_INDEX)
+      dir_index_valid ? nrFiles : getnrfilenames() // counted since the last change
     #else
       getnrfilenames()
     #endif
@@ -967,8 +1235,10 @@ void CardReader::printingHasFinished() {
   if (file_subcall_ctr > 0) { // Heading up to a parent file that called current as a procedure.
     file_subcall_ctr--;
     openFile(proc_filenames[file_subcall_ctr], true, true);
-    setIndex(filespos[file_subcall_ctr]);
-    startFileprint();
+    if (setIndex(filespos[file_subcall_ctr]))
+      startFileprint();
+    else
+      SERIAL_ERROR_MSG(MSG_SD_ERR_SEEK);
   }
   else {
     stopSDPrint();
@@ -1022,6 +1292,7 @@ void CardReader::printingHasFinished() {
   constexpr char job_recovery_file_name[4] = "BIN";
 
   bool CardReader::jobRecoverFileExists() {
+    if (recovery.file.isOpen()) return true; // Held open by the journal
     const bool exists = recovery.file.open(&root, job_recovery_file_name, O_READ);
     if (exists) recovery.file.close();
     return exists;
@@ -1035,14 +1306,19 @@ void CardReader::printingHasFinished() {
       SERIAL_CHAR('.');
       SERIAL_EOL();
     }
-    else if (!read)
+    else if (!read) {
+      flush_dir_index();
       SERIAL_ECHOLNPAIR(MSG_SD_WRITE_TO_FILE, job_recovery_file_name);
+    }
   }
 
   // Removing the job recovery file currently requires closing
   // the file being printed, so during SD printing the file should
   // be zeroed and written instead of deleted.
   void CardReader::removeJobRecoveryFile() {
+    #if ENABLED(POWER_LOSS_JOURNAL)
+      recovery.close(); // The next save starts a new file with a checkpoint
+    #endif
     if (jobRecoverFileExists()) {
       //closefile();
       removeFile(job_recovery_file_name);
@@ -116,13 +116,30 @@ public:
   static inline bool isPaused() { return isFileOpen() && !flag.sdprinting; }
   static inline bool isPrinting() { return flag.sdprinting; }
   static inline bool eof() { return sdpos >= filesize; }
-  static inline int16_t get() { sdpos = file.curPosition(); return (int16_t)file.read(); }
-  static inline void setIndex(const uint32_t index) { sdpos = index; file.seekSet(index); }
+  static bool setIndex(const uint32_t index);
+  static int16_t get_span(const char* &span);
+  static inline void consume(const uint16_t n) {
+    #if ENABLED(SD_STREAMING_READS)
+      stream_index += n;
+      sdpos = stream_base + stream_index;
+    #else
+      read_index += n;
+      sdpos += n;
+    #endif
+  }
+  #if ENABLED(SD_STREAMING_READS)
+    static void prefetch();
+  #endif
   static inline uint32_t getIndex() { return sdpos; }
   static inline uint8_t percentDone() { return (isFileOpen() && filesize) ? sdpos / ((filesize + 99) / 100) : 0; }
   static inline char* getWorkDirName() { workDir.getFilename(filename); return filename; }
   static inline int16_t read(void* buf, uint16_t nbyte) { return file.isOpen() ? file.read(buf, nbyte) : -1; }
-  static inline int16_t write(void* buf, uint16_t nbyte) { return file.isOpen() ? file.write(buf, nbyte) : -1; }
+  #if ENABLED(SD_STREAMING_WRITES)
+    static int16_t write(void* buf, uint16_t nbyte);
+    static void preallocate(const uint32_t size);
+  #else
+    static inline int16_t write(void* buf, uint16_t nbyte) { return file.isOpen() ? file.write(buf, nbyte) : -1; }
+  #endif
 
   static Sd2Card& getSd2Card() { return sd2card; }
 
@@ -207,6 +224,20 @@ private:
 
   #endif // SDCARD_SORT_ALPHA
 
+  // Index of the listed items in the current directory
+  #if ENABLED(SDCARD_DIR_INDEX)
+    typedef struct {
+      uint16_t entry;               // Directory entry where the search for the item can start
+      uint16_t key;                 // First two characters of the name, case-folded, for sorting
+      bool dir;                     // The item is a folder
+    } dir_index_t;
+    static dir_index_t dir_index[SDCARD_DIR_INDEX_SIZE];
+    static bool dir_index_valid;    // Set by a count of the directory, cleared by a change to it
+    static inline void flush_dir_index() { dir_index_valid = false; }
+  #else
+    static inline void flush_dir_index() {}
+  #endif
+
   static Sd2Card sd2card;
   static SdVolume volume;
   static SdFile file;
@@ -221,6 +252,32 @@ private:
 
   static uint32_t filesize, sdpos;
 
+  #if ENABLED(SD_STREAMING_READS)
+    static uint8_t stream_buffer[2][512];   // The block being parsed and the one after it
+    static uint16_t stream_count[2],        // Bytes held by each buffer, 0 when empty
+                    stream_index;           // Next byte in the front buffer
+    static uint8_t stream_front;            // The buffer being parsed
+    static uint32_t stream_base;            // File position of the front buffer
+    static void stream_fill(const uint8_t b);
+  #else
+    static uint8_t read_buffer[SD_READ_BUFFER_SIZE],
+                   read_count,                // Bytes in the read buffer
+                   read_index;                // Next byte in the read buffer
+  #endif
+  static void reset_read(const uint32_t pos);
+  static bool seek_read(const uint32_t index);
+
+  #if ENABLED(SD_EXTENT_MAP)
+    static SdExtentMap extent_map;          // Cluster runs of the file being printed
+  #endif
+
+  #if ENABLED(SD_STREAMING_WRITES)
+    static uint8_t write_buffer[512];       // The block being filled
+    static uint16_t write_count;            // Bytes in the write buffer
+    static uint32_t write_blocks;           // Blocks still expected, for pre-erase
+    static void flush_write();
+  #endif
+
   static LsAction lsAction; //stored for recursion.
   static uint16_t nrFiles; //counter for the files in the current directory and recycled as position counter for getting the nrFiles'th name in the directory.
   static char *diveDirName;
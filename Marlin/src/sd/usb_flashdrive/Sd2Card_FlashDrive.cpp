@@ -27,20 +27,23 @@
 #include "../../Marlin.h"
 #include "../../core/serial.h"
 
-#include "lib/Usb.h"
-#include "lib/masstorage.h"
-
+#include "flashdrive_device.h"
 #include "Sd2Card_FlashDrive.h"
 
 #if ENABLED(ULTRA_LCD) || ENABLED(EXTENSIBLE_UI)
   #include "../../lcd/ultralcd.h"
 #endif
 
-USB usb;
-BulkOnly bulk(&usb);
-
 Sd2Card::state_t Sd2Card::state;
 
+#if USB_BULK_BLOCKS > 1
+  Sd2Card::buffer_state_t Sd2Card::bufferState; // = BUFFER_EMPTY
+  uint8_t Sd2Card::buffer[USB_BULK_BLOCKS][512],
+          Sd2Card::bufferCount;
+  uint32_t Sd2Card::bufferBlock,
+           Sd2Card::nextBlock;
+#endif
+
 // The USB library needs to be called periodically to detect USB thumbdrive
 // insertion and removals. Call this idle() function periodically to allow
 // the USB library to monitor for such events. This function also takes care
@@ -62,7 +65,7 @@ void Sd2Card::idle() {
       break;
     case USB_HOST_UNINITIALIZED:
       SERIAL_ECHOPGM("Starting USB host...");
-      if (!usb.start()) {
+      if (!FlashDriveDevice::start()) {
         SERIAL_ECHOPGM(" Failed. Retrying in 2s.");
         #if ENABLED(ULTRA_LCD) || ENABLED(EXTENSIBLE_UI)
           LCD_MESSAGEPGM("USB start failed");
@@ -74,18 +77,21 @@ void Sd2Card::idle() {
       SERIAL_EOL();
       break;
     case USB_HOST_INITIALIZED:
-      const uint8_t lastUsbTaskState = usb.getUsbTaskState();
-      usb.Task();
-      const uint8_t newUsbTaskState  = usb.getUsbTaskState();
+      const bool wasInserted = FlashDriveDevice::isInserted();
+      FlashDriveDevice::task();
+      const bool nowInserted = FlashDriveDevice::isInserted();
 
-      if (lastUsbTaskState == USB_STATE_RUNNING && newUsbTaskState != USB_STATE_RUNNING) {
+      if (wasInserted && !nowInserted) {
         // the user pulled the flash drive. Make sure the bulk storage driver releases the address
+        #if USB_BULK_BLOCKS > 1
+          bufferState = BUFFER_EMPTY;
+        #endif
         #ifdef USB_DEBUG
           SERIAL_ECHOLNPGM("USB drive removed");
         #endif
         //bulk.Release();
       }
-      if (lastUsbTaskState != USB_STATE_RUNNING && newUsbTaskState == USB_STATE_RUNNING) {
+      if (!wasInserted && nowInserted) {
         #ifdef USB_DEBUG
           SERIAL_ECHOLNPGM("USB drive inserted");
         #endif
@@ -97,26 +103,22 @@ void Sd2Card::idle() {
 // Marlin calls this function to check whether an USB drive is inserted.
 // This is equivalent to polling the SD_DETECT when using SD cards.
 bool Sd2Card::isInserted() {
-  return usb.getUsbTaskState() == USB_STATE_RUNNING;
+  return FlashDriveDevice::isInserted();
 }
 
 // Marlin calls this to initialize an SD card once it is inserted.
 bool Sd2Card::init(const uint8_t sckRateID/*=0*/, const pin_t chipSelectPin/*=SD_CHIP_SELECT_PIN*/) {
   if (!ready()) return false;
 
-  if (!bulk.LUNIsGood(0)) {
-    SERIAL_ECHOLNPGM("LUN zero is not good");
-    return false;
-  }
-
-  const uint32_t sectorSize = bulk.GetSectorSize(0);
-  if (sectorSize != 512) {
-    SERIAL_ECHOLNPAIR("Expecting sector size of 512. Got: ", sectorSize);
-    return false;
-  }
+  if (FlashDriveDevice::mount()) return false;
 
+  #if USB_BULK_BLOCKS > 1 || defined(USB_DEBUG)
+    lun0_capacity = FlashDriveDevice::capacity();
+  #endif
+  #if USB_BULK_BLOCKS > 1
+    bufferState = BUFFER_EMPTY;
+  #endif
   #ifdef USB_DEBUG
-    lun0_capacity = bulk.GetCapacity(0);
     SERIAL_ECHOLNPAIR("LUN Capacity (in blocks): ", lun0_capacity);
   #endif
   return true;
@@ -125,13 +127,24 @@ bool Sd2Card::init(const uint8_t sckRateID/*=0*/, const pin_t chipSelectPin/*=SD
 // Returns the capacity of the card in blocks.
 uint32_t Sd2Card::cardSize() {
   if (!ready()) return 0;
-  #ifndef USB_DEBUG
+  #if USB_BULK_BLOCKS <= 1 && !defined(USB_DEBUG)
     const uint32_t
   #endif
-      lun0_capacity = bulk.GetCapacity(0);
+      lun0_capacity = FlashDriveDevice::capacity();
   return lun0_capacity;
 }
 
+#if USB_BULK_BLOCKS > 1
+
+  // Send the streamed blocks, if any, and empty the buffer.
+  bool Sd2Card::flushBuffer() {
+    const bool ok = bufferState != BUFFER_WRITE || !FlashDriveDevice::write(bufferBlock, bufferCount, buffer[0]);
+    bufferState = BUFFER_EMPTY;
+    return ok;
+  }
+
+#endif
+
 bool Sd2Card::readBlock(uint32_t block, uint8_t* dst) {
   if (!ready()) return false;
   #ifdef USB_DEBUG
@@ -143,7 +156,30 @@ bool Sd2Card::readBlock(uint32_t block, uint8_t* dst) {
       SERIAL_ECHOLNPAIR("Read block ", block);
     #endif
   #endif
-  const bool ok = (bulk.Read(0, block, 512, 1, dst) == 0);
+  #if USB_BULK_BLOCKS > 1
+    // A read following on from the last one fetches the blocks after it too
+    const bool sequential = block == nextBlock;
+    nextBlock = block + 1;
+
+    // Serve the block from the read-ahead buffer
+    if (bufferState == BUFFER_READ && block - bufferBlock < bufferCount) {
+      memcpy(dst, buffer[block - bufferBlock], 512);
+      return true;
+    }
+    if (!flushBuffer()) return false;
+
+    if (sequential && block < lun0_capacity) {
+      const uint8_t count = MIN(lun0_capacity - block, uint32_t(USB_BULK_BLOCKS));
+      if (!FlashDriveDevice::read(block, count, buffer[0])) {
+        bufferState = BUFFER_READ;
+        bufferBlock = block;
+        bufferCount = count;
+        memcpy(dst, buffer[0], 512);
+        return true;
+      }
+    }
+  #endif
+  const bool ok = !FlashDriveDevice::read(block, 1, dst);
   #if defined(LULZBOT_USB_READ_ERROR_IS_FATAL)
   if(!ok) kill(PSTR("USB Read Error"));
   #endif
@@ -161,7 +197,36 @@ bool Sd2Card::writeBlock(uint32_t block, const uint8_t* src) {
       SERIAL_ECHOLNPAIR("Write block ", block);
     #endif
   #endif
-  return bulk.Write(0, block, 512, 1, src) == 0;
+  #if USB_BULK_BLOCKS > 1
+    // Send streamed blocks first and drop blocks read ahead that may be stale
+    if (!flushBuffer()) return false;
+  #endif
+  return !FlashDriveDevice::write(block, 1, src);
 }
 
+#if ENABLED(SD_STREAMING_WRITES)
+
+  /**
+   * Gather a block written as part of a stream. Contiguous blocks are sent
+   * together once the buffer fills, or by stopStream() or any other access.
+   */
+  bool Sd2Card::writeStream(const uint32_t block, const uint8_t* src, const uint32_t eraseCount) {
+    UNUSED(eraseCount);
+    #if USB_BULK_BLOCKS > 1
+      if (!ready()) return false;
+      if (bufferState != BUFFER_WRITE || block != bufferBlock + bufferCount) {
+        if (!flushBuffer()) return false;
+        bufferState = BUFFER_WRITE;
+        bufferBlock = block;
+        bufferCount = 0;
+      }
+      memcpy(buffer[bufferCount++], src, 512);
+      return bufferCount < USB_BULK_BLOCKS || flushBuffer();
+    #else
+      return writeBlock(block, src);
+    #endif
+  }
+
+#endif // SD_STREAMING_WRITES
+
 #endif // USB_FLASH_DRIVE_SUPPORT
@@ -70,10 +70,26 @@ class Sd2Card {
     static state_t state;
 
     uint32_t pos;
-    #ifdef USB_DEBUG
+    #if USB_BULK_BLOCKS > 1 || defined(USB_DEBUG)
       uint32_t lun0_capacity;
     #endif
 
+    #if USB_BULK_BLOCKS > 1
+      typedef enum : uint8_t {
+        BUFFER_EMPTY,
+        BUFFER_READ,    // Blocks read ahead
+        BUFFER_WRITE    // Streamed blocks not yet sent
+      } buffer_state_t;
+
+      static buffer_state_t bufferState;
+      static uint8_t buffer[USB_BULK_BLOCKS][512],
+                     bufferCount;         // Blocks in the buffer
+      static uint32_t bufferBlock,        // The first block in the buffer
+                      nextBlock;          // The block following the last read
+
+      static bool flushBuffer();
+    #endif
+
     static inline bool ready() { return state == USB_HOST_INITIALIZED; }
 
   public:
@@ -92,6 +108,20 @@ class Sd2Card {
     bool readBlock(uint32_t block, uint8_t* dst);
     bool writeBlock(uint32_t blockNumber, const uint8_t* src);
 
+    #if ENABLED(SD_STREAMING_READS)
+      inline bool readStream(const uint32_t block, uint8_t* dst)            { return readBlock(block, dst); }
+    #endif
+    #if ENABLED(SD_STREAMING_WRITES)
+      bool writeStream(const uint32_t block, const uint8_t* src, const uint32_t eraseCount);
+    #endif
+    #if HAS_SD_STREAMING
+      static inline void stopStream() {
+        #if USB_BULK_BLOCKS > 1
+          flushBuffer();
+        #endif
+      }
+    #endif
+
     uint32_t cardSize();
     static bool isInserted();
 };
@@ -0,0 +1,47 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Block device under the USB flash drive's Sd2Card.
+ *
+ * Sd2Card_FlashDrive does the read-ahead and write gathering, and passes
+ * runs of contiguous 512-byte blocks to this device. The USB host library
+ * provides it on the printer. The Linux HAL backs it with a disk image for
+ * testing. mount(), read() and write() return true on error, like
+ * write_data().
+ */
+
+#include <stdint.h>
+
+class FlashDriveDevice {
+public:
+  static bool start();        // Start the host. Return false to retry later.
+  static void task();         // Poll for the drive coming and going
+  static bool isInserted();   // A drive is present and running
+
+  static bool mount();        // Check the drive can be used as a 512-byte block device
+  static uint32_t capacity(); // Drive size in blocks
+
+  static bool read(const uint32_t block, const uint8_t count, uint8_t *dst);
+  static bool write(const uint32_t block, const uint8_t count, const uint8_t *src);
+};
@@ -0,0 +1,73 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2019 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * USB flash drive through the MAX3421E USB host and the bulk-only
+ * mass storage driver. Every transfer goes to the drive's first LUN.
+ */
+
+#include "../../inc/MarlinConfigPre.h"
+
+#if ENABLED(USB_HOST_SUPPORT)
+
+#include "../../core/serial.h"
+
+#include "lib/Usb.h"
+#include "lib/masstorage.h"
+
+#include "flashdrive_device.h"
+
+USB usb;
+BulkOnly bulk(&usb);
+
+bool FlashDriveDevice::start() { return usb.start(); }
+
+void FlashDriveDevice::task() { usb.Task(); }
+
+bool FlashDriveDevice::isInserted() { return usb.getUsbTaskState() == USB_STATE_RUNNING; }
+
+bool FlashDriveDevice::mount() {
+  if (!bulk.LUNIsGood(0)) {
+    SERIAL_ECHOLNPGM("LUN zero is not good");
+    return true;
+  }
+
+  const uint32_t sectorSize = bulk.GetSectorSize(0);
+  if (sectorSize != 512) {
+    SERIAL_ECHOLNPAIR("Expecting sector size of 512. Got: ", sectorSize);
+    return true;
+  }
+
+  return false;
+}
+
+uint32_t FlashDriveDevice::capacity() { return bulk.GetCapacity(0); }
+
+bool FlashDriveDevice::read(const uint32_t block, const uint8_t count, uint8_t *dst) {
+  return bulk.Read(0, block, 512, count, dst) != 0;
+}
+
+bool FlashDriveDevice::write(const uint32_t block, const uint8_t count, const uint8_t *src) {
+  return bulk.Write(0, block, 512, count, src) != 0;
+}
+
+#endif // USB_HOST_SUPPORT
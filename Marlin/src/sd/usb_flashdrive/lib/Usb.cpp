@@ -26,7 +26,7 @@
 
 #include "../../../inc/MarlinConfigPre.h"
 
-#if ENABLED(USB_FLASH_DRIVE_SUPPORT)
+#if ENABLED(USB_HOST_SUPPORT)
 
 #include "Usb.h"
 
@@ -795,4 +795,4 @@ uint8_t USB::setConf(uint8_t addr, uint8_t ep, uint8_t conf_value) {
 }
 
 #endif // defined(USB_METHODS_INLINE)
-#endif // USB_FLASH_DRIVE_SUPPORT
+#endif // USB_HOST_SUPPORT
@@ -25,7 +25,7 @@
 
 #include "../../../inc/MarlinConfigPre.h"
 
-#if ENABLED(USB_FLASH_DRIVE_SUPPORT)
+#if ENABLED(USB_HOST_SUPPORT)
 
 #include "masstorage.h"
 
@@ -1216,4 +1216,4 @@ uint8_t BulkOnly::Read(uint8_t lun __attribute__((unused)), uint32_t addr __attr
   #endif
 }
 
-#endif // USB_FLASH_DRIVE_SUPPORT
+#endif // USB_HOST_SUPPORT
@@ -25,7 +25,7 @@
 
 #include "../../../inc/MarlinConfigPre.h"
 
-#if ENABLED(USB_FLASH_DRIVE_SUPPORT)
+#if ENABLED(USB_HOST_SUPPORT)
 
 #include "Usb.h"
 
@@ -125,4 +125,4 @@ void E_Notify(double d, int lvl) {
 
 #endif // DEBUG_USB_HOST
 
-#endif // USB_FLASH_DRIVE_SUPPORT
+#endif // USB_HOST_SUPPORT
@@ -25,7 +25,7 @@
 
 #include "../../../inc/MarlinConfigPre.h"
 
-#if ENABLED(USB_FLASH_DRIVE_SUPPORT)
+#if ENABLED(USB_HOST_SUPPORT)
 
 #include "Usb.h"
 
@@ -74,4 +74,4 @@ bool PTPListParser::Parse(uint8_t **pp, uint16_t *pcntdn, PTP_ARRAY_EL_FUNC pf,
   return true;
 }
 
-#endif // USB_FLASH_DRIVE_SUPPORT
+#endif // USB_HOST_SUPPORT
@@ -25,7 +25,7 @@
 
 #include "../../inc/MarlinConfigPre.h"
 
-#if ENABLED(USB_FLASH_DRIVE_SUPPORT)
+#if ENABLED(USB_HOST_SUPPORT)
 
 #include "lib/Usb.h"
 #include "usb_host.h"
@@ -210,4 +210,4 @@ uint8_t MAX3421e::IntHandler() {
   return HIRQ_sendback;
 }
 
-#endif // USB_FLASH_DRIVE_SUPPORT
+#endif // USB_HOST_SUPPORT